@@ -0,0 +1,107 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_commons.h"
+#include "common/batch.hpp"
+#include "common/graph_input.hpp"
+#include "lagraph/boruvka_lagraph.hpp"
+#include "lagraph/connected_components_lagraph.hpp"
+#include "lagraph/lagraph_init.hpp"
+#include "native/boruvka_native.hpp"
+#include "native/fast_sv_native.hpp"
+#include "native/parent_bfs_native.hpp"
+
+#ifndef DATA_DIR
+#define DATA_DIR "data"
+#endif
+
+using namespace std;
+using namespace algos;
+using namespace bench;
+
+template<typename Algo>
+function<BatchStats(unsigned)> batch_runner(const vector<filesystem::path> &batch) {
+    return [&batch](unsigned workers) {
+        return run_batch<Algo>(batch, [] { return make_unique<Algo>(); }, [](size_t, Algo &) {}, workers);
+    };
+}
+
+// Throughput of many small graphs: every graph of the directory is repeated to form one batch, which is
+// processed by 1, 2, 4, ... workers with single-threaded kernels. The SPLA algorithms share one library
+// context and are left out.
+// Usage: batch_benchmark [--repeat N] [directory]
+int main(int argc, char **argv) {
+    cout << "Batch Throughput Benchmark" << endl;
+
+    size_t repeat = 100;
+    filesystem::path directory = DATA_DIR;
+    for (int i = 1; i < argc; ++i) {
+        const string arg = argv[i];
+        if (arg == "--repeat" && i + 1 < argc) {
+            repeat = stoull(argv[++i]);
+        } else {
+            directory = arg;
+        }
+    }
+
+    vector<filesystem::path> graph_files;
+    for (const auto &entry: filesystem::directory_iterator(directory)) {
+        if (is_graph_file(entry.path())) {
+            graph_files.push_back(entry.path());
+        }
+    }
+    if (graph_files.empty()) {
+        cout << "No .mtx files found in " << directory.string() << endl;
+        return 1;
+    }
+
+    vector<filesystem::path> batch;
+    for (size_t r = 0; r < repeat; ++r) {
+        batch.insert(batch.end(), graph_files.begin(), graph_files.end());
+    }
+    cout << "Batch of " << batch.size() << " graphs (" << graph_files.size() << " files x " << repeat << ")" << endl;
+
+    // Parallelism comes from the workers, GraphBLAS runs every call on the calling thread
+    init_lagraph();
+    const ThreadCountGuard guard(1);
+
+    // Double weights hold every weight type, so one instance serves all graphs of the batch
+    vector<pair<string, function<BatchStats(unsigned)>>> algorithms;
+    algorithms.emplace_back("BoruvkaNative", batch_runner<BoruvkaNative<double>>(batch));
+    algorithms.emplace_back("BoruvkaLagraph", batch_runner<BoruvkaLagraph<double>>(batch));
+    algorithms.emplace_back("ParentBfsNative", batch_runner<ParentBfsNative>(batch));
+    algorithms.emplace_back("FastSvNative", batch_runner<FastSvNative>(batch));
+    algorithms.emplace_back("CcLagraph", batch_runner<ConnectedComponentsLagraph>(batch));
+
+    vector<unsigned> worker_counts;
+    for (unsigned w = 1; w < available_cpus(); w *= 2) {
+        worker_counts.push_back(w);
+    }
+    worker_counts.push_back(available_cpus());
+
+    const string output_file = "batch_results.csv";
+    ofstream csv(output_file);
+    csv << "Algorithm,Workers,Graphs,Failed,Seconds,ComputeSeconds,GraphsPerSecond,Speedup" << endl;
+    for (const auto &[algo_name, run]: algorithms) {
+        double single = 0;
+        for (const unsigned workers: worker_counts) {
+            const BatchStats stats = run(workers);
+            if (workers == 1) single = stats.graphs_per_second();
+            const double speedup = single > 0 ? stats.graphs_per_second() / single : 0;
+            cout << "  " << algo_name << " x" << workers << ": " << fixed << setprecision(1) << stats.graphs_per_second()
+                 << " graphs/s, speedup " << setprecision(2) << speedup << endl;
+            if (stats.failed > 0) {
+                cerr << "  " << stats.failed << " graphs failed, first: " << stats.first_error << endl;
+            }
+            csv << algo_name << "," << workers << "," << stats.graphs << "," << stats.failed << "," << stats.seconds << ","
+                << stats.compute_seconds << "," << stats.graphs_per_second() << "," << speedup << endl;
+        }
+    }
+    cout << "Results saved to " << output_file << endl;
+    save_trace();
+
+    return 0;
+}
@@ -1,10 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "autotune/auto_algorithm.hpp"
 #include "common/algorithm.hpp"
+#include "common/csr_graph.hpp"
+#include "common/graph_prefetcher.hpp"
+#include "common/run_isolation.hpp"
+#include "common/scheduler.hpp"
+#include "common/trace.hpp"
+#include "common/weight_type.hpp"
 
 using namespace algos;
 using namespace std;
@@ -18,10 +29,120 @@ namespace bench {
         string algorithm_name;
         string graph_name;
         vector<double> execution_times;// in seconds
+        // work-stealing totals of every measured run, loops is 0 for algorithms not using the scheduler
+        vector<SchedulerStats> scheduler;
     };
 
-    template<typename AlgoType>
-    BenchmarkResult run_benchmark(const string &algo_name, const string &graph_path, int warm_up_runs, int num_runs) {
+    using AlgorithmFactory = function<unique_ptr<Algorithm>()>;
+
+    // ALGOS_ISOLATE and friends, see common/run_isolation.hpp
+    inline const IsolationConfig isolation = IsolationConfig::from_env();
+
+    // Prefetcher of the running sweep, held paused while an algorithm is measured
+    inline GraphPrefetcher *prefetcher = nullptr;
+
+    struct MeasureGuard {
+        MeasureGuard() {
+            if (prefetcher) prefetcher->pause();
+        }
+
+        ~MeasureGuard() {
+            if (prefetcher) prefetcher->resume();
+        }
+    };
+
+    inline chrono::milliseconds measure(Algorithm &algorithm) {
+        MeasureGuard guard;
+        return algorithm.compute();
+    }
+
+    // Time and scheduler totals of a run, returned by the isolated child
+    struct RunSample {
+        double milliseconds;
+        SchedulerStats scheduler;
+    };
+
+    // Loads the graph into a new instance and measures it, in a child of its own when the runs are isolated.
+    // The prefetcher is then paused by the parent for the whole child, its thread does not exist in there
+    inline RunSample run_once(const string &graph_path, const AlgorithmFactory &create) {
+        const function<RunSample()> run = [&] {
+            const unique_ptr<Algorithm> algorithm = create();
+            algorithm->load_graph(graph_path);
+            if (isolation.flush_llc) flush_last_level_cache();
+            reset_scheduler_stats();
+            const auto time = isolation.enabled ? algorithm->compute() : measure(*algorithm);
+            return RunSample{static_cast<double>(time.count()), scheduler_stats()};
+        };
+        if (!isolation.enabled) {
+            if (isolation.drop_page_cache) drop_page_cache();
+            return run();
+        }
+        MeasureGuard guard;
+        return run_isolated(isolation, run);
+    }
+
+    // Setup that starts library threads or device contexts, e.g. SPLA, runs in a child of its own when the runs
+    // are isolated, the forked runs could not use them
+    inline void run_outside_of_parent(const function<void()> &setup) {
+        if (!isolation.enabled) {
+            setup();
+            return;
+        }
+        run_isolated<int>(isolation, [&] {
+            setup();
+            return 0;
+        });
+    }
+
+    inline void print_isolation() {
+        cout << "Run isolation: " << (isolation.enabled ? "ENABLED" : "DISABLED");
+        if (isolation.enabled) {
+            cout << " (CPUs " << (isolation.cpus.empty() ? "inherited" : format_cpu_list(isolation.cpus))
+                 << (isolation.flush_llc ? ", LLC flushed" : "") << (isolation.drop_page_cache ? ", page cache dropped" : "")
+                 << ")";
+        }
+        cout << endl;
+        cout << "CPU frequency governor: " << cpu_frequency_governor(isolation.cpus) << endl;
+    }
+
+    // Loaders of the prefetched forms: the structure, or the weights in their narrowest type
+    inline void prefetch_csr(const filesystem::path &path) {
+        auto g = make_shared<const CsrGraph>(load_csr(path));
+        const size_t bytes = g->memory_bytes();
+        GraphCache::instance().insert(path, std::move(g), bytes);
+    }
+
+    inline void prefetch_weighted_csr(const filesystem::path &path) {
+        const WeightType type = detect_weight_type(path);
+        GraphCache::instance().insert(path, make_shared<const WeightType>(type), 0);
+        visit_weight_type(type, [&]<typename W>() {
+            auto g = make_shared<const WeightedCsrGraph<W>>(load_weighted_csr<W>(path));
+            const size_t bytes = g->memory_bytes() + g->weights.size() * sizeof(W);
+            GraphCache::instance().insert(path, std::move(g), bytes);
+        });
+    }
+
+    // Runs sweep(i) for every graph while the next one is loaded in the background
+    inline void run_sweep(const vector<string> &graph_files, const GraphPrefetcher::Loader &loader,
+                          const function<void(size_t)> &sweep) {
+        const auto start = chrono::steady_clock::now();
+        print_isolation();
+        // graphs read ahead would be dropped from the page cache again before their runs
+        GraphPrefetcher prefetch(vector<filesystem::path>(graph_files.begin(), graph_files.end()), loader,
+                                 isolation.drop_page_cache ? 0 : default_prefetch_budget());
+        cout << "Graph prefetching: " << (prefetch.enabled() ? "ENABLED" : "DISABLED") << endl;
+        prefetcher = &prefetch;
+        for (size_t i = 0; i < graph_files.size(); ++i) {
+            prefetch.advance(i);
+            sweep(i);
+        }
+        prefetcher = nullptr;
+        cout << "Sweep took " << fixed << setprecision(1)
+             << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s" << endl;
+    }
+
+    inline BenchmarkResult run_benchmark(const string &algo_name, const string &graph_path, int warm_up_runs, int num_runs,
+                                         const AlgorithmFactory &create) {
         BenchmarkResult result;
         result.algorithm_name = algo_name;
         result.graph_name = filesystem::path(graph_path).filename().string();
@@ -29,35 +150,77 @@ namespace bench {
         cout << "Warm up before exec " << algo_name << " on " << result.graph_name << "..." << endl;
 
         for (int i = 0; i < warm_up_runs; ++i) {
-            const unique_ptr<Algorithm> algorithm(create_algorithm<AlgoType>());
-
             cout << "  Run " << (i + 1) << "/" << warm_up_runs << "..." << flush;
 
-            algorithm->load_graph(graph_path);
-            auto time = algorithm->compute();
-            cout << " " << fixed << setprecision(2) << time.count() << " ms" << endl;
+            const RunSample sample = run_once(graph_path, create);
+            cout << " " << fixed << setprecision(2) << sample.milliseconds << " ms" << endl;
         }
 
         cout << "Running " << algo_name << " on " << result.graph_name << "..." << endl;
 
         result.execution_times.reserve(num_runs);
         for (int i = 0; i < num_runs; ++i) {
-            const unique_ptr<Algorithm> algorithm(create_algorithm<AlgoType>());
-
             cout << "  Run " << (i + 1) << "/" << num_runs << "..." << flush;
 
-            algorithm->load_graph(graph_path);
-
-            auto time = algorithm->compute();
-            double seconds = time.count();
+            const RunSample sample = run_once(graph_path, create);
+            double seconds = sample.milliseconds;
             result.execution_times.push_back(seconds);
+            const SchedulerStats &stats = sample.scheduler;
+            result.scheduler.push_back(stats);
 
-            cout << " " << fixed << setprecision(2) << seconds << " ms" << endl;
+            cout << " " << fixed << setprecision(2) << seconds << " ms";
+            if (stats.loops > 0) {
+                cout << " (" << stats.steals << " steals, " << stats.idle_seconds * 1000 << " ms idle)";
+            }
+            cout << endl;
         }
 
         return result;
     }
 
+    template<typename AlgoType>
+    BenchmarkResult run_benchmark(const string &algo_name, const string &graph_path, int warm_up_runs, int num_runs) {
+        return run_benchmark(algo_name, graph_path, warm_up_runs, num_runs,
+                             [] { return unique_ptr<Algorithm>(create_algorithm<AlgoType>()); });
+    }
+
+    // Steals and idle time of the runs on the work-stealing scheduler, one row per run
+    inline void save_scheduler_stats_to_csv(const vector<BenchmarkResult> &results, const string &output_file) {
+        const bool any = ranges::any_of(results, [](const BenchmarkResult &result) {
+            return ranges::any_of(result.scheduler, [](const SchedulerStats &stats) { return stats.loops > 0; });
+        });
+        if (!any) return;
+
+        ofstream file(output_file);
+        if (!file.is_open()) {
+            throw runtime_error("Failed to open output file: " + output_file);
+        }
+        file << "Algorithm,Graph,Run,Loops,Tasks,Steals,IdleMs" << endl;
+        for (const auto &result: results) {
+            for (size_t i = 0; i < result.scheduler.size(); ++i) {
+                const SchedulerStats &stats = result.scheduler[i];
+                if (stats.loops == 0) continue;
+                file << result.algorithm_name << "," << result.graph_name << "," << i + 1 << "," << stats.loops << ","
+                     << stats.tasks << "," << stats.steals << "," << stats.idle_seconds * 1000 << endl;
+            }
+        }
+        cout << "Scheduler statistics saved to " << output_file << endl;
+    }
+
+    // Settings the runs were measured under, one key per row
+    inline void save_environment_to_csv(const string &output_file) {
+        ofstream file(output_file);
+        if (!file.is_open()) {
+            throw runtime_error("Failed to open output file: " + output_file);
+        }
+        file << "Key,Value" << endl;
+        file << "Isolated," << isolation.enabled << endl;
+        file << "Cpus,\"" << format_cpu_list(isolation.cpus) << "\"" << endl;
+        file << "FlushLlc," << isolation.flush_llc << endl;
+        file << "DropPageCache," << isolation.drop_page_cache << endl;
+        file << "Governor,\"" << cpu_frequency_governor(isolation.cpus) << "\"" << endl;
+    }
+
     inline void save_results_to_csv(const vector<BenchmarkResult> &results, const string &output_file) {
         ofstream file(output_file);
 
@@ -81,5 +244,30 @@ namespace bench {
 
         file.close();
         cout << "Results saved to " << output_file << endl;
+        const string stem = filesystem::path(output_file).replace_extension().string();
+        save_scheduler_stats_to_csv(results, stem + "_scheduler.csv");
+        save_environment_to_csv(stem + "_environment.csv");
+    }
+
+    // With ALGOS_TRACE the latest events of every thread are written to ALGOS_TRACE_FILE, trace.json by default
+    inline void save_trace() {
+        if constexpr (trace::ENABLED) {
+            const char *env = getenv("ALGOS_TRACE_FILE");
+            const filesystem::path path = env ? env : "trace.json";
+            trace::write_chrome_trace(path);
+            cout << "Trace saved to " << path.string() << endl;
+        }
+    }
+
+    // Calibration mode of the benchmarks: fits the cost models of the dispatcher candidates on this
+    // machine and merges them into the model file
+    template<typename Base>
+    void run_calibration(const vector<Candidate<Base>> &candidates, const vector<string> &graph_files, bool weighted,
+                         const filesystem::path &model_path, int runs) {
+        cout << "Calibrating " << candidates.size() << " candidates on " << graph_files.size() << " graphs..." << endl;
+        CostModel model = CostModel::load(model_path);
+        calibrate(candidates, vector<filesystem::path>(graph_files.begin(), graph_files.end()), weighted, runs, model);
+        model.save(model_path);
+        cout << "Cost model saved to " << model_path.string() << endl;
     }
 }// namespace bench
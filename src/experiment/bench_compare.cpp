@@ -0,0 +1,58 @@
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/benchmark_stats.hpp"
+
+using namespace std;
+using namespace algos;
+
+// Compares two result files of the benchmarks, e.g. of the main branch and of a change:
+// bench_compare <baseline.csv> <candidate.csv> [--threshold 0.05] [--alpha 0.01]
+// Exits with 1 if some algorithm got significantly slower by more than the threshold on some graph
+int main(int argc, char **argv) {
+    vector<string> files;
+    CompareOptions options;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            options.threshold = stod(argv[++i]);
+        } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            options.alpha = stod(argv[++i]);
+        } else {
+            files.emplace_back(argv[i]);
+        }
+    }
+    if (files.size() != 2) {
+        cerr << "Usage: " << argv[0] << " <baseline.csv> <candidate.csv> [--threshold 0.05] [--alpha 0.01]" << endl;
+        return 2;
+    }
+
+    vector<Comparison> comparisons;
+    try {
+        comparisons = compare_benchmarks(read_benchmark_csv(files[0]), read_benchmark_csv(files[1]), options);
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 2;
+    }
+
+    cout << setw(28) << left << "algorithm" << setw(32) << "graph" << right << setw(10) << "speedup" << setw(20)
+         << "95% interval" << setw(12) << "p-value" << endl;
+    int regressions = 0;
+    for (const auto &cmp: comparisons) {
+        cout << setw(28) << left << cmp.algorithm << setw(32) << cmp.graph << right << fixed << setprecision(3)
+             << setw(10) << cmp.speedup << setw(6) << "[" << setw(6) << cmp.interval.low << ", " << setw(6) << cmp.interval.high
+             << "]" << setw(12) << setprecision(4) << cmp.p_value << (cmp.regression ? "  REGRESSION" : "") << endl;
+        regressions += cmp.regression;
+    }
+
+    if (comparisons.empty()) {
+        cout << "No (algorithm, graph) pairs in common" << endl;
+    }
+    if (regressions > 0) {
+        cout << regressions << " significant slowdown(s) above " << setprecision(1) << options.threshold * 100 << "%" << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,11 +1,17 @@
+#include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include "autotune/auto_parent_bfs.hpp"
 #include "bench_commons.h"
+#include "common/graph500.hpp"
+#include "common/graph_input.hpp"
 #include "lagraph/parent_bfs_lagraph.hpp"
+#include "native/parent_bfs_native.hpp"
 #include "spla/library_spla.hpp"
 #include "spla/parent_bfs_spla.hpp"
 
@@ -17,10 +23,83 @@ using namespace std;
 using namespace algos;
 using namespace bench;
 
-int main() {
+namespace {
+    constexpr uint32_t GRAPH500_ROOTS = 64;
+
+    // Graph500 kernel 2: every algorithm loads the graph once and searches from the same sampled roots.
+    // Each search is timed by wall clock, validated and counted as the edges of the root's component
+    void run_graph500(const string &graph_path, const string &scale, uint32_t edge_factor) {
+        // 64-bit edge offsets for the validation, so Kronecker graphs of scale 27 and more fit
+        const WideEdgeCsrGraph g = load_csr<uint32_t, uint64_t>(graph_path);
+        const auto roots = sample_roots(g, GRAPH500_ROOTS);
+        cout << "Graph500 BFS on " << filesystem::path(graph_path).filename().string() << ": " << g.n << " vertices, "
+             << g.edges() / 2 << " edges, " << roots.size() << " roots" << endl;
+
+        vector<pair<string, function<unique_ptr<ParentBfsAlgorithm>()>>> algorithms{
+                {"BfsLagraph", [] { return make_unique<ParentBfsLagraph>(); }},
+                {"BfsSpla", [] { return make_unique<ParentBfsSpla>(); }},
+                {"BfsNative", [] { return make_unique<ParentBfsNative>(); }},
+        };
+
+        ofstream csv("graph500_results_bfs.csv");
+        csv << "Algorithm,Root,Seconds,Edges,TEPS\n";
+        for (const auto &[name, create]: algorithms) {
+            try {
+                const auto algo = create();
+                algo->load_graph(graph_path);
+                vector<double> teps;
+                for (const uint32_t root: roots) {
+                    algo->set_root(root);
+                    const auto start = chrono::steady_clock::now();
+                    algo->compute();
+                    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                    const uint64_t edges = validate_bfs_tree(g, root, algo->get_result().parent);
+                    teps.push_back(static_cast<double>(edges) / seconds);
+                    csv << name << "," << root << "," << seconds << "," << edges << "," << teps.back() << "\n";
+                }
+
+                const TepsStatistics stats = teps_statistics(teps);
+                cout << name << endl
+                     << "SCALE:                          " << scale << endl
+                     << "edgefactor:                     " << edge_factor << endl
+                     << "NBFS:                           " << teps.size() << endl
+                     << scientific << setprecision(6)
+                     << "min_TEPS:                       " << stats.min << endl
+                     << "firstquartile_TEPS:             " << stats.first_quartile << endl
+                     << "median_TEPS:                    " << stats.median << endl
+                     << "thirdquartile_TEPS:             " << stats.third_quartile << endl
+                     << "max_TEPS:                       " << stats.max << endl
+                     << "harmonic_mean_TEPS:             " << stats.harmonic_mean << endl
+                     << "harmonic_stddev_TEPS:           " << stats.harmonic_stddev << endl
+                     << defaultfloat;
+            } catch (const exception &e) {
+                cerr << "Error running " << name << ": " << e.what() << endl;
+            }
+        }
+    }
+}// namespace
+
+// Pass --calibrate [model file] to fit the cost model of the AutoParentBfs dispatcher instead of benchmarking,
+// --graph500 [scale | file.mtx] [edge factor] to run the Graph500 BFS kernel on a Kronecker graph or a given file
+int main(int argc, char **argv) {
     cout << "Prent BFS Algorithms Benchmark" << endl;
 
-    print_spla_accelerator_info();
+    run_outside_of_parent(print_spla_accelerator_info);
+
+    if (argc > 1 && string(argv[1]) == "--graph500") {
+        const string target = argc > 2 ? argv[2] : "16";
+        const uint32_t edge_factor = argc > 3 ? stoul(argv[3]) : 16;
+        if (is_graph_file(target)) {
+            run_graph500(target, "-", edge_factor);
+            return 0;
+        }
+        const auto path = filesystem::temp_directory_path() / ("graph500_" + target + "_" + to_string(edge_factor) + ".mtx");
+        cout << "Generating Kronecker graph of scale " << target << "..." << endl;
+        write_mtx(path, kronecker_graph(stoul(target), edge_factor));
+        run_graph500(path.string(), target, edge_factor);
+        filesystem::remove(path);
+        return 0;
+    }
 
     // List of algorithms to benchmark
     vector<pair<string, function<BenchmarkResult(const string &, int, int)>>> algorithms{};
@@ -31,10 +110,24 @@ int main() {
     algorithms.emplace_back("BfsSpla", [](const string &graph_path, int warm_up, int measure) {
         return run_benchmark<ParentBfsSpla>("BfsSpla", graph_path, warm_up, measure);
     });
+    algorithms.emplace_back("BfsNative", [](const string &graph_path, int warm_up, int measure) {
+        return run_benchmark<ParentBfsNative>("BfsNative", graph_path, warm_up, measure);
+    });
+    algorithms.emplace_back("BfsNativeCompressed", [](const string &graph_path, int warm_up, int measure) {
+        return run_benchmark("BfsNativeCompressed", graph_path, warm_up, measure,
+                             [] { return make_unique<ParentBfsNative>(GraphStorage::Compressed); });
+    });
+    algorithms.emplace_back("BfsNativeBlocked", [](const string &graph_path, int warm_up, int measure) {
+        return run_benchmark("BfsNativeBlocked", graph_path, warm_up, measure,
+                             [] { return make_unique<ParentBfsNative>(GraphStorage::Csr, Propagation::Blocked); });
+    });
+    algorithms.emplace_back("BfsAuto", [](const string &graph_path, int warm_up, int measure) {
+        return run_benchmark<AutoParentBfs>("BfsAuto", graph_path, warm_up, measure);
+    });
 
     vector<string> graph_files;
     for (const auto &entry: filesystem::directory_iterator(DATA_DIR)) {
-        if (entry.path().extension() == ".mtx") {
+        if (is_graph_file(entry.path())) {
             graph_files.push_back(entry.path().string());
         }
     }
@@ -50,11 +143,18 @@ int main() {
         cout << "  - " << filesystem::path(file).filename().string() << endl;
     }
 
+    if (argc > 1 && string(argv[1]) == "--calibrate") {
+        const filesystem::path model_path = argc > 2 ? filesystem::path(argv[2]) : default_cost_model_path();
+        run_calibration(AutoParentBfs::candidates(), graph_files, false, model_path, 5);
+        return 0;
+    }
+
     const int WARM_UP_RUNS = 3;
     const int MEASURE_RUNS = 20;
 
     vector<BenchmarkResult> all_results;
-    for (const auto &graph_file: graph_files) {
+    run_sweep(graph_files, prefetch_csr, [&](size_t i) {
+        const string &graph_file = graph_files[i];
         for (const auto &[algo_name, benchmark_func]: algorithms) {
             try {
                 BenchmarkResult result = benchmark_func(graph_file, WARM_UP_RUNS, MEASURE_RUNS);
@@ -64,10 +164,11 @@ int main() {
                      << ": " << e.what() << endl;
             }
         }
-    }
+    });
 
     string output_file = "benchmark_results_bfs.csv";
     save_results_to_csv(all_results, output_file);
+    save_trace();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_commons.h"
+#include "common/graph_input.hpp"
+#include "lagraph/connected_components_lagraph.hpp"
+#include "native/afforest_native.hpp"
+#include "native/fast_sv_native.hpp"
+
+#ifndef DATA_DIR
+#define DATA_DIR "data"
+#endif
+
+using namespace std;
+using namespace algos;
+using namespace bench;
+
+int main() {
+    cout << "Connected Components Algorithms Benchmark" << endl;
+
+    // List of algorithms to benchmark
+    vector<pair<string, function<BenchmarkResult(const string &, int, int)>>> algorithms{};
+
+    algorithms.emplace_back("CcLagraph", [](const string &graph_path, int warm_up, int measure) {
+        return run_benchmark<ConnectedComponentsLagraph>("CcLagraph", graph_path, warm_up, measure);
+    });
+    algorithms.emplace_back("AfforestNative", [](const string &graph_path, int warm_up, int measure) {
+        return run_benchmark<AfforestNative>("AfforestNative", graph_path, warm_up, measure);
+    });
+    algorithms.emplace_back("FastSvNative", [](const string &graph_path, int warm_up, int measure) {
+        return run_benchmark<FastSvNative>("FastSvNative", graph_path, warm_up, measure);
+    });
+
+    vector<string> graph_files;
+    for (const auto &entry: filesystem::directory_iterator(DATA_DIR)) {
+        if (is_graph_file(entry.path())) {
+            graph_files.push_back(entry.path().string());
+        }
+    }
+
+    if (graph_files.empty()) {
+        cout << "No .mtx files found in the data directory." << endl;
+        cout << "Please place graph files in the data directory and try again." << endl;
+        return 1;
+    }
+
+    cout << "Found " << graph_files.size() << " graph files in the data directory." << endl;
+    for (const auto &file: graph_files) {
+        cout << "  - " << filesystem::path(file).filename().string() << endl;
+    }
+
+    const int WARM_UP_RUNS = 3;
+    const int MEASURE_RUNS = 20;
+
+    vector<BenchmarkResult> all_results;
+    for (const auto &graph_file: graph_files) {
+        for (const auto &[algo_name, benchmark_func]: algorithms) {
+            try {
+                BenchmarkResult result = benchmark_func(graph_file, WARM_UP_RUNS, MEASURE_RUNS);
+                all_results.push_back(result);
+            } catch (const exception &e) {
+                cerr << "Error running " << algo_name << " on " << filesystem::path(graph_file).filename().string()
+                     << ": " << e.what() << endl;
+            }
+        }
+    }
+
+    string output_file = "benchmark_results_cc.csv";
+    save_results_to_csv(all_results, output_file);
+    save_trace();
+
+    return 0;
+}
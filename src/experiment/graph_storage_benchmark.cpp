@@ -0,0 +1,94 @@
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "common/compressed_graph.hpp"
+#include "common/csr_graph.hpp"
+#include "common/graph_input.hpp"
+
+#ifndef DATA_DIR
+#define DATA_DIR "data"
+#endif
+
+using namespace std;
+using namespace algos;
+
+namespace {
+    // Best time of a full pass over all neighbour lists, the sum keeps the decoding alive
+    template<typename Graph>
+    double scan_seconds(const Graph &g, uint32_t n, int runs, uint64_t &checksum) {
+        double best = 1e30;
+        for (int run = 0; run < runs; ++run) {
+            uint64_t sum = 0;
+            const auto start = chrono::steady_clock::now();
+#pragma omp parallel for schedule(dynamic, 1024) reduction(+ : sum)
+            for (int64_t v = 0; v < n; ++v) {
+                g.for_each_neighbor(static_cast<uint32_t>(v), [&](uint32_t u) { sum += u; });
+            }
+            const auto end = chrono::steady_clock::now();
+            best = min(best, chrono::duration<double>(end - start).count());
+            checksum = sum;
+        }
+        return best;
+    }
+
+    // Same pass over the edge list, every edge adds both of its ends as in the symmetric scan
+    double scan_seconds(const EdgeListGraph<NoWeight> &g, int runs, uint64_t &checksum) {
+        double best = 1e30;
+        for (int run = 0; run < runs; ++run) {
+            uint64_t sum = 0;
+            const auto start = chrono::steady_clock::now();
+#pragma omp parallel for schedule(static) reduction(+ : sum)
+            for (int64_t e = 0; e < static_cast<int64_t>(g.edges()); ++e) {
+                sum += g.src[e] + g.dst[e];
+            }
+            const auto end = chrono::steady_clock::now();
+            best = min(best, chrono::duration<double>(end - start).count());
+            checksum = sum;
+        }
+        return best;
+    }
+}// namespace
+
+// Memory footprint and neighbour decode throughput of CSR, compressed adjacency and the edge list of the MST
+// algorithms, bytes per directed CSR entry so that the rows compare directly
+int main() {
+    cout << "Graph Storage Benchmark" << endl;
+
+    const int NUM_RUNS = 10;
+
+    cout << setw(32) << "graph" << setw(12) << "storage" << setw(14) << "bytes/edge" << setw(16) << "Medges/s" << endl;
+    for (const auto &entry: filesystem::directory_iterator(DATA_DIR)) {
+        if (!is_graph_file(entry.path())) continue;
+        const string name = entry.path().filename().string();
+        try {
+            const CsrGraph csr = load_csr(entry.path());
+            const CompressedGraph compressed = CompressedGraph::compress(csr);
+            const EdgeListGraph<NoWeight> edge_list = load_edge_list(entry.path());
+            if (csr.edges() == 0) continue;
+            const auto edges = static_cast<double>(csr.edges());
+
+            uint64_t csr_sum = 0, compressed_sum = 0, edge_list_sum = 0;
+            const double csr_seconds = scan_seconds(csr, csr.n, NUM_RUNS, csr_sum);
+            const double compressed_seconds = scan_seconds(compressed, csr.n, NUM_RUNS, compressed_sum);
+            const double edge_list_seconds = scan_seconds(edge_list, NUM_RUNS, edge_list_sum);
+            if (csr_sum != compressed_sum || csr_sum != edge_list_sum) {
+                throw runtime_error("Decoded neighbours differ from CSR");
+            }
+
+            cout << setw(32) << name << setw(12) << to_string(GraphStorage::Csr) << setw(14) << fixed << setprecision(2)
+                 << csr.memory_bytes() / edges << setw(16) << edges / csr_seconds / 1e6 << endl;
+            cout << setw(32) << name << setw(12) << to_string(GraphStorage::Compressed) << setw(14) << fixed << setprecision(2)
+                 << compressed.memory_bytes() / edges << setw(16) << edges / compressed_seconds / 1e6 << endl;
+            cout << setw(32) << name << setw(12) << to_string(GraphStorage::EdgeList) << setw(14) << fixed << setprecision(2)
+                 << edge_list.memory_bytes() / edges << setw(16) << edges / edge_list_seconds / 1e6 << endl;
+        } catch (const exception &e) {
+            cerr << "Error on " << name << ": " << e.what() << endl;
+        }
+    }
+
+    return 0;
+}
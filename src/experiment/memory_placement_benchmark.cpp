@@ -0,0 +1,78 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_commons.h"
+#include "common/graph_input.hpp"
+#include "common/numa_allocator.hpp"
+#include "common/weight_type.hpp"
+#include "native/boruvka_native.hpp"
+#include "native/parent_bfs_native.hpp"
+
+#ifndef DATA_DIR
+#define DATA_DIR "data"
+#endif
+
+using namespace std;
+using namespace algos;
+using namespace bench;
+
+// Native MST and BFS under every memory policy given on the command line, e.g.
+// memory_placement_benchmark first-touch interleave+thp interleave+huge
+int main(int argc, char **argv) {
+    cout << "Memory Placement Benchmark" << endl;
+    cout << "NUMA nodes: " << numa_node_count() << endl;
+
+    vector<MemoryPolicy> policies;
+    for (int i = 1; i < argc; ++i) {
+        policies.push_back(parse_memory_policy(argv[i]));
+    }
+    if (policies.empty()) {
+        for (const auto placement: {NumaPlacement::FirstTouch, NumaPlacement::Interleave}) {
+            for (const auto pages: {PageSize::Small, PageSize::Transparent}) {
+                policies.push_back({placement, pages});
+            }
+        }
+    }
+
+    vector<string> graph_files;
+    for (const auto &entry: filesystem::directory_iterator(DATA_DIR)) {
+        if (is_graph_file(entry.path())) {
+            graph_files.push_back(entry.path().string());
+        }
+    }
+
+    if (graph_files.empty()) {
+        cout << "No .mtx files found in the data directory." << endl;
+        cout << "Please place graph files in the data directory and try again." << endl;
+        return 1;
+    }
+
+    const int WARM_UP_RUNS = 1;
+    const int MEASURE_RUNS = 10;
+
+    vector<BenchmarkResult> all_results;
+    for (const auto &graph_file: graph_files) {
+        for (const MemoryPolicy policy: policies) {
+            // The graph and the scratch arrays are allocated by load_graph and compute, after the policy is set
+            set_memory_policy(policy);
+            const string suffix = "[" + to_string(policy) + "]";
+            try {
+                const WeightType type = detect_weight_type(graph_file);
+                all_results.push_back(run_benchmark("BoruvkaNative" + suffix, graph_file, WARM_UP_RUNS, MEASURE_RUNS,
+                                                    [type] { return make_mst_algorithm<BoruvkaNative>(type); }));
+                all_results.push_back(run_benchmark<ParentBfsNative>("BfsNative" + suffix, graph_file, WARM_UP_RUNS, MEASURE_RUNS));
+            } catch (const exception &e) {
+                cerr << "Error on " << filesystem::path(graph_file).filename().string() << " with " << to_string(policy)
+                     << ": " << e.what() << endl;
+            }
+        }
+    }
+
+    string output_file = "benchmark_results_memory.csv";
+    save_results_to_csv(all_results, output_file);
+
+    return 0;
+}
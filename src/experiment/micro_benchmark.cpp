@@ -0,0 +1,215 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "common/csr_graph.hpp"
+#include "common/disjoint_set.hpp"
+#include "common/mtx_reader.hpp"
+#include <spla.hpp>
+
+using namespace std;
+using namespace algos;
+
+// Building blocks of the algorithms timed on their own, so that end-to-end slowdowns can be attributed
+// to a primitive. Every benchmark reports items/s and bytes/s, e.g.
+// micro_benchmark --benchmark_filter=Spla --benchmark_out=micro.json --benchmark_out_format=json
+namespace {
+    // Uniform random graph without self loops, the same for the same arguments
+    detail::CooEdges<uint32_t> random_edges(uint32_t n, size_t m, uint32_t max_weight = 1000) {
+        mt19937_64 rng(n * 31 + m);
+        uniform_int_distribution<uint32_t> vertex(0, n - 1), weight(1, max_weight);
+        detail::CooEdges<uint32_t> coo;
+        coo.src.reserve(m);
+        coo.dst.reserve(m);
+        coo.weights.reserve(m);
+        while (coo.src.size() < m) {
+            const uint32_t u = vertex(rng), v = vertex(rng);
+            if (u == v) continue;
+            coo.src.push_back(u);
+            coo.dst.push_back(v);
+            coo.weights.push_back(weight(rng));
+        }
+        return coo;
+    }
+
+    // Symmetric SPLA matrix of the edges with the given value type, as the algorithms build it
+    spla::ref_ptr<spla::Matrix> make_spla_matrix(uint32_t n, const detail::CooEdges<uint32_t> &coo, bool weighted) {
+        auto a = spla::Matrix::make(n, n, weighted ? spla::UINT : spla::INT);
+        a->set_format(spla::FormatMatrix::AccCsr);
+        a->set_fill_value(weighted ? spla::Scalar::make_uint(UINT32_MAX) : spla::Scalar::make_int(0));
+        for (size_t i = 0; i < coo.src.size(); ++i) {
+            if (weighted) {
+                a->set_uint(coo.src[i], coo.dst[i], coo.weights[i]);
+                a->set_uint(coo.dst[i], coo.src[i], coo.weights[i]);
+            } else {
+                a->set_int(coo.src[i], coo.dst[i], 1);
+                a->set_int(coo.dst[i], coo.src[i], 1);
+            }
+        }
+        return a;
+    }
+
+    constexpr uint32_t SPLA_VERTICES = 1 << 16;
+    constexpr uint32_t SPLA_DEGREE = 8;
+
+    void BM_MtxParse(benchmark::State &state) {
+        const auto m = static_cast<size_t>(state.range(0));
+        const auto n = static_cast<uint32_t>(m / 4);
+        const auto coo = random_edges(n, m);
+        const auto path = filesystem::temp_directory_path() / ("algos_micro_" + to_string(m) + ".mtx");
+        {
+            ofstream file(path);
+            file << "%%MatrixMarket matrix coordinate integer symmetric\n" << n << " " << n << " " << m << "\n";
+            for (size_t i = 0; i < m; ++i) {
+                file << coo.src[i] + 1 << " " << coo.dst[i] + 1 << " " << coo.weights[i] << "\n";
+            }
+        }
+        for (auto _: state) {
+            GraphInput input;
+            const MtxHeader header = open_mtx_graph(path, input);
+            uint64_t sum = 0;
+            for_each_mtx_edge<uint32_t>(input, header, [&sum](uint32_t u, uint32_t v, uint32_t w) { sum += u ^ v ^ w; });
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(m));
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(filesystem::file_size(path)));
+        filesystem::remove(path);
+    }
+    BENCHMARK(BM_MtxParse)->RangeMultiplier(8)->Range(1 << 12, 1 << 21)->Unit(benchmark::kMillisecond);
+
+    void BM_CooToCsr(benchmark::State &state) {
+        const auto m = static_cast<size_t>(state.range(0));
+        const auto n = static_cast<uint32_t>(m / 4);
+        const auto coo = random_edges(n, m);
+        for (auto _: state) {
+            WeightedCsrGraph<uint32_t> g;
+            detail::build_symmetric_csr(n, coo, g, &g.weights);
+            benchmark::DoNotOptimize(g.cols.data());
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(m));
+        // every entry is read once and written twice as (col, weight)
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(m * 3 * sizeof(uint32_t) + 2 * m * 2 * sizeof(uint32_t)));
+    }
+    BENCHMARK(BM_CooToCsr)->RangeMultiplier(8)->Range(1 << 12, 1 << 24)->Unit(benchmark::kMillisecond);
+
+    // One BFS level: product of a frontier of the given size, masked by the unvisited vertices
+    void BM_SplaVxmMasked(benchmark::State &state) {
+        using namespace spla;
+        const auto front_size = static_cast<uint32_t>(state.range(0));
+        const auto a = make_spla_matrix(SPLA_VERTICES, random_edges(SPLA_VERTICES, size_t{SPLA_VERTICES} * SPLA_DEGREE / 2), false);
+        const auto zero = Scalar::make_int(0);
+
+        auto parent = Vector::make(SPLA_VERTICES, INT);
+        parent->set_fill_value(zero);
+        auto front = Vector::make(SPLA_VERTICES, INT);
+        front->set_fill_value(zero);
+        for (uint32_t v = 0; v < front_size; ++v) {
+            front->set_int(v, static_cast<int>(v + 1));
+            parent->set_int(v, static_cast<int>(v + 1));
+        }
+        auto discovered = Vector::make(SPLA_VERTICES, INT);
+        discovered->set_fill_value(zero);
+        auto desc = Descriptor::make();
+        desc->set_early_exit(true);
+        desc->set_struct_only(true);
+
+        for (auto _: state) {
+            exec_vxm_masked(discovered, parent, front, a, FIRST_INT, FIRST_INT, EQZERO_INT, zero, desc);
+        }
+        // the frontier rows are scanned
+        const int64_t edges = int64_t{front_size} * SPLA_DEGREE;
+        state.SetItemsProcessed(state.iterations() * edges);
+        state.SetBytesProcessed(state.iterations() * edges * static_cast<int64_t>(sizeof(uint32_t) + sizeof(int)));
+    }
+    BENCHMARK(BM_SplaVxmMasked)->RangeMultiplier(4)->Range(1, SPLA_VERTICES)->Unit(benchmark::kMicrosecond);
+
+    // Minimum edge of every vertex as in BoruvkaSpla
+    void BM_SplaReduceByRow(benchmark::State &state) {
+        using namespace spla;
+        const auto n = static_cast<uint32_t>(state.range(0));
+        const size_t m = size_t{n} * SPLA_DEGREE / 2;
+        const auto a = make_spla_matrix(n, random_edges(n, m), true);
+        const auto inf = Scalar::make_uint(UINT32_MAX);
+        auto edge = Vector::make(n, UINT);
+        edge->set_fill_value(inf);
+
+        for (auto _: state) {
+            exec_m_reduce_by_row(edge, a, MIN_UINT, inf);
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(2 * m));
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(2 * m * 2 * sizeof(uint32_t)));
+    }
+    BENCHMARK(BM_SplaReduceByRow)->RangeMultiplier(4)->Range(1 << 10, 1 << 18)->Unit(benchmark::kMicrosecond);
+
+    // Values of a dense vector copied back to the host as in get_result of the SPLA algorithms
+    void BM_SplaMemViewRead(benchmark::State &state) {
+        using namespace spla;
+        const auto n = static_cast<uint32_t>(state.range(0));
+        auto v = Vector::make(n, INT);
+        v->set_fill_value(Scalar::make_int(-1));
+        for (uint32_t i = 0; i < n; ++i) {
+            v->set_int(i, static_cast<int>(i));
+        }
+        vector<int> keys(n), values(n);
+
+        for (auto _: state) {
+            auto count = Scalar::make_uint(0);
+            exec_v_count_mf(count, v);
+            auto keys_view = MemView::make(keys.data(), count->as_uint());
+            auto values_view = MemView::make(values.data(), count->as_uint());
+            v->read(keys_view, values_view);
+            benchmark::DoNotOptimize(keys_view->get_buffer());
+        }
+        state.SetItemsProcessed(state.iterations() * n);
+        state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(n * 2 * sizeof(int)));
+    }
+    BENCHMARK(BM_SplaMemViewRead)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+    // Random unions followed by a find of every element
+    void BM_UnionFind(benchmark::State &state) {
+        const auto n = static_cast<uint32_t>(state.range(0));
+        const auto coo = random_edges(n, n);
+        DisjointSet set(n);
+        for (auto _: state) {
+            set.reset(n);
+            uint32_t merged = 0;
+            for (size_t i = 0; i < coo.src.size(); ++i) {
+                merged += set.unite(coo.src[i], coo.dst[i]);
+            }
+            for (uint32_t v = 0; v < n; ++v) {
+                merged += set.find(v);
+            }
+            benchmark::DoNotOptimize(merged);
+        }
+        // one unite and one find per element
+        state.SetItemsProcessed(state.iterations() * 2 * static_cast<int64_t>(n));
+        state.SetBytesProcessed(state.iterations() * 2 * static_cast<int64_t>(n) * (sizeof(uint32_t) + 1));
+    }
+    BENCHMARK(BM_UnionFind)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+    // The candidate queue of PrimSpla: batches of inserts, each followed by taking the minimum
+    void BM_PrimQueue(benchmark::State &state) {
+        const auto n = static_cast<uint32_t>(state.range(0));
+        const auto coo = random_edges(n, size_t{n} * SPLA_DEGREE);
+        for (auto _: state) {
+            set<pair<float, unsigned int>> s;
+            for (size_t i = 0; i < coo.src.size(); i += SPLA_DEGREE) {
+                for (size_t j = i; j < i + SPLA_DEGREE; ++j) {
+                    s.insert({static_cast<float>(coo.weights[j]), coo.dst[j]});
+                }
+                s.erase(s.begin());
+            }
+            benchmark::DoNotOptimize(s.size());
+        }
+        const int64_t operations = int64_t{n} * (SPLA_DEGREE + 1);
+        state.SetItemsProcessed(state.iterations() * operations);
+        state.SetBytesProcessed(state.iterations() * int64_t{n} * SPLA_DEGREE * static_cast<int64_t>(sizeof(pair<float, unsigned int>)));
+    }
+    BENCHMARK(BM_PrimQueue)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMicrosecond);
+}// namespace
+
+BENCHMARK_MAIN();
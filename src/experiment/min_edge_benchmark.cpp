@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "native/min_edge_kernel.hpp"
+
+using namespace std;
+using namespace algos;
+
+// Throughput of the per-vertex minimum edge reduction on synthetic CSR rows of fixed degree
+int main() {
+    cout << "Min Edge Kernel Benchmark" << endl;
+
+    const SimdLevel best = detect_simd_level();
+    cout << "Best supported SIMD level: " << to_string(best) << endl;
+
+    vector<SimdLevel> levels = {SimdLevel::Scalar};
+    if (best >= SimdLevel::Avx2) levels.push_back(SimdLevel::Avx2);
+    if (best >= SimdLevel::Avx512) levels.push_back(SimdLevel::Avx512);
+
+    const uint32_t TOTAL_EDGES = 1 << 24;
+    const int NUM_RUNS = 10;
+    mt19937_64 rng(42);
+
+    cout << setw(8) << "degree" << setw(10) << "level" << setw(12) << "GB/s" << setw(12) << "speedup" << endl;
+    for (const uint32_t degree: {3u, 8u, 16u, 64u, 1024u}) {
+        const uint32_t n = TOTAL_EDGES / degree;
+        vector<uint32_t> offsets(n + 1);
+        for (uint32_t v = 0; v <= n; ++v) {
+            offsets[v] = v * degree;
+        }
+        vector<uint64_t> keys(offsets[n]);
+        for (auto &key: keys) {
+            key = encode_edge_key(static_cast<uint32_t>(rng() % 1024), static_cast<uint32_t>(rng() % n));
+        }
+        vector<uint64_t> row_min(n);
+        const double bytes = static_cast<double>(keys.size()) * sizeof(uint64_t) +
+                             static_cast<double>(offsets.size()) * sizeof(uint32_t) +
+                             static_cast<double>(row_min.size()) * sizeof(uint64_t);
+
+        double scalar_seconds = 0;
+        for (const SimdLevel level: levels) {
+            double best_seconds = 1e30;
+            for (int run = 0; run < NUM_RUNS; ++run) {
+                const auto start = chrono::steady_clock::now();
+                row_min_keys(offsets.data(), keys.data(), n, row_min.data(), level);
+                const auto end = chrono::steady_clock::now();
+                best_seconds = min(best_seconds, chrono::duration<double>(end - start).count());
+            }
+            if (level == SimdLevel::Scalar) scalar_seconds = best_seconds;
+            cout << setw(8) << degree << setw(10) << to_string(level) << setw(12) << fixed << setprecision(2)
+                 << bytes / best_seconds / 1e9 << setw(11) << scalar_seconds / best_seconds << "x" << endl;
+        }
+    }
+
+    return 0;
+}
@@ -4,8 +4,12 @@
 #include <string>
 #include <vector>
 
+#include "autotune/auto_mst.hpp"
 #include "bench_commons.h"
+#include "common/graph_input.hpp"
 #include "lagraph/boruvka_lagraph.hpp"
+#include "native/boruvka_native.hpp"
+#include "native/prim_dense.hpp"
 #include "spla/boruvka_spla.hpp"
 #include "spla/library_spla.hpp"
 #include "spla/prim_spla.hpp"
@@ -28,7 +32,16 @@ using namespace std;
 using namespace algos;
 using namespace bench;
 
-int main() {
+// Runs the algorithm instantiated for the narrowest weight type of the graph
+template<template<typename> class Algo, typename... Args>
+BenchmarkResult run_mst_benchmark(const string &algo_name, const string &graph_path, int num_runs, const Args &...args) {
+    const WeightType type = detect_weight_type(graph_path);
+    cout << "Weight type of " << filesystem::path(graph_path).filename().string() << ": " << to_string(type) << endl;
+    return run_benchmark(algo_name, graph_path, 0, num_runs, [type, &args...] { return make_mst_algorithm<Algo>(type, args...); });
+}
+
+// Pass --calibrate [model file] to fit the cost model of the AutoMst dispatcher instead of benchmarking
+int main(int argc, char **argv) {
     cout << "MST Algorithms Benchmark" << endl;
 
 #if USE_GUNROCK
@@ -37,18 +50,36 @@ int main() {
     cout << "CUDA support: DISABLED (Gunrock algorithms unavailable)" << endl;
 #endif
 
-    print_spla_accelerator_info();
+    run_outside_of_parent(print_spla_accelerator_info);
 
     // List of algorithms to benchmark
     vector<pair<string, function<BenchmarkResult(const string &, int)>>>
             algorithms = {{"PrimSpla", [](const string &graph_path, int num_runs) {
-                               return run_benchmark<PrimSpla>("PrimSpla", graph_path, 0, num_runs);
+                               return run_mst_benchmark<PrimSpla>("PrimSpla", graph_path, num_runs);
                            }}};
     algorithms.emplace_back("BoruvkaSpla", [](const string &graph_path, int num_runs) {
-        return run_benchmark<BoruvkaSpla>("BoruvkaSpla", graph_path, 0, num_runs);
+        return run_mst_benchmark<BoruvkaSpla>("BoruvkaSpla", graph_path, num_runs);
     });
     algorithms.emplace_back("BoruvkaLagraph", [](const string &graph_path, int num_runs) {
-        return run_benchmark<BoruvkaLagraph>("BoruvkaLagraph", graph_path, 0, num_runs);
+        return run_mst_benchmark<BoruvkaLagraph>("BoruvkaLagraph", graph_path, num_runs);
+    });
+    algorithms.emplace_back("BoruvkaNative", [](const string &graph_path, int num_runs) {
+        return run_mst_benchmark<BoruvkaNative>("BoruvkaNative", graph_path, num_runs);
+    });
+    algorithms.emplace_back("BoruvkaNativeCompressed", [](const string &graph_path, int num_runs) {
+        return run_mst_benchmark<BoruvkaNative>("BoruvkaNativeCompressed", graph_path, num_runs, GraphStorage::Compressed);
+    });
+    algorithms.emplace_back("BoruvkaNativeBlocked", [](const string &graph_path, int num_runs) {
+        return run_mst_benchmark<BoruvkaNative>("BoruvkaNativeBlocked", graph_path, num_runs, GraphStorage::Csr, Propagation::Blocked);
+    });
+    algorithms.emplace_back("BoruvkaNativeEdgeList", [](const string &graph_path, int num_runs) {
+        return run_mst_benchmark<BoruvkaNative>("BoruvkaNativeEdgeList", graph_path, num_runs, GraphStorage::EdgeList);
+    });
+    algorithms.emplace_back("PrimDense", [](const string &graph_path, int num_runs) {
+        return run_mst_benchmark<PrimDense>("PrimDense", graph_path, num_runs);
+    });
+    algorithms.emplace_back("MstAuto", [](const string &graph_path, int num_runs) {
+        return run_benchmark<AutoMst>("MstAuto", graph_path, 0, num_runs);
     });
 
 #if USE_GUNROCK
@@ -65,7 +96,7 @@ int main() {
     // Find all .mtx files in the data directory
     vector<string> graph_files;
     for (const auto &entry: filesystem::directory_iterator(DATA_DIR)) {
-        if (entry.path().extension() == ".mtx") {
+        if (is_graph_file(entry.path())) {
             graph_files.push_back(entry.path().string());
         }
     }
@@ -81,10 +112,17 @@ int main() {
         cout << "  - " << filesystem::path(file).filename().string() << endl;
     }
 
+    if (argc > 1 && string(argv[1]) == "--calibrate") {
+        const filesystem::path model_path = argc > 2 ? filesystem::path(argv[2]) : default_cost_model_path();
+        run_calibration(AutoMst::candidates(), graph_files, true, model_path, 5);
+        return 0;
+    }
+
     const int NUM_RUNS = 1;
 
     vector<BenchmarkResult> all_results;
-    for (const auto &graph_file: graph_files) {
+    run_sweep(graph_files, prefetch_weighted_csr, [&](size_t i) {
+        const string &graph_file = graph_files[i];
         for (const auto &[algo_name, benchmark_func]: algorithms) {
             try {
                 BenchmarkResult result = benchmark_func(graph_file, NUM_RUNS);
@@ -94,10 +132,11 @@ int main() {
                      << ": " << e.what() << endl;
             }
         }
-    }
+    });
 
     string output_file = "benchmark_results.csv";
     save_results_to_csv(all_results, output_file);
+    save_trace();
 
     return 0;
 }
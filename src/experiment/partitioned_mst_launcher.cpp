@@ -0,0 +1,39 @@
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#include "common/mst_algorithm.hpp"
+#include "common/weight_type.hpp"
+#include "native/boruvka_partitioned.hpp"
+
+using namespace std;
+using namespace algos;
+
+// Runs the partitioned Borůvka on one graph: partitioned_mst_launcher <graph.mtx> [workers] [runs]
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <graph.mtx> [workers] [runs]" << endl;
+        return 1;
+    }
+    const filesystem::path graph_path = argv[1];
+    const uint32_t workers = argc > 2 ? stoul(argv[2]) : 4;
+    const int runs = argc > 3 ? stoi(argv[3]) : 5;
+
+    try {
+        const WeightType type = detect_weight_type(graph_path);
+        cout << "Graph: " << graph_path.filename().string() << ", weight type: " << to_string(type)
+             << ", workers: " << workers << endl;
+
+        auto algo = make_mst_algorithm<BoruvkaPartitioned>(type, workers);
+        algo->load_graph(graph_path);
+        for (int i = 0; i < runs; ++i) {
+            const auto time = algo->compute();
+            cout << "  Run " << (i + 1) << "/" << runs << ": " << time.count() << " ms" << endl;
+        }
+        cout << "MST weight: " << algo->get_result().weight << endl;
+    } catch (const exception &e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
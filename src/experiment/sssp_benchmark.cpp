@@ -0,0 +1,74 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_commons.h"
+#include "common/graph_input.hpp"
+#include "lagraph/shortest_path_lagraph.hpp"
+#include "native/delta_stepping_native.hpp"
+
+#ifndef DATA_DIR
+#define DATA_DIR "data"
+#endif
+
+using namespace std;
+using namespace algos;
+using namespace bench;
+
+// Shortest paths from vertex 0 of every graph in DATA_DIR, road networks such as USA-road-d.USA
+// have to be converted from the DIMACS .gr format to .mtx first
+int main() {
+    cout << "Shortest Path Algorithms Benchmark" << endl;
+
+    // List of algorithms to benchmark
+    vector<pair<string, function<BenchmarkResult(const string &, int, int)>>> algorithms{};
+
+    algorithms.emplace_back("SsspLagraph", [](const string &graph_path, int warm_up, int measure) {
+        return run_benchmark<ShortestPathLagraph>("SsspLagraph", graph_path, warm_up, measure);
+    });
+    algorithms.emplace_back("DeltaSteppingNative", [](const string &graph_path, int warm_up, int measure) {
+        return run_benchmark<DeltaSteppingNative>("DeltaSteppingNative", graph_path, warm_up, measure);
+    });
+
+    vector<string> graph_files;
+    for (const auto &entry: filesystem::directory_iterator(DATA_DIR)) {
+        if (is_graph_file(entry.path())) {
+            graph_files.push_back(entry.path().string());
+        }
+    }
+
+    if (graph_files.empty()) {
+        cout << "No .mtx files found in the data directory." << endl;
+        cout << "Please place graph files in the data directory and try again." << endl;
+        return 1;
+    }
+
+    cout << "Found " << graph_files.size() << " graph files in the data directory." << endl;
+    for (const auto &file: graph_files) {
+        cout << "  - " << filesystem::path(file).filename().string() << endl;
+    }
+
+    const int WARM_UP_RUNS = 3;
+    const int MEASURE_RUNS = 20;
+
+    vector<BenchmarkResult> all_results;
+    for (const auto &graph_file: graph_files) {
+        for (const auto &[algo_name, benchmark_func]: algorithms) {
+            try {
+                BenchmarkResult result = benchmark_func(graph_file, WARM_UP_RUNS, MEASURE_RUNS);
+                all_results.push_back(result);
+            } catch (const exception &e) {
+                cerr << "Error running " << algo_name << " on " << filesystem::path(graph_file).filename().string()
+                     << ": " << e.what() << endl;
+            }
+        }
+    }
+
+    string output_file = "benchmark_results_sssp.csv";
+    save_results_to_csv(all_results, output_file);
+    save_trace();
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "auto_algorithm.hpp"
+
+#include <GraphBLAS.h>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace algos {
+    template<typename G>
+    void ParsedGraph::lend(std::shared_ptr<const G> g, size_t bytes) {
+        GraphCache::instance().insert(path, std::move(g), bytes);
+        release = [p = path] { GraphCache::instance().erase<G>(p); };
+    }
+
+    ParsedGraph::ParsedGraph(std::filesystem::path graph_path, bool weighted) : path(std::move(graph_path)) {
+        GraphCache &cache = GraphCache::instance();
+        if (!weighted) {
+            if (const auto cached = cache.find<CsrGraph>(path)) {
+                graph_features = compute_graph_features(*cached);
+                return;
+            }
+            auto g = std::make_shared<const CsrGraph>(load_csr(path));
+            graph_features = compute_graph_features(*g);
+            const size_t bytes = g->memory_bytes();
+            lend(std::move(g), bytes);
+            return;
+        }
+
+        // A prefetcher caches the weight type together with the graph
+        if (const auto cached = cache.find<WeightType>(path)) {
+            type = *cached;
+            graph_features = visit_weight_type(type, [this, &cache]<typename W>() {
+                const auto g = cache.find<WeightedCsrGraph<W>>(path);
+                return g ? compute_graph_features(*g) : compute_graph_features(load_csr(path));
+            });
+            return;
+        }
+
+        // Self loops are dropped from the graph, but the candidates that read the file themselves see their weights
+        detail::CooEdges<double> coo;
+        WeightRange range;
+        const uint32_t n = detail::read_mtx_coo<double, uint32_t, uint32_t>(path, coo, [&range](double w) { range.add(w); });
+        type = range.narrowest();
+        visit_weight_type(type, [this, n, &coo]<typename W>() {
+            auto g = std::make_shared<WeightedCsrGraph<W>>();
+            detail::build_symmetric_csr(n, coo, *g, &g->weights);
+            graph_features = compute_graph_features(*g);
+            const size_t bytes = g->memory_bytes() + g->weights.size() * sizeof(W);
+            lend(std::shared_ptr<const WeightedCsrGraph<W>>(std::move(g)), bytes);
+        });
+    }
+
+    ParsedGraph::~ParsedGraph() {
+        if (release) release();
+    }
+
+    std::vector<int> thread_counts() {
+        const int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        std::vector<int> res = {1};
+        if (hardware / 2 > 1) res.push_back(hardware / 2);
+        if (hardware > 1) res.push_back(hardware);
+        return res;
+    }
+
+    CostCoefficients prior_with_threads(CostCoefficients c, int threads) {
+        c[0] += 0.01 * threads;
+        c[2] /= 1 + 0.6 * (threads - 1);
+        // Hubs keep the other threads waiting, a single thread does not mind them
+        c[8] += 0.2 * c[2] * (threads - 1) / threads;
+        return c;
+    }
+
+    ThreadCountGuard::ThreadCountGuard(int threads) {
+        if (threads <= 0) return;
+#ifdef _OPENMP
+        previous_omp = omp_get_max_threads();
+        omp_set_num_threads(threads);
+#endif
+        // GraphBLAS fails the query before GrB_init and later starts with the OpenMP setting
+        if (GxB_Global_Option_get(GxB_NTHREADS, &previous_grb) == GrB_SUCCESS) {
+            GxB_Global_Option_set(GxB_NTHREADS, threads);
+        } else {
+            previous_grb = 0;
+        }
+    }
+
+    ThreadCountGuard::~ThreadCountGuard() {
+#ifdef _OPENMP
+        if (previous_omp > 0) omp_set_num_threads(previous_omp);
+#endif
+        if (previous_grb > 0) GxB_Global_Option_set(GxB_NTHREADS, previous_grb);
+    }
+}// namespace algos
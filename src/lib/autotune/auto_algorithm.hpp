@@ -0,0 +1,198 @@
+#pragma once
+
+#include "autotune/cost_model.hpp"
+#include "common/csr_graph.hpp"
+#include "common/graph_features.hpp"
+#include "common/result_export.hpp"
+#include "common/tree.hpp"
+#include "common/weight_type.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace algos {
+    // Implementation with a thread count, 0 threads keeps the library default
+    template<typename Base>
+    struct Candidate {
+        std::string name;
+        int threads = 0;
+        // used while the candidate is not calibrated
+        CostCoefficients prior{};
+        // throws std::runtime_error for weight types the implementation does not support
+        std::function<std::unique_ptr<Base>(WeightType)> make;
+        // graphs the candidate is considered for, all when empty
+        std::function<bool(const GraphFeatures &)> applies;
+
+        [[nodiscard]] std::string key() const { return threads == 0 ? name : name + "@" + std::to_string(threads); }
+    };
+
+    // 1, half and all hardware threads without duplicates
+    std::vector<int> thread_counts();
+
+    // Single thread prior adjusted by an assumed parallel efficiency, the edge term shrinks
+    // and the constant and the degree skew term grow with threads
+    CostCoefficients prior_with_threads(CostCoefficients c, int threads);
+
+    // Sets the OpenMP and GraphBLAS thread counts for its lifetime, 0 threads leaves them as is
+    class ThreadCountGuard {
+    public:
+        explicit ThreadCountGuard(int threads);
+
+        ~ThreadCountGuard();
+
+        ThreadCountGuard(const ThreadCountGuard &) = delete;
+
+        ThreadCountGuard &operator=(const ThreadCountGuard &) = delete;
+
+    private:
+        int previous_omp = 0;
+        int previous_grb = 0;
+    };
+
+    // Graph parsed once for the dispatcher: the features come from its structure, the weight type from its
+    // weights read as doubles. Until destroyed the graph, built with that type, is lent to the candidates
+    // through GraphCache, so the native ones copy it instead of parsing the file again
+    class ParsedGraph {
+    public:
+        ParsedGraph(std::filesystem::path path, bool weighted);
+
+        ~ParsedGraph();
+
+        ParsedGraph(const ParsedGraph &) = delete;
+
+        ParsedGraph &operator=(const ParsedGraph &) = delete;
+
+        [[nodiscard]] const GraphFeatures &features() const { return graph_features; }
+
+        [[nodiscard]] WeightType weight_type() const { return type; }
+
+    private:
+        template<typename G>
+        void lend(std::shared_ptr<const G> g, size_t bytes);
+
+        std::filesystem::path path;
+        GraphFeatures graph_features;
+        WeightType type = WeightType::UInt8;
+        std::function<void()> release;
+    };
+
+    // Dispatcher that parses the graph once, computes its features and forwards everything to the
+    // candidate with the lowest predicted cost
+    template<typename Base>
+    class AutoAlgorithm : public Base {
+    public:
+        AutoAlgorithm(std::vector<Candidate<Base>> candidates, bool weighted, CostModel model)
+            : candidates(std::move(candidates)), weighted(weighted), model(std::move(model)) {}
+
+        void load_graph(const std::filesystem::path &file_path) final {
+            const ParsedGraph parsed(file_path, weighted);
+            graph_features = parsed.features();
+            const WeightType type = parsed.weight_type();
+
+            std::vector<std::pair<double, size_t>> order;
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                if (candidates[i].applies && !candidates[i].applies(graph_features)) continue;
+                order.emplace_back(predicted_cost(candidates[i]), i);
+            }
+            std::ranges::sort(order);
+
+            algo.reset();
+            for (const auto &[cost, i]: order) {
+                try {
+                    algo = candidates[i].make(type);
+                } catch (const std::runtime_error &) {
+                    continue;
+                }
+                chosen = i;
+                predicted_ms = cost;
+                break;
+            }
+            if (!algo) {
+                throw std::runtime_error("No candidate supports weight type " + to_string(type));
+            }
+            algo->load_graph(file_path);
+            loaded();
+        }
+
+        std::chrono::milliseconds compute() final {
+            const ThreadCountGuard guard(candidates[chosen].threads);
+            prepare(*algo);
+            return algo->compute();
+        }
+
+        Tree get_result() final { return algo->get_result(); }
+
+        void write_result(ResultSink &sink) final { algo->write_result(sink); }
+
+        [[nodiscard]] const GraphFeatures &features() const { return graph_features; }
+
+        [[nodiscard]] std::string chosen_candidate() const { return candidates[chosen].key(); }
+
+        [[nodiscard]] double predicted_milliseconds() const { return predicted_ms; }
+
+        [[nodiscard]] double predicted_cost(const Candidate<Base> &candidate) const {
+            return predict_cost(model.get(candidate.key()).value_or(candidate.prior), graph_features);
+        }
+
+    protected:
+        // Passes the settings of the dispatcher to the chosen implementation before every compute
+        virtual void prepare(Base &) {}
+
+        // Resets the settings of the dispatcher that load_graph of the implementations resets
+        virtual void loaded() {}
+
+    private:
+        std::vector<Candidate<Base>> candidates;
+        bool weighted;
+        CostModel model;
+        GraphFeatures graph_features;
+        std::unique_ptr<Base> algo;
+        size_t chosen = 0;
+        double predicted_ms = 0;
+    };
+
+    // Runs every candidate on every graph it applies to and fits its coefficients to the median time of the runs.
+    // Candidates that fail on a graph are skipped for it
+    template<typename Base>
+    void calibrate(const std::vector<Candidate<Base>> &candidates, const std::vector<std::filesystem::path> &graphs,
+                   bool weighted, int runs, CostModel &model) {
+        std::vector<std::vector<CostSample>> samples(candidates.size());
+        for (const auto &graph: graphs) {
+            const ParsedGraph parsed(graph, weighted);
+            const GraphFeatures &features = parsed.features();
+            const WeightType type = parsed.weight_type();
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                if (candidates[i].applies && !candidates[i].applies(features)) continue;
+                try {
+                    const auto algo = candidates[i].make(type);
+                    algo->load_graph(graph);
+                    const ThreadCountGuard guard(candidates[i].threads);
+                    std::vector<double> times;
+                    for (int run = 0; run < runs; ++run) {
+                        const auto start = std::chrono::steady_clock::now();
+                        algo->compute();
+                        const auto end = std::chrono::steady_clock::now();
+                        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+                    }
+                    std::ranges::nth_element(times, times.begin() + times.size() / 2);
+                    samples[i].push_back({features, times[times.size() / 2]});
+                    std::cout << "  " << candidates[i].key() << " on " << graph.filename().string() << ": "
+                              << samples[i].back().milliseconds << " ms" << std::endl;
+                } catch (const std::exception &e) {
+                    std::cerr << "  " << candidates[i].key() << " on " << graph.filename().string() << " skipped: " << e.what() << std::endl;
+                }
+            }
+        }
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (!samples[i].empty()) {
+                model.set(candidates[i].key(), fit_cost_model(samples[i]));
+            }
+        }
+    }
+}// namespace algos
@@ -0,0 +1,28 @@
+#include "auto_mst.hpp"
+#include "lagraph/boruvka_lagraph.hpp"
+#include "native/boruvka_native.hpp"
+#include "native/prim_dense.hpp"
+#include "spla/boruvka_spla.hpp"
+#include "spla/prim_spla.hpp"
+
+namespace algos {
+    std::vector<Candidate<MstAlgorithm>> AutoMst::candidates() {
+        // Priors in ms over the terms 1, n, m, diameter, n * diameter, n^2, max degree, mean degree, m * degree skew
+        std::vector<Candidate<MstAlgorithm>> res;
+        res.push_back({"PrimSpla", 0, {1.0, 1e-3, 1e-5, 0, 0, 2e-8, 0, 0, 0},
+                       [](WeightType type) { return make_mst_algorithm<PrimSpla>(type); }});
+        res.push_back({"BoruvkaSpla", 0, {2.0, 2e-4, 4e-5, 0, 0, 0, 0, 0, 0},
+                       [](WeightType type) { return make_mst_algorithm<BoruvkaSpla>(type); }});
+        // Considered above the density threshold only, its adjacency matrix would not fit sparse graphs
+        res.push_back({"PrimDense", 0, {0.05, 0, 0, 0, 0, 1e-6, 0, 0, 0},
+                       [](WeightType type) { return make_mst_algorithm<PrimDense>(type); },
+                       [](const GraphFeatures &features) { return prefer_dense_mst(features.n, features.m); }});
+        for (const int threads: thread_counts()) {
+            res.push_back({"BoruvkaLagraph", threads, prior_with_threads({1.0, 1e-4, 2e-5, 0, 0, 0, 0, 0, 0}, threads),
+                           [](WeightType type) { return make_mst_algorithm<BoruvkaLagraph>(type); }});
+            res.push_back({"BoruvkaNative", threads, prior_with_threads({0.05, 2e-5, 1e-5, 0, 0, 0, 1e-6, 0, 0}, threads),
+                           [](WeightType type) { return make_mst_algorithm<BoruvkaNative>(type); }});
+        }
+        return res;
+    }
+}// namespace algos
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "autotune/auto_algorithm.hpp"
+#include "common/mst_algorithm.hpp"
+
+namespace algos {
+    // MST with the implementation and thread count picked per graph by the calibrated cost model
+    class AutoMst : public AutoAlgorithm<MstAlgorithm> {
+    public:
+        explicit AutoMst(CostModel model = CostModel::load(default_cost_model_path()))
+            : AutoAlgorithm(candidates(), true, std::move(model)) {}
+
+        static std::vector<Candidate<MstAlgorithm>> candidates();
+    };
+}// namespace algos
@@ -0,0 +1,20 @@
+#include "auto_parent_bfs.hpp"
+#include "lagraph/parent_bfs_lagraph.hpp"
+#include "native/parent_bfs_native.hpp"
+#include "spla/parent_bfs_spla.hpp"
+
+namespace algos {
+    std::vector<Candidate<ParentBfsAlgorithm>> AutoParentBfs::candidates() {
+        // Priors in ms over the terms 1, n, m, diameter, n * diameter, n^2, max degree, mean degree, m * degree skew
+        std::vector<Candidate<ParentBfsAlgorithm>> res;
+        res.push_back({"ParentBfsSpla", 0, {1.0, 1e-4, 1e-5, 0.1, 2e-6, 0, 0, 0, 0},
+                       [](WeightType) { return std::make_unique<ParentBfsSpla>(); }});
+        for (const int threads: thread_counts()) {
+            res.push_back({"ParentBfsLagraph", threads, prior_with_threads({0.5, 5e-5, 1e-5, 0.02, 0, 0, 0, 0, 0}, threads),
+                           [](WeightType) { return std::make_unique<ParentBfsLagraph>(); }});
+            res.push_back({"ParentBfsNative", threads, prior_with_threads({0.02, 5e-6, 3e-6, 0.005, 0, 0, 1e-7, 0, 0}, threads),
+                           [](WeightType) { return std::make_unique<ParentBfsNative>(); }});
+        }
+        return res;
+    }
+}// namespace algos
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "autotune/auto_algorithm.hpp"
+#include "common/parent_bfs_algorithm.hpp"
+
+namespace algos {
+    // Parent BFS with the implementation and thread count picked per graph by the calibrated cost model
+    class AutoParentBfs : public AutoAlgorithm<ParentBfsAlgorithm> {
+    public:
+        explicit AutoParentBfs(CostModel model = CostModel::load(default_cost_model_path()))
+            : AutoAlgorithm(candidates(), false, std::move(model)) {}
+
+        static std::vector<Candidate<ParentBfsAlgorithm>> candidates();
+
+    protected:
+        void prepare(ParentBfsAlgorithm &algo) override {
+            algo.set_root(root);
+            algo.seed_roots(seeds);
+        }
+
+        void loaded() override { seeds.clear(); }
+    };
+}// namespace algos
@@ -0,0 +1,148 @@
+#include "cost_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace algos {
+    namespace {
+        // Solves the ridge regularized normal equations over the active terms by Gaussian elimination
+        CostCoefficients least_squares(const std::vector<CostSample> &samples, const std::array<bool, COST_TERMS> &active) {
+            // Columns are scaled to unit maximum, raw terms differ by many orders of magnitude
+            std::array<double, COST_TERMS> scale{};
+            for (const auto &s: samples) {
+                const auto x = cost_terms(s.features);
+                for (size_t j = 0; j < COST_TERMS; ++j) {
+                    scale[j] = std::max(scale[j], x[j]);
+                }
+            }
+
+            std::vector<size_t> cols;
+            for (size_t j = 0; j < COST_TERMS; ++j) {
+                if (active[j] && scale[j] > 0) cols.push_back(j);
+            }
+            const size_t k = cols.size();
+            std::vector<std::vector<double>> a(k, std::vector<double>(k + 1, 0));
+            for (const auto &s: samples) {
+                const auto x = cost_terms(s.features);
+                for (size_t r = 0; r < k; ++r) {
+                    const double xr = x[cols[r]] / scale[cols[r]];
+                    for (size_t c = 0; c < k; ++c) {
+                        a[r][c] += xr * x[cols[c]] / scale[cols[c]];
+                    }
+                    a[r][k] += xr * s.milliseconds;
+                }
+            }
+            constexpr double RIDGE = 1e-6;
+            for (size_t r = 0; r < k; ++r) {
+                a[r][r] += RIDGE * samples.size();
+            }
+
+            for (size_t p = 0; p < k; ++p) {
+                size_t best = p;
+                for (size_t r = p + 1; r < k; ++r) {
+                    if (std::abs(a[r][p]) > std::abs(a[best][p])) best = r;
+                }
+                std::swap(a[p], a[best]);
+                for (size_t r = 0; r < k; ++r) {
+                    if (r == p || a[p][p] == 0) continue;
+                    const double factor = a[r][p] / a[p][p];
+                    for (size_t c = p; c <= k; ++c) {
+                        a[r][c] -= factor * a[p][c];
+                    }
+                }
+            }
+
+            CostCoefficients res{};
+            for (size_t r = 0; r < k; ++r) {
+                res[cols[r]] = a[r][r] == 0 ? 0 : a[r][k] / a[r][r] / scale[cols[r]];
+            }
+            return res;
+        }
+    }// namespace
+
+    std::array<double, COST_TERMS> cost_terms(const GraphFeatures &f) {
+        const auto n = static_cast<double>(f.n);
+        const auto d = static_cast<double>(f.diameter);
+        const auto m = static_cast<double>(f.m);
+        return {1.0, n, m, d, n * d, n * n, static_cast<double>(f.max_degree), f.mean_degree, m * f.degree_skew};
+    }
+
+    double predict_cost(const CostCoefficients &c, const GraphFeatures &f) {
+        const auto x = cost_terms(f);
+        double res = 0;
+        for (size_t j = 0; j < COST_TERMS; ++j) {
+            res += c[j] * x[j];
+        }
+        return std::max(0.0, res);
+    }
+
+    CostCoefficients fit_cost_model(const std::vector<CostSample> &samples) {
+        if (samples.empty()) {
+            throw std::runtime_error("Cost model needs at least one sample");
+        }
+        std::array<bool, COST_TERMS> active;
+        active.fill(true);
+        while (true) {
+            const CostCoefficients c = least_squares(samples, active);
+            const auto worst = std::ranges::min_element(c);
+            if (*worst >= 0) return c;
+            active[worst - c.begin()] = false;
+        }
+    }
+
+    CostModel CostModel::load(const std::filesystem::path &path) {
+        CostModel model;
+        std::ifstream input(path);
+        std::string line;
+        while (std::getline(input, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream iss(line);
+            std::string candidate;
+            CostCoefficients c{};
+            iss >> candidate;
+            // Models saved before the degree terms were added have fewer coefficients, the missing ones are 0
+            size_t read = 0;
+            while (read < COST_TERMS && iss >> c[read]) {
+                ++read;
+            }
+            if (candidate.empty() || read == 0 || !(iss.eof() || read == COST_TERMS)) {
+                throw std::runtime_error("Invalid cost model line: " + line);
+            }
+            model.set(candidate, c);
+        }
+        return model;
+    }
+
+    void CostModel::save(const std::filesystem::path &path) const {
+        std::ofstream output(path);
+        if (!output.is_open()) {
+            throw std::runtime_error("Failed to open output file: " + path.string());
+        }
+        output << "# candidate, ms per: 1 n m diameter n*diameter n^2 max_degree mean_degree m*degree_skew\n";
+        output.precision(10);
+        for (const auto &[candidate, c]: entries) {
+            output << candidate;
+            for (const double x: c) {
+                output << ' ' << x;
+            }
+            output << '\n';
+        }
+    }
+
+    std::optional<CostCoefficients> CostModel::get(const std::string &candidate) const {
+        const auto it = entries.find(candidate);
+        if (it == entries.end()) return std::nullopt;
+        return it->second;
+    }
+
+    std::filesystem::path default_cost_model_path() {
+        if (const char *env = std::getenv("ALGOS_COST_MODEL")) {
+            return env;
+        }
+        return "algos_cost_model.txt";
+    }
+}// namespace algos
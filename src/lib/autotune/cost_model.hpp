@@ -0,0 +1,54 @@
+#pragma once
+
+#include "common/graph_features.hpp"
+
+#include <array>
+#include <filesystem>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace algos {
+    // Terms of the linear cost model: 1, n, m, diameter, n * diameter, n^2, max degree, mean degree, m * degree skew.
+    // Level synchronous algorithms pay n * diameter for dense per-level vectors, dense Prim pays n^2, parallel
+    // algorithms pay m * degree skew for the threads left waiting on hubs
+    inline constexpr size_t COST_TERMS = 9;
+
+    using CostCoefficients = std::array<double, COST_TERMS>;
+
+    std::array<double, COST_TERMS> cost_terms(const GraphFeatures &f);
+
+    // Predicted time in milliseconds, never negative
+    double predict_cost(const CostCoefficients &c, const GraphFeatures &f);
+
+    struct CostSample {
+        GraphFeatures features;
+        double milliseconds = 0;
+    };
+
+    // Least squares fit with non-negative coefficients, terms with negative weights are dropped
+    // one at a time and the rest is refitted. Needs at least one sample
+    CostCoefficients fit_cost_model(const std::vector<CostSample> &samples);
+
+    // Calibrated coefficients per candidate, a candidate is an implementation with a thread count
+    class CostModel {
+    public:
+        // A missing file gives an empty model
+        static CostModel load(const std::filesystem::path &path);
+
+        void save(const std::filesystem::path &path) const;
+
+        void set(const std::string &candidate, const CostCoefficients &coefficients) { entries[candidate] = coefficients; }
+
+        [[nodiscard]] std::optional<CostCoefficients> get(const std::string &candidate) const;
+
+        [[nodiscard]] bool empty() const { return entries.empty(); }
+
+    private:
+        std::map<std::string, CostCoefficients> entries;
+    };
+
+    // ALGOS_COST_MODEL if set, algos_cost_model.txt in the working directory otherwise
+    std::filesystem::path default_cost_model_path();
+}// namespace algos
@@ -0,0 +1,39 @@
+#include "batch.hpp"
+#include "scheduler.hpp"
+
+#include <sched.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace algos {
+    unsigned available_cpus() {
+        cpu_set_t set;
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            return std::max(1, CPU_COUNT(&set));
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    void enter_batch_worker(unsigned worker, unsigned workers) {
+        limit_scheduler_threads(1);
+#ifdef _OPENMP
+        // nthreads-var is per thread, the other workers and the caller keep theirs
+        omp_set_num_threads(1);
+#endif
+        cpu_set_t allowed;
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return;
+        if (CPU_COUNT(&allowed) < static_cast<int>(workers)) return;
+
+        // worker-th allowed CPU
+        int cpu = 0;
+        for (unsigned seen = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed) && seen++ == worker) break;
+        }
+        cpu_set_t own;
+        CPU_ZERO(&own);
+        CPU_SET(cpu, &own);
+        sched_setaffinity(0, sizeof(own), &own);
+    }
+}// namespace algos
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "algorithm.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace algos {
+    struct BatchStats {
+        size_t graphs = 0;
+        size_t failed = 0;
+        unsigned workers = 0;
+        // wall time of the batch, loads included
+        double seconds = 0;
+        // sum of the compute times over all graphs and workers
+        double compute_seconds = 0;
+        std::string first_error;
+
+        [[nodiscard]] double graphs_per_second() const { return seconds > 0 ? graphs / seconds : 0; }
+    };
+
+    // Number of CPUs the process may run on
+    unsigned available_cpus();
+
+    // Called by every batch worker before its first graph: pins the thread to the worker-th CPU of the
+    // affinity mask, when there are enough of them, and runs its parallel loops and OpenMP regions with a single thread
+    void enter_batch_worker(unsigned worker, unsigned workers);
+
+    // Processes many small graphs concurrently, one graph per worker at a time. Each worker creates one
+    // algorithm and reuses it, with its scratch arrays, for all of its graphs, so that the fixed costs of
+    // a run are paid once per worker instead of once per graph. on_result(i, algo) is called on the worker
+    // right after graphs[i] is computed. A graph that throws is counted as failed and the batch goes on.
+    // The algorithm must keep no state shared between instances, the SPLA ones are run with one worker
+    template<typename Algo>
+    BatchStats run_batch(const std::vector<std::filesystem::path> &graphs, const std::function<std::unique_ptr<Algo>()> &create,
+                         const std::function<void(size_t, Algo &)> &on_result, unsigned workers = 0) {
+        if (workers == 0) workers = available_cpus();
+        workers = std::max(1u, std::min<unsigned>(workers, std::max<size_t>(graphs.size(), 1)));
+
+        BatchStats stats;
+        stats.graphs = graphs.size();
+        stats.workers = workers;
+        std::atomic<size_t> next = 0;
+        std::mutex mutex;
+
+        const auto work = [&](unsigned worker) {
+            enter_batch_worker(worker, workers);
+            std::unique_ptr<Algo> algo;
+            std::chrono::nanoseconds computing{0};
+            size_t failed = 0;
+            std::string error;
+            for (size_t i = next++; i < graphs.size(); i = next++) {
+                try {
+                    if (!algo) algo = create();
+                    algo->load_graph(graphs[i]);
+                    // compute() rounds to milliseconds, small graphs take microseconds
+                    const auto start = std::chrono::steady_clock::now();
+                    algo->compute();
+                    computing += std::chrono::steady_clock::now() - start;
+                    on_result(i, *algo);
+                } catch (const std::exception &e) {
+                    if (failed++ == 0) error = graphs[i].filename().string() + ": " + e.what();
+                    // the instance may be left half loaded
+                    algo.reset();
+                }
+            }
+            std::lock_guard lock(mutex);
+            stats.failed += failed;
+            stats.compute_seconds += std::chrono::duration<double>(computing).count();
+            if (stats.first_error.empty()) stats.first_error = error;
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        // the calling thread only waits, so its affinity and OpenMP threads stay untouched
+        for (unsigned w = 0; w < workers; ++w) {
+            threads.emplace_back(work, w);
+        }
+        for (auto &t: threads) {
+            t.join();
+        }
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+}// namespace algos
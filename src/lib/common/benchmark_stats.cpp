@@ -0,0 +1,141 @@
+#include "benchmark_stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace algos {
+    namespace {
+        double speedup_of(double baseline_median, double candidate_median) {
+            if (candidate_median == 0) {
+                return baseline_median == 0 ? 1 : std::numeric_limits<double>::infinity();
+            }
+            return baseline_median / candidate_median;
+        }
+
+        double percentile(std::vector<double> &sorted, double q) {
+            const double pos = q * static_cast<double>(sorted.size() - 1);
+            const auto i = static_cast<size_t>(pos);
+            if (i + 1 >= sorted.size()) return sorted.back();
+            return sorted[i] + (pos - static_cast<double>(i)) * (sorted[i + 1] - sorted[i]);
+        }
+    }// namespace
+
+    std::vector<BenchmarkSamples> read_benchmark_csv(const std::filesystem::path &path) {
+        std::ifstream input(path);
+        if (!input.is_open()) {
+            throw std::runtime_error("Failed to open benchmark results: " + path.string());
+        }
+        std::vector<BenchmarkSamples> res;
+        std::string line;
+        std::getline(input, line);// header
+        while (std::getline(input, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+            std::istringstream fields(line);
+            BenchmarkSamples samples;
+            std::getline(fields, samples.algorithm, ',');
+            std::getline(fields, samples.graph, ',');
+            std::string field;
+            while (std::getline(fields, field, ',')) {
+                try {
+                    samples.times.push_back(std::stod(field));
+                } catch (const std::logic_error &) {
+                    throw std::runtime_error("Invalid time '" + field + "' in " + path.string());
+                }
+            }
+            res.push_back(std::move(samples));
+        }
+        return res;
+    }
+
+    double median(std::vector<double> values) {
+        if (values.empty()) return 0;
+        const size_t mid = values.size() / 2;
+        std::ranges::nth_element(values, values.begin() + mid);
+        if (values.size() % 2 == 1) return values[mid];
+        const double upper = values[mid];
+        return (*std::max_element(values.begin(), values.begin() + mid) + upper) / 2;
+    }
+
+    double mann_whitney_p(const std::vector<double> &a, const std::vector<double> &b) {
+        const size_t n1 = a.size(), n2 = b.size(), total = n1 + n2;
+        if (n1 == 0 || n2 == 0) return 1;
+
+        // Ranks of the pooled samples, ties get the mean of their ranks
+        std::vector<std::pair<double, bool>> pooled;
+        pooled.reserve(total);
+        for (const double x: a) pooled.emplace_back(x, true);
+        for (const double x: b) pooled.emplace_back(x, false);
+        std::ranges::sort(pooled);
+        double rank_sum_a = 0, tie_term = 0;
+        for (size_t i = 0; i < total;) {
+            size_t j = i;
+            while (j < total && pooled[j].first == pooled[i].first) ++j;
+            const double rank = static_cast<double>(i + j + 1) / 2;
+            for (size_t k = i; k < j; ++k) {
+                if (pooled[k].second) rank_sum_a += rank;
+            }
+            const auto t = static_cast<double>(j - i);
+            tie_term += t * t * t - t;
+            i = j;
+        }
+
+        const double u = rank_sum_a - static_cast<double>(n1 * (n1 + 1)) / 2;
+        const double mean = static_cast<double>(n1 * n2) / 2;
+        const auto n = static_cast<double>(total);
+        const double variance = static_cast<double>(n1 * n2) / 12 * ((n + 1) - tie_term / (n * (n - 1)));
+        if (variance <= 0) return 1;
+        // continuity correction
+        const double z = std::max(0.0, std::abs(u - mean) - 0.5) / std::sqrt(variance);
+        return std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+    }
+
+    Interval bootstrap_speedup(const std::vector<double> &baseline, const std::vector<double> &candidate,
+                               double confidence, uint32_t resamples, uint64_t seed) {
+        if (baseline.empty() || candidate.empty() || resamples == 0) {
+            const double s = speedup_of(median(baseline), median(candidate));
+            return {s, s};
+        }
+        std::mt19937_64 rng(seed);
+        std::uniform_int_distribution<size_t> pick_base(0, baseline.size() - 1), pick_cand(0, candidate.size() - 1);
+        std::vector<double> base_sample(baseline.size()), cand_sample(candidate.size()), speedups(resamples);
+        for (auto &s: speedups) {
+            for (auto &x: base_sample) x = baseline[pick_base(rng)];
+            for (auto &x: cand_sample) x = candidate[pick_cand(rng)];
+            s = speedup_of(median(base_sample), median(cand_sample));
+        }
+        std::ranges::sort(speedups);
+        const double tail = (1 - confidence) / 2;
+        return {percentile(speedups, tail), percentile(speedups, 1 - tail)};
+    }
+
+    std::vector<Comparison> compare_benchmarks(const std::vector<BenchmarkSamples> &baseline,
+                                               const std::vector<BenchmarkSamples> &candidate,
+                                               const CompareOptions &options) {
+        std::map<std::pair<std::string, std::string>, const BenchmarkSamples *> by_key;
+        for (const auto &samples: candidate) {
+            by_key[{samples.algorithm, samples.graph}] = &samples;
+        }
+
+        std::vector<Comparison> res;
+        for (const auto &base: baseline) {
+            const auto it = by_key.find({base.algorithm, base.graph});
+            if (it == by_key.end()) continue;
+            const BenchmarkSamples &cand = *it->second;
+
+            Comparison cmp{base.algorithm, base.graph, speedup_of(median(base.times), median(cand.times)),
+                           bootstrap_speedup(base.times, cand.times, options.confidence, options.resamples),
+                           mann_whitney_p(base.times, cand.times), false};
+            // the point estimate, the interval and the rank test all have to agree on the slowdown
+            cmp.regression = cmp.p_value < options.alpha && cmp.speedup < 1 / (1 + options.threshold) && cmp.interval.high < 1;
+            res.push_back(std::move(cmp));
+        }
+        return res;
+    }
+}// namespace algos
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace algos {
+    // Measured times of one algorithm on one graph
+    struct BenchmarkSamples {
+        std::string algorithm;
+        std::string graph;
+        std::vector<double> times;
+    };
+
+    // Reads the files written by save_results_to_csv: a header line, then "algorithm,graph,t1,t2,..." rows
+    std::vector<BenchmarkSamples> read_benchmark_csv(const std::filesystem::path &path);
+
+    double median(std::vector<double> values);
+
+    // Two-sided p-value of the Mann–Whitney U test, normal approximation with tie correction
+    double mann_whitney_p(const std::vector<double> &a, const std::vector<double> &b);
+
+    struct Interval {
+        double low;
+        double high;
+    };
+
+    // Percentile bootstrap interval of median(baseline) / median(candidate), > 1 means the candidate is faster
+    Interval bootstrap_speedup(const std::vector<double> &baseline, const std::vector<double> &candidate,
+                               double confidence, uint32_t resamples, uint64_t seed = 1);
+
+    struct CompareOptions {
+        // slowdowns below this fraction are ignored even when significant
+        double threshold = 0.05;
+        // significance level of the Mann–Whitney test
+        double alpha = 0.01;
+        double confidence = 0.95;
+        uint32_t resamples = 2000;
+    };
+
+    struct Comparison {
+        std::string algorithm;
+        std::string graph;
+        double speedup;
+        Interval interval;
+        double p_value;
+        // significantly slower by more than the threshold
+        bool regression;
+    };
+
+    // Pairs (algorithm, graph) present in both sets, in the order of the baseline
+    std::vector<Comparison> compare_benchmarks(const std::vector<BenchmarkSamples> &baseline,
+                                               const std::vector<BenchmarkSamples> &candidate,
+                                               const CompareOptions &options);
+}// namespace algos
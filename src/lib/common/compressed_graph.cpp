@@ -0,0 +1,68 @@
+#include "compressed_graph.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace algos {
+    template<typename E>
+    CompressedGraph CompressedGraph::compress(const BasicCsrGraph<uint32_t, E> &g) {
+        CompressedGraph res;
+        res.n = g.n;
+        res.m = g.edges();
+        res.row_start.resize(g.n + 1);
+        // most gaps of real graphs take one or two bytes
+        res.data.reserve(g.n + static_cast<size_t>(g.edges()) * 2);
+
+        std::vector<uint32_t> row;
+        for (uint32_t v = 0; v < g.n; ++v) {
+            res.row_start[v] = res.data.size();
+            const auto neighbors = g.neighbors(v);
+            row.assign(neighbors.begin(), neighbors.end());
+            std::ranges::sort(row);
+
+            encode_varint(static_cast<uint32_t>(row.size()), res.data);
+            uint32_t prev = 0;
+            for (const uint32_t u: row) {
+                encode_varint(u - prev, res.data);
+                prev = u;
+            }
+        }
+        res.row_start[g.n] = res.data.size();
+        res.data.shrink_to_fit();
+        return res;
+    }
+
+    template CompressedGraph CompressedGraph::compress(const CsrGraph &g);
+    template CompressedGraph CompressedGraph::compress(const WideEdgeCsrGraph &g);
+
+    std::string to_string(GraphStorage storage) {
+        switch (storage) {
+            case GraphStorage::Csr:
+                return "csr";
+            case GraphStorage::Compressed:
+                return "compressed";
+            case GraphStorage::EdgeList:
+                return "edge-list";
+        }
+        return "unknown";
+    }
+
+    Adjacency load_adjacency(const std::filesystem::path &path, GraphStorage storage) {
+        if (storage == GraphStorage::EdgeList) {
+            throw std::invalid_argument("Edge list storage has no adjacency, it is supported by the MST algorithms only");
+        }
+        const IndexWidth width = detect_index_width(path);
+        if (width == IndexWidth::Wide) {
+            throw std::runtime_error("Native adjacency has 32-bit vertex ids, the graph needs " + to_string(width) + " indices");
+        }
+        if (width == IndexWidth::WideEdges) {
+            WideEdgeCsrGraph g = load_csr<uint32_t, uint64_t>(path);
+            if (storage == GraphStorage::Compressed) return CompressedGraph::compress(g);
+            return g;
+        }
+        if (storage == GraphStorage::Compressed) {
+            return CompressedGraph::compress(load_csr(path));
+        }
+        return load_csr(path);
+    }
+}// namespace algos
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "csr_graph.hpp"
+#include "numa_allocator.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace algos {
+    // Adjacency where every row is stored as its degree followed by the gaps between
+    // the sorted neighbours, all as LEB128 varints. row_start gives random access to rows
+    class CompressedGraph {
+    public:
+        // Rows are sorted while compressing, the source graph is left as is. Byte offsets are 64-bit,
+        // so graphs with 64-bit edge offsets compress as well
+        template<typename E>
+        static CompressedGraph compress(const BasicCsrGraph<uint32_t, E> &g);
+
+        [[nodiscard]] uint32_t vertices() const { return n; }
+
+        [[nodiscard]] uint64_t edges() const { return m; }
+
+        [[nodiscard]] uint32_t degree(uint32_t v) const {
+            const uint8_t *p = data.data() + row_start[v];
+            return decode_varint(p);
+        }
+
+        template<typename F>
+        void for_each_neighbor(uint32_t v, F &&f) const {
+            const uint8_t *p = data.data() + row_start[v];
+            const uint32_t deg = decode_varint(p);
+            uint32_t u = 0;
+            for (uint32_t i = 0; i < deg; ++i) {
+                u += decode_varint(p);
+                f(u);
+            }
+        }
+
+        [[nodiscard]] size_t memory_bytes() const {
+            return row_start.size() * sizeof(uint64_t) + data.size();
+        }
+
+        static uint32_t decode_varint(const uint8_t *&p) {
+            uint32_t x = *p & 0x7f;
+            if (*p++ < 0x80) return x;
+            for (uint32_t shift = 7;; shift += 7) {
+                x |= static_cast<uint32_t>(*p & 0x7f) << shift;
+                if (*p++ < 0x80) return x;
+            }
+        }
+
+        template<typename Bytes>
+        static void encode_varint(uint32_t x, Bytes &out) {
+            while (x >= 0x80) {
+                out.push_back(static_cast<uint8_t>(x | 0x80));
+                x >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(x));
+        }
+
+    private:
+        uint32_t n = 0;
+        uint64_t m = 0;
+        numa_vector<uint64_t> row_start;
+        numa_vector<uint8_t> data;
+    };
+
+    // Adjacency layout of the native algorithms, chosen when the graph is loaded. EdgeList keeps every
+    // undirected edge once and is supported by the MST algorithms only
+    enum class GraphStorage {
+        Csr,
+        Compressed,
+        EdgeList
+    };
+
+    std::string to_string(GraphStorage storage);
+
+    using Adjacency = std::variant<CsrGraph, WideEdgeCsrGraph, CompressedGraph>;
+
+    // CSR with 64-bit edge offsets when detect_index_width asks for them, throws for 64-bit vertex ids
+    Adjacency load_adjacency(const std::filesystem::path &path, GraphStorage storage);
+
+    inline size_t memory_bytes(const Adjacency &graph) {
+        return std::visit([](const auto &g) { return g.memory_bytes(); }, graph);
+    }
+}// namespace algos
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "algorithm.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace algos {
+    struct Components {
+        uint32_t n = 0;
+        // label[v] - smallest vertex of v's component
+        std::vector<uint32_t> label;
+        uint32_t count = 0;
+    };
+
+    // Relabels components given by any representative to their smallest vertex
+    inline Components make_components(std::vector<uint32_t> label) {
+        const auto n = static_cast<uint32_t>(label.size());
+        std::vector<uint32_t> smallest(n, UINT32_MAX);
+        Components res{n, std::move(label), 0};
+        for (uint32_t v = 0; v < n; ++v) {
+            uint32_t &s = smallest[res.label[v]];
+            if (s == UINT32_MAX) {
+                s = v;
+                res.count++;
+            }
+            res.label[v] = s;
+        }
+        return res;
+    }
+
+    // One root per component, e.g. the sources of a forest BFS
+    inline std::vector<uint32_t> component_roots(const Components &components) {
+        std::vector<uint32_t> roots;
+        roots.reserve(components.count);
+        for (uint32_t v = 0; v < components.n; ++v) {
+            if (components.label[v] == v) roots.push_back(v);
+        }
+        return roots;
+    }
+
+    class ConnectedComponentsAlgorithm : public Algorithm {
+    public:
+        virtual Components get_result() = 0;
+    };
+}// namespace algos
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "graph_cache.hpp"
+#include "graph_index.hpp"
+#include "mtx_reader.hpp"
+#include "numa_allocator.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace algos {
+    // Undirected graph in CSR form, every edge is stored in both directions, self loops are dropped.
+    // V is the type of the vertex ids, E the one of the edge offsets, see IndexWidth
+    template<typename V, typename E>
+    struct BasicCsrGraph {
+        using vertex_type = V;
+        using edge_type = E;
+
+        V n = 0;
+        // offsets[v] .. offsets[v + 1] - range of v's neighbours in cols, size n + 1
+        numa_vector<E> offsets;
+        numa_vector<V> cols;
+
+        [[nodiscard]] V vertices() const { return n; }
+
+        [[nodiscard]] E edges() const { return offsets.empty() ? 0 : offsets.back(); }
+
+        [[nodiscard]] E degree(V v) const { return offsets[v + 1] - offsets[v]; }
+
+        [[nodiscard]] std::span<const V> neighbors(V v) const {
+            return {cols.data() + offsets[v], cols.data() + offsets[v + 1]};
+        }
+
+        template<typename F>
+        void for_each_neighbor(V v, F &&f) const {
+            for (E e = offsets[v]; e < offsets[v + 1]; ++e) {
+                f(cols[e]);
+            }
+        }
+
+        [[nodiscard]] size_t memory_bytes() const {
+            return offsets.size() * sizeof(E) + cols.size() * sizeof(V);
+        }
+    };
+
+    using CsrGraph = BasicCsrGraph<uint32_t, uint32_t>;
+    using WideEdgeCsrGraph = BasicCsrGraph<uint32_t, uint64_t>;
+    using WideCsrGraph = BasicCsrGraph<uint64_t, uint64_t>;
+
+    template<typename G>
+    inline constexpr bool is_csr_graph_v = false;
+
+    template<typename V, typename E>
+    inline constexpr bool is_csr_graph_v<BasicCsrGraph<V, E>> = true;
+
+    template<typename W, typename V = uint32_t, typename E = uint32_t>
+    struct WeightedCsrGraph : BasicCsrGraph<V, E> {
+        // weights[e] - weight of the edge cols[e]
+        numa_vector<W> weights;
+    };
+
+    // Undirected graph with every edge stored once as src < dst, self loops are dropped. For the algorithms
+    // that visit each edge once instead of every row
+    template<typename W>
+    struct EdgeListGraph {
+        uint32_t n = 0;
+        numa_vector<uint32_t> src;
+        numa_vector<uint32_t> dst;
+        // weights[e] - weight of the edge (src[e], dst[e]), empty for NoWeight
+        numa_vector<W> weights;
+
+        [[nodiscard]] uint32_t vertices() const { return n; }
+
+        [[nodiscard]] size_t edges() const { return src.size(); }
+
+        [[nodiscard]] size_t memory_bytes() const {
+            return (src.size() + dst.size()) * sizeof(uint32_t) + weights.size() * sizeof(W);
+        }
+    };
+
+    namespace detail {
+        template<typename W, typename V = uint32_t>
+        struct CooEdges {
+            std::vector<V> src;
+            std::vector<V> dst;
+            std::vector<W> weights;
+        };
+
+        struct IgnoreWeight {
+            template<typename W>
+            void operator()(const W &) const {}
+        };
+
+        // Reads the entries of an undirected .mtx file into coo.src, coo.dst and coo.weights,
+        // weights are skipped for NoWeight. Both directions of every entry must fit into E. on_weight sees
+        // the weight of every entry, also of the self loops that are dropped
+        template<typename W, typename V, typename E, typename Edges, typename OnWeight = IgnoreWeight>
+        V read_mtx_coo(const std::filesystem::path &path, Edges &coo, OnWeight &&on_weight = {}) {
+            GraphInput input;
+            // 32-bit ids stay below 2^31 as index_width promises, 64-bit ones take any graph
+            const uint64_t max_vertices = sizeof(V) < sizeof(uint64_t) ? std::numeric_limits<int32_t>::max() : std::numeric_limits<V>::max();
+            const MtxHeader header = open_mtx_graph(path, input, max_vertices);
+            if (2 * static_cast<uint64_t>(header.nnz) > std::numeric_limits<E>::max()) {
+                throw std::runtime_error("Graph is too large for " + std::to_string(8 * sizeof(E)) + "-bit edge offsets");
+            }
+            coo.src.reserve(header.nnz);
+            coo.dst.reserve(header.nnz);
+            if constexpr (!std::is_same_v<W, NoWeight>) {
+                coo.weights.reserve(header.nnz);
+            }
+
+            for_each_mtx_entry<W, V>(input, header, [&coo, &on_weight](V u, V v, W w) {
+                on_weight(w);
+                if (u == v) return;
+                coo.src.push_back(u);
+                coo.dst.push_back(v);
+                if constexpr (!std::is_same_v<W, NoWeight>) {
+                    coo.weights.push_back(w);
+                }
+            });
+            return static_cast<V>(header.n_rows);
+        }
+
+        // Counting sort of the COO entries into rows, each entry is inserted in both directions
+        template<typename W, typename V, typename E, typename Edges>
+        void build_symmetric_csr(V n, const Edges &coo, BasicCsrGraph<V, E> &g, numa_vector<W> *weights) {
+            g.n = n;
+            g.offsets.assign(static_cast<size_t>(n) + 1, 0);
+            for (size_t i = 0; i < coo.src.size(); ++i) {
+                g.offsets[coo.src[i] + 1]++;
+                g.offsets[coo.dst[i] + 1]++;
+            }
+            for (V v = 0; v < n; ++v) {
+                g.offsets[v + 1] += g.offsets[v];
+            }
+            g.cols.resize(g.offsets[n]);
+            if (weights) weights->resize(g.offsets[n]);
+
+            std::vector<E> pos(g.offsets.begin(), g.offsets.end() - 1);
+            for (size_t i = 0; i < coo.src.size(); ++i) {
+                const V u = coo.src[i], v = coo.dst[i];
+                const E e_uv = pos[u]++, e_vu = pos[v]++;
+                g.cols[e_uv] = v;
+                g.cols[e_vu] = u;
+                if (weights) {
+                    (*weights)[e_uv] = coo.weights[i];
+                    (*weights)[e_vu] = coo.weights[i];
+                }
+            }
+        }
+    }// namespace detail
+
+    // Loads only the structure of the graph, edge values are skipped. Throws when the graph does not fit
+    // into the index types, detect_index_width tells which ones it needs
+    template<typename V = uint32_t, typename E = uint32_t>
+    BasicCsrGraph<V, E> load_csr(const std::filesystem::path &path) {
+        if (const auto cached = GraphCache::instance().find<BasicCsrGraph<V, E>>(path)) {
+            return *cached;
+        }
+        detail::CooEdges<NoWeight, V> coo;
+        const V n = detail::read_mtx_coo<NoWeight, V, E>(path, coo);
+        BasicCsrGraph<V, E> g;
+        detail::build_symmetric_csr<NoWeight>(n, coo, g, nullptr);
+        return g;
+    }
+
+    template<typename W, typename V = uint32_t, typename E = uint32_t>
+    WeightedCsrGraph<W, V, E> load_weighted_csr(const std::filesystem::path &path) {
+        if (const auto cached = GraphCache::instance().find<WeightedCsrGraph<W, V, E>>(path)) {
+            return *cached;
+        }
+        detail::CooEdges<W, V> coo;
+        const V n = detail::read_mtx_coo<W, V, E>(path, coo);
+        WeightedCsrGraph<W, V, E> g;
+        detail::build_symmetric_csr(n, coo, g, &g.weights);
+        return g;
+    }
+
+    template<typename W = NoWeight>
+    EdgeListGraph<W> load_edge_list(const std::filesystem::path &path) {
+        if (const auto cached = GraphCache::instance().find<EdgeListGraph<W>>(path)) {
+            return *cached;
+        }
+        EdgeListGraph<W> g;
+        g.n = detail::read_mtx_coo<W, uint32_t, uint32_t>(path, g);
+        for (size_t e = 0; e < g.src.size(); ++e) {
+            if (g.src[e] > g.dst[e]) std::swap(g.src[e], g.dst[e]);
+        }
+        return g;
+    }
+}// namespace algos
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace algos {
+    // Union-find with path halving and union by rank
+    class DisjointSet {
+    public:
+        explicit DisjointSet(uint32_t n = 0) { reset(n); }
+
+        void reset(uint32_t n) {
+            parent.resize(n);
+            std::iota(parent.begin(), parent.end(), 0);
+            rank.assign(n, 0);
+        }
+
+        uint32_t find(uint32_t v) {
+            while (parent[v] != v) {
+                parent[v] = parent[parent[v]];
+                v = parent[v];
+            }
+            return v;
+        }
+
+        // Returns false if u and v are already in the same set
+        bool unite(uint32_t u, uint32_t v) {
+            u = find(u);
+            v = find(v);
+            if (u == v) return false;
+            if (rank[u] < rank[v]) std::swap(u, v);
+            parent[v] = u;
+            if (rank[u] == rank[v]) rank[u]++;
+            return true;
+        }
+
+        [[nodiscard]] uint32_t size() const { return static_cast<uint32_t>(parent.size()); }
+
+    private:
+        std::vector<uint32_t> parent;
+        std::vector<uint8_t> rank;
+    };
+}// namespace algos
@@ -0,0 +1,157 @@
+#include "graph500.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace algos {
+    namespace {
+        double quantile(const std::vector<double> &sorted, double q) {
+            const double pos = q * static_cast<double>(sorted.size() - 1);
+            const auto i = static_cast<size_t>(pos);
+            if (i + 1 >= sorted.size()) return sorted.back();
+            return sorted[i] + (pos - static_cast<double>(i)) * (sorted[i + 1] - sorted[i]);
+        }
+
+        void fail(uint32_t root, const std::string &reason) {
+            throw std::runtime_error("BFS tree from " + std::to_string(root) + " is invalid: " + reason);
+        }
+    }// namespace
+
+    EdgeList kronecker_graph(uint32_t scale, uint32_t edge_factor, uint64_t seed) {
+        if (scale == 0 || scale > 31) {
+            throw std::runtime_error("Kronecker scale must be in 1..31");
+        }
+        constexpr double A = 0.57, B = 0.19, C = 0.19;
+        const double ab = A + B, c_norm = C / (1 - ab), a_norm = A / ab;
+
+        EdgeList res;
+        res.n = uint32_t{1} << scale;
+        const uint64_t m = uint64_t{edge_factor} << scale;
+        res.edges.resize(m);
+
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> uniform(0, 1);
+        // Every level of the recursion picks one of the four quadrants of the adjacency matrix
+        for (auto &[u, v]: res.edges) {
+            u = v = 0;
+            for (uint32_t bit = 0; bit < scale; ++bit) {
+                const bool u_bit = uniform(rng) > ab;
+                const bool v_bit = uniform(rng) > (u_bit ? c_norm : a_norm);
+                u |= static_cast<uint32_t>(u_bit) << bit;
+                v |= static_cast<uint32_t>(v_bit) << bit;
+            }
+        }
+
+        std::vector<uint32_t> label(res.n);
+        std::iota(label.begin(), label.end(), 0);
+        std::ranges::shuffle(label, rng);
+        for (auto &[u, v]: res.edges) {
+            u = label[u];
+            v = label[v];
+        }
+        std::ranges::shuffle(res.edges, rng);
+        return res;
+    }
+
+    void write_mtx(const std::filesystem::path &path, const EdgeList &graph) {
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            throw std::runtime_error("Failed to open file: " + path.string());
+        }
+        out << "%%MatrixMarket matrix coordinate pattern symmetric\n";
+        out << graph.n << " " << graph.n << " " << graph.edges.size() << "\n";
+        for (const auto &[u, v]: graph.edges) {
+            out << u + 1 << " " << v + 1 << "\n";
+        }
+    }
+
+    template<typename E>
+    std::vector<uint32_t> sample_roots(const BasicCsrGraph<uint32_t, E> &g, uint32_t count, uint64_t seed) {
+        std::vector<uint32_t> candidates;
+        for (uint32_t v = 0; v < g.n; ++v) {
+            if (g.degree(v) > 0) candidates.push_back(v);
+        }
+        std::mt19937_64 rng(seed);
+        std::ranges::shuffle(candidates, rng);
+        candidates.resize(std::min<size_t>(candidates.size(), count));
+        return candidates;
+    }
+
+    template<typename E>
+    uint64_t validate_bfs_tree(const BasicCsrGraph<uint32_t, E> &g, uint32_t root, const std::vector<int64_t> &parent) {
+        constexpr uint32_t NO_LEVEL = UINT32_MAX;
+        if (parent.size() != g.n) fail(root, "wrong size");
+        if (parent[root] != -1) fail(root, "the root has a parent");
+
+        // Levels along the parent chains, a chain longer than n is a cycle
+        std::vector<uint32_t> level(g.n, NO_LEVEL);
+        level[root] = 0;
+        std::vector<uint32_t> chain;
+        for (uint32_t v = 0; v < g.n; ++v) {
+            if (level[v] != NO_LEVEL || parent[v] == -1) continue;
+            chain.clear();
+            uint32_t u = v;
+            while (level[u] == NO_LEVEL) {
+                if (parent[u] < 0 || static_cast<uint32_t>(parent[u]) >= g.n) fail(root, "parent out of range");
+                if (chain.size() > g.n) fail(root, "the parents form a cycle");
+                chain.push_back(u);
+                u = static_cast<uint32_t>(parent[u]);
+            }
+            for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+                level[*it] = level[u] + 1;
+                u = *it;
+            }
+        }
+
+        uint64_t component_degrees = 0;
+        for (uint32_t v = 0; v < g.n; ++v) {
+            const auto neighbors = g.neighbors(v);
+            if (level[v] == NO_LEVEL) {
+                if (parent[v] != -1) fail(root, "vertex " + std::to_string(v) + " has a parent but no path to the root");
+                continue;
+            }
+            component_degrees += neighbors.size();
+            if (v != root && std::ranges::find(neighbors, static_cast<uint32_t>(parent[v])) == neighbors.end()) {
+                fail(root, "tree edge " + std::to_string(v) + "-" + std::to_string(parent[v]) + " is not in the graph");
+            }
+            for (const uint32_t u: neighbors) {
+                if (level[u] == NO_LEVEL) fail(root, "vertex " + std::to_string(u) + " of the component is not reached");
+                if (level[u] + 1 < level[v] || level[v] + 1 < level[u]) {
+                    fail(root, "edge " + std::to_string(v) + "-" + std::to_string(u) + " skips a level");
+                }
+            }
+        }
+        return component_degrees / 2;
+    }
+
+    template std::vector<uint32_t> sample_roots(const CsrGraph &g, uint32_t count, uint64_t seed);
+    template std::vector<uint32_t> sample_roots(const WideEdgeCsrGraph &g, uint32_t count, uint64_t seed);
+    template uint64_t validate_bfs_tree(const CsrGraph &g, uint32_t root, const std::vector<int64_t> &parent);
+    template uint64_t validate_bfs_tree(const WideEdgeCsrGraph &g, uint32_t root, const std::vector<int64_t> &parent);
+
+    TepsStatistics teps_statistics(std::vector<double> teps) {
+        if (teps.empty()) {
+            throw std::runtime_error("No TEPS samples");
+        }
+        std::ranges::sort(teps);
+        const auto k = static_cast<double>(teps.size());
+        double inverse_sum = 0;
+        for (const double x: teps) {
+            inverse_sum += 1 / x;
+        }
+        const double harmonic_mean = k / inverse_sum;
+        // standard deviation of the harmonic mean as computed by the reference implementation
+        double deviation = 0;
+        for (const double x: teps) {
+            deviation += (1 / x - 1 / harmonic_mean) * (1 / x - 1 / harmonic_mean);
+        }
+        const double harmonic_stddev = teps.size() > 1 ? std::sqrt(deviation) / (k - 1) * harmonic_mean * harmonic_mean : 0;
+        return {teps.front(), quantile(teps, 0.25), quantile(teps, 0.5), quantile(teps, 0.75), teps.back(),
+                harmonic_mean, harmonic_stddev};
+    }
+}// namespace algos
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "csr_graph.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+namespace algos {
+    struct EdgeList {
+        uint32_t n = 0;
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+    };
+
+    // Kronecker graph of the Graph500 specification: 2^scale vertices, edge_factor * 2^scale edges drawn with
+    // the initiator (0.57, 0.19, 0.19, 0.05), vertex labels and edge order randomly permuted. Self loops and
+    // repeated edges are kept, as in the reference generator
+    EdgeList kronecker_graph(uint32_t scale, uint32_t edge_factor = 16, uint64_t seed = 1);
+
+    // Pattern .mtx with 1-based ids that every loader of the repo reads
+    void write_mtx(const std::filesystem::path &path, const EdgeList &graph);
+
+    // Distinct random vertices with at least one neighbour, fewer if the graph has fewer such vertices.
+    // Instantiated for CsrGraph and WideEdgeCsrGraph, the latter holds graphs up to scale 31
+    template<typename E>
+    std::vector<uint32_t> sample_roots(const BasicCsrGraph<uint32_t, E> &g, uint32_t count, uint64_t seed = 2);
+
+    // Checks a single-source BFS tree (parent[root] = -1, -1 for unreached vertices) as the Graph500
+    // validation does: the parents form a tree rooted at root with edges of the graph, tree edges join
+    // adjacent levels, graph edges join levels at most one apart and the tree spans the whole component.
+    // Throws on failure, returns the number of edges in the component which TEPS is counted over
+    template<typename E>
+    uint64_t validate_bfs_tree(const BasicCsrGraph<uint32_t, E> &g, uint32_t root, const std::vector<int64_t> &parent);
+
+    // Statistics of the Graph500 output over the runs of all roots
+    struct TepsStatistics {
+        double min;
+        double first_quartile;
+        double median;
+        double third_quartile;
+        double max;
+        double harmonic_mean;
+        double harmonic_stddev;
+    };
+
+    TepsStatistics teps_statistics(std::vector<double> teps);
+}// namespace algos
@@ -0,0 +1,36 @@
+#include "graph_cache.hpp"
+
+#include <algorithm>
+
+#include <pthread.h>
+
+namespace algos {
+    GraphCache &GraphCache::instance() {
+        static GraphCache cache;
+        // The prefetcher may hold the lock while a run is forked, the child would never see it released
+        static const int fork_handler = pthread_atfork([] { cache.mutex.lock(); }, [] { cache.mutex.unlock(); },
+                                                       [] { cache.mutex.unlock(); });
+        (void) fork_handler;
+        return cache;
+    }
+
+    void GraphCache::erase(const std::filesystem::path &path) {
+        std::lock_guard lock(mutex);
+        std::erase_if(entries, [&](const Entry &entry) {
+            if (entry.path != path.string()) return false;
+            total_bytes -= entry.bytes;
+            return true;
+        });
+    }
+
+    void GraphCache::clear() {
+        std::lock_guard lock(mutex);
+        entries.clear();
+        total_bytes = 0;
+    }
+
+    size_t GraphCache::bytes() const {
+        std::lock_guard lock(mutex);
+        return total_bytes;
+    }
+}// namespace algos
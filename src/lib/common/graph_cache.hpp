@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace algos {
+    // Parsed graphs shared between the loads of the same file, keyed by path and type. Filled ahead of time by
+    // GraphPrefetcher, load_csr, load_weighted_csr and detect_weight_type return a copy of a cached entry.
+    // Empty unless a prefetcher runs, so the loaders behave as before
+    class GraphCache {
+    public:
+        static GraphCache &instance();
+
+        template<typename G>
+        std::shared_ptr<const G> find(const std::filesystem::path &path) const {
+            std::lock_guard lock(mutex);
+            for (const auto &entry: entries) {
+                if (entry.type == typeid(G) && entry.path == path.string()) {
+                    return std::static_pointer_cast<const G>(entry.value);
+                }
+            }
+            return nullptr;
+        }
+
+        template<typename G>
+        void insert(const std::filesystem::path &path, std::shared_ptr<const G> value, size_t bytes) {
+            std::lock_guard lock(mutex);
+            entries.push_back({path.string(), typeid(G), std::move(value), bytes});
+            total_bytes += bytes;
+        }
+
+        // Drops every entry of the file
+        void erase(const std::filesystem::path &path);
+
+        // Drops the entry of the file with the type
+        template<typename G>
+        void erase(const std::filesystem::path &path) {
+            std::lock_guard lock(mutex);
+            std::erase_if(entries, [&](const Entry &entry) {
+                if (entry.type != typeid(G) || entry.path != path.string()) return false;
+                total_bytes -= entry.bytes;
+                return true;
+            });
+        }
+
+        void clear();
+
+        [[nodiscard]] size_t bytes() const;
+
+    private:
+        struct Entry {
+            std::string path;
+            std::type_index type;
+            std::shared_ptr<const void> value;
+            size_t bytes;
+        };
+
+        mutable std::mutex mutex;
+        std::vector<Entry> entries;
+        size_t total_bytes = 0;
+    };
+}// namespace algos
@@ -0,0 +1,64 @@
+#include "graph_features.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace algos {
+    namespace {
+        // Returns the farthest vertex from source and its distance
+        std::pair<uint32_t, uint32_t> farthest_vertex(const CsrGraph &g, uint32_t source, std::vector<uint32_t> &dist) {
+            constexpr uint32_t UNREACHED = UINT32_MAX;
+            dist.assign(g.n, UNREACHED);
+            std::vector<uint32_t> queue = {source};
+            dist[source] = 0;
+            uint32_t last = source;
+            for (size_t head = 0; head < queue.size(); ++head) {
+                const uint32_t u = queue[head];
+                last = u;
+                for (const uint32_t v: g.neighbors(u)) {
+                    if (dist[v] == UNREACHED) {
+                        dist[v] = dist[u] + 1;
+                        queue.push_back(v);
+                    }
+                }
+            }
+            return {last, dist[last]};
+        }
+    }// namespace
+
+    GraphFeatures compute_graph_features(const CsrGraph &g, uint32_t samples) {
+        GraphFeatures f;
+        f.n = g.n;
+        f.m = g.edges();
+        f.mean_degree = g.n == 0 ? 0 : static_cast<double>(f.m) / g.n;
+        double squares = 0;
+        for (uint32_t v = 0; v < g.n; ++v) {
+            const uint32_t degree = g.degree(v);
+            f.max_degree = std::max(f.max_degree, degree);
+            f.degree_histogram[std::bit_width(degree)]++;
+            squares += static_cast<double>(degree) * degree;
+        }
+        if (f.mean_degree > 0) {
+            const double variance = squares / g.n - f.mean_degree * f.mean_degree;
+            f.degree_skew = std::sqrt(std::max(0.0, variance)) / f.mean_degree;
+        }
+
+        // Double sweep from random vertices with edges: BFS to the farthest vertex, then BFS from it
+        if (f.m == 0) return f;
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<uint32_t> pick(0, g.n - 1);
+        std::vector<uint32_t> dist;
+        for (uint32_t i = 0; i < samples; ++i) {
+            uint32_t start = pick(rng);
+            while (g.degree(start) == 0) {
+                start = pick(rng);
+            }
+            const uint32_t far = farthest_vertex(g, start, dist).first;
+            f.diameter = std::max(f.diameter, farthest_vertex(g, far, dist).second);
+        }
+        return f;
+    }
+}// namespace algos
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "csr_graph.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace algos {
+    // Cheap structural statistics of a graph, inputs of the algorithm cost models
+    struct GraphFeatures {
+        uint32_t n = 0;
+        // stored edges, every undirected edge counts twice
+        uint64_t m = 0;
+        uint32_t max_degree = 0;
+        double mean_degree = 0;
+        // degree_histogram[0] - isolated vertices, degree_histogram[k] - vertices with degree in [2^(k-1), 2^k)
+        std::array<uint32_t, 33> degree_histogram{};
+        // standard deviation of the degrees over their mean, 0 on regular graphs, large on the power-law
+        // ones where a few hubs unbalance the threads
+        double degree_skew = 0;
+        // lower bound of the diameter of the largest explored component, from double-sweep BFS
+        uint32_t diameter = 0;
+    };
+
+    // Takes O(n + m) for the degrees and O(samples * (n + m)) for the diameter estimate
+    GraphFeatures compute_graph_features(const CsrGraph &g, uint32_t samples = 4);
+}// namespace algos
@@ -0,0 +1,46 @@
+#include "graph_index.hpp"
+#include "mtx_reader.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace algos {
+    std::string to_string(IndexWidth width) {
+        switch (width) {
+            case IndexWidth::Narrow:
+                return "narrow";
+            case IndexWidth::WideEdges:
+                return "wide-edges";
+            case IndexWidth::Wide:
+                return "wide";
+        }
+        return "unknown";
+    }
+
+    IndexWidth parse_index_width(std::string_view text) {
+        if (text == "narrow") return IndexWidth::Narrow;
+        if (text == "wide-edges") return IndexWidth::WideEdges;
+        if (text == "wide") return IndexWidth::Wide;
+        throw std::runtime_error("Unknown index width: " + std::string(text));
+    }
+
+    IndexWidth index_width(uint64_t vertices, uint64_t directed_edges) {
+        if (vertices > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) return IndexWidth::Wide;
+        if (directed_edges > std::numeric_limits<uint32_t>::max()) return IndexWidth::WideEdges;
+        return IndexWidth::Narrow;
+    }
+
+    IndexWidth detect_index_width(const std::filesystem::path &path) {
+        GraphInput input(path);
+        if (!input.is_open()) {
+            throw std::runtime_error("Failed to open file: " + path.string());
+        }
+        const MtxHeader header = read_mtx_header(input);
+        const IndexWidth width = index_width(static_cast<uint64_t>(header.n_rows), 2 * static_cast<uint64_t>(header.nnz));
+        if (const char *env = std::getenv("ALGOS_INDEX_WIDTH")) {
+            return std::max(width, parse_index_width(env));
+        }
+        return width;
+    }
+}// namespace algos
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace algos {
+    // Widths of the vertex ids and edge offsets of a loaded graph. 32-bit indices halve the bandwidth of the
+    // traversals, so they are used unless the graph does not fit into them
+    enum class IndexWidth {
+        // 32-bit vertex ids and edge offsets
+        Narrow,
+        // 32-bit vertex ids, 64-bit edge offsets
+        WideEdges,
+        // 64-bit vertex ids and edge offsets
+        Wide
+    };
+
+    std::string to_string(IndexWidth width);
+
+    // "narrow", "wide-edges" or "wide"
+    IndexWidth parse_index_width(std::string_view text);
+
+    // Narrowest width for n vertices and the given number of directed edges. Vertex ids stay 32-bit up to
+    // 2^31 - 1 vertices, so that every id also fits the int parents of the 32-bit algorithms, edge offsets
+    // up to 2^32 - 1 edges
+    IndexWidth index_width(uint64_t vertices, uint64_t directed_edges);
+
+    // Width of the .mtx file from its header, every entry stored in both directions. ALGOS_INDEX_WIDTH sets
+    // the narrowest width to use, e.g. to run the 64-bit paths on small graphs
+    IndexWidth detect_index_width(const std::filesystem::path &path);
+
+    // Calls f.template operator()<V, E>() with the vertex and edge index types of the width
+    template<typename F>
+    decltype(auto) visit_index_width(IndexWidth width, F &&f) {
+        switch (width) {
+            case IndexWidth::Narrow:
+                return f.template operator()<uint32_t, uint32_t>();
+            case IndexWidth::WideEdges:
+                return f.template operator()<uint32_t, uint64_t>();
+            case IndexWidth::Wide:
+                return f.template operator()<uint64_t, uint64_t>();
+        }
+        throw std::invalid_argument("Unknown index width");
+    }
+}// namespace algos
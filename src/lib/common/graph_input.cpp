@@ -0,0 +1,287 @@
+#include "graph_input.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(ALGOS_WITH_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(ALGOS_WITH_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace algos {
+    namespace {
+        // Decoded blocks, one is parsed while the others are filled
+        constexpr size_t BLOCK_SIZE = size_t{4} << 20;
+        constexpr size_t BLOCK_COUNT = 3;
+
+        class Decoder {
+        public:
+            virtual ~Decoder() = default;
+
+            // Fills out with up to size bytes, less only at the end of the input
+            virtual size_t read(char *out, size_t size) = 0;
+        };
+
+#if defined(ALGOS_WITH_ZLIB)
+        // gzread also handles concatenated gzip members
+        class GzipDecoder : public Decoder {
+        public:
+            explicit GzipDecoder(const std::filesystem::path &path) : file(gzopen(path.c_str(), "rb")) {
+                if (!file) {
+                    throw std::runtime_error("Failed to open file: " + path.string());
+                }
+                gzbuffer(file, 1 << 17);
+            }
+
+            ~GzipDecoder() override { gzclose(file); }
+
+            size_t read(char *out, size_t size) override {
+                size_t done = 0;
+                while (done < size) {
+                    const int count = gzread(file, out + done, static_cast<unsigned>(size - done));
+                    if (count <= 0) {
+                        int error = Z_OK;
+                        const char *message = gzerror(file, &error);
+                        if (count < 0 || error != Z_OK) {
+                            throw std::runtime_error(std::string("Corrupted gzip input: ") + message);
+                        }
+                        break;
+                    }
+                    done += count;
+                }
+                return done;
+            }
+
+        private:
+            gzFile file;
+        };
+#endif
+
+#if defined(ALGOS_WITH_ZSTD)
+        class ZstdDecoder : public Decoder {
+        public:
+            explicit ZstdDecoder(const std::filesystem::path &path)
+                : file(std::fopen(path.c_str(), "rb")), context(ZSTD_createDCtx()), in(ZSTD_DStreamInSize()) {
+                if (!file) {
+                    ZSTD_freeDCtx(context);
+                    throw std::runtime_error("Failed to open file: " + path.string());
+                }
+            }
+
+            ~ZstdDecoder() override {
+                ZSTD_freeDCtx(context);
+                std::fclose(file);
+            }
+
+            size_t read(char *out, size_t size) override {
+                ZSTD_outBuffer output{out, size, 0};
+                while (output.pos < output.size) {
+                    if (input.pos == input.size && !eof) {
+                        input = {in.data(), std::fread(in.data(), 1, in.size(), file), 0};
+                        eof = input.size == 0;
+                    }
+                    const size_t before = output.pos;
+                    const size_t status = ZSTD_decompressStream(context, &output, &input);
+                    if (ZSTD_isError(status)) {
+                        throw std::runtime_error(std::string("Corrupted zstd input: ") + ZSTD_getErrorName(status));
+                    }
+                    frame_open = status != 0;
+                    if (eof && output.pos == before) {
+                        if (frame_open) {
+                            throw std::runtime_error("Corrupted zstd input: truncated frame");
+                        }
+                        break;
+                    }
+                }
+                return output.pos;
+            }
+
+        private:
+            std::FILE *file;
+            ZSTD_DCtx *context;
+            std::vector<char> in;
+            ZSTD_inBuffer input{nullptr, 0, 0};
+            bool eof = false;
+            bool frame_open = false;
+        };
+#endif
+
+        // Streambuf over blocks produced by a decoder thread. The thread waits for a free block, fills it and
+        // hands it over; underflow returns the parsed block and takes the next one
+        class PipelinedBuffer : public std::streambuf {
+        public:
+            explicit PipelinedBuffer(std::unique_ptr<Decoder> decoder) : decoder(std::move(decoder)) {
+                for (size_t i = 0; i < BLOCK_COUNT; ++i) {
+                    blocks[i].resize(BLOCK_SIZE);
+                    free.push_back(i);
+                }
+                worker = std::thread([this] { decode(); });
+            }
+
+            ~PipelinedBuffer() override {
+                {
+                    std::lock_guard lock(mutex);
+                    stopped = true;
+                }
+                changed.notify_all();
+                worker.join();
+            }
+
+        protected:
+            int_type underflow() override {
+                std::unique_lock lock(mutex);
+                if (current != NONE) {
+                    free.push_back(current);
+                    current = NONE;
+                    changed.notify_all();
+                }
+                changed.wait(lock, [this] { return !ready.empty() || finished; });
+                if (ready.empty()) {
+                    if (error) std::rethrow_exception(error);
+                    return traits_type::eof();
+                }
+                const auto [block, size] = ready.front();
+                ready.pop_front();
+                current = block;
+                setg(blocks[block].data(), blocks[block].data(), blocks[block].data() + size);
+                return traits_type::to_int_type(*gptr());
+            }
+
+        private:
+            static constexpr size_t NONE = BLOCK_COUNT;
+
+            void decode() {
+                try {
+                    while (true) {
+                        size_t block;
+                        {
+                            std::unique_lock lock(mutex);
+                            changed.wait(lock, [this] { return !free.empty() || stopped; });
+                            if (stopped) return;
+                            block = free.front();
+                            free.pop_front();
+                        }
+                        const size_t size = decoder->read(blocks[block].data(), BLOCK_SIZE);
+                        std::lock_guard lock(mutex);
+                        if (size > 0) {
+                            ready.emplace_back(block, size);
+                        }
+                        if (size < BLOCK_SIZE) {
+                            finished = true;
+                            changed.notify_all();
+                            return;
+                        }
+                        changed.notify_all();
+                    }
+                } catch (...) {
+                    std::lock_guard lock(mutex);
+                    error = std::current_exception();
+                    finished = true;
+                    changed.notify_all();
+                }
+            }
+
+            std::unique_ptr<Decoder> decoder;
+            std::array<std::vector<char>, BLOCK_COUNT> blocks;
+            std::mutex mutex;
+            std::condition_variable changed;
+            std::deque<size_t> free;
+            std::deque<std::pair<size_t, size_t>> ready;
+            size_t current = NONE;
+            bool finished = false;
+            bool stopped = false;
+            std::exception_ptr error;
+            std::thread worker;
+        };
+
+        // Buffer of a stream that is not open, every read ends immediately
+        class ClosedBuffer : public std::streambuf {};
+
+        std::unique_ptr<Decoder> make_decoder(const std::filesystem::path &path, Compression compression) {
+            switch (compression) {
+                case Compression::Gzip:
+#if defined(ALGOS_WITH_ZLIB)
+                    return std::make_unique<GzipDecoder>(path);
+#else
+                    throw std::runtime_error("Built without zlib, cannot read " + path.string());
+#endif
+                case Compression::Zstd:
+#if defined(ALGOS_WITH_ZSTD)
+                    return std::make_unique<ZstdDecoder>(path);
+#else
+                    throw std::runtime_error("Built without zstd, cannot read " + path.string());
+#endif
+                default:
+                    return nullptr;
+            }
+        }
+    }// namespace
+
+    Compression detect_compression(const std::filesystem::path &path) {
+        std::ifstream file(path, std::ios::binary);
+        unsigned char magic[4] = {};
+        file.read(reinterpret_cast<char *>(magic), sizeof(magic));
+        if (file.gcount() >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+            return Compression::Gzip;
+        }
+        if (file.gcount() == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+            return Compression::Zstd;
+        }
+        return Compression::None;
+    }
+
+    bool is_graph_file(const std::filesystem::path &path) {
+        const auto extension = path.extension();
+        if (extension == ".gz" || extension == ".zst") {
+            return path.stem().extension() == ".mtx";
+        }
+        return extension == ".mtx";
+    }
+
+    GraphInput::GraphInput() : std::istream(nullptr), buffer(std::make_unique<ClosedBuffer>()) {
+        rdbuf(buffer.get());
+        // lets the errors of the decoder thread propagate instead of only setting badbit
+        exceptions(std::ios::badbit);
+    }
+
+    GraphInput::GraphInput(const std::filesystem::path &path) : GraphInput() {
+        open(path);
+    }
+
+    GraphInput::~GraphInput() = default;
+
+    void GraphInput::open(const std::filesystem::path &path) {
+        std::unique_ptr<std::streambuf> next;
+        const Compression compression = detect_compression(path);
+        if (compression != Compression::None) {
+            next = std::make_unique<PipelinedBuffer>(make_decoder(path, compression));
+        } else {
+            auto file = std::make_unique<std::filebuf>();
+            if (file->open(path, std::ios::in)) {
+                next = std::move(file);
+            }
+        }
+
+        opened = next != nullptr;
+        if (!opened) {
+            next = std::make_unique<ClosedBuffer>();
+        }
+        // rdbuf clears the state of the previous file
+        rdbuf(next.get());
+        buffer = std::move(next);
+        if (!opened) {
+            setstate(std::ios::failbit);
+        }
+    }
+}// namespace algos
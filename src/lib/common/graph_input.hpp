@@ -0,0 +1,41 @@
+#pragma once
+
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <streambuf>
+
+namespace algos {
+    enum class Compression {
+        None,
+        Gzip,
+        Zstd
+    };
+
+    // Detected by the magic bytes of the file, not by its extension
+    Compression detect_compression(const std::filesystem::path &path);
+
+    // .mtx, .mtx.gz and .mtx.zst files
+    bool is_graph_file(const std::filesystem::path &path);
+
+    // Input stream of a graph file, used by every loader in place of std::ifstream. Plain files are read
+    // directly, gzip and zstd files are decompressed by a background thread into a few large blocks that the
+    // parser consumes while the next ones are decoded, so nothing is unpacked to disk. Decompression errors
+    // are rethrown from the reading call
+    class GraphInput : public std::istream {
+    public:
+        GraphInput();
+
+        explicit GraphInput(const std::filesystem::path &path);
+
+        ~GraphInput() override;
+
+        void open(const std::filesystem::path &path);
+
+        [[nodiscard]] bool is_open() const { return opened; }
+
+    private:
+        std::unique_ptr<std::streambuf> buffer;
+        bool opened = false;
+    };
+}// namespace algos
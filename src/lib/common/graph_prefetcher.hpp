@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sched.h>
+
+namespace algos {
+    // Loads the graphs of a benchmark sweep one ahead on a background thread: while graph i is measured, the
+    // file of graph i + 1 is read into the page cache and the loader builds its parsed forms into GraphCache.
+    // Measurements are kept apart in two ways. The worker is pinned to its own CPU and the calling thread and
+    // the OpenMP team to the remaining ones, and between pause and resume no read chunk or build starts.
+    // On a single CPU there is nothing to overlap with, so the prefetcher stays disabled
+    class GraphPrefetcher {
+    public:
+        // Inserts the parsed forms of the graph into GraphCache
+        using Loader = std::function<void(const std::filesystem::path &)>;
+
+        // A graph is built only when the cache and its estimated load fit into budget_bytes,
+        // otherwise only its file is read ahead
+        GraphPrefetcher(std::vector<std::filesystem::path> graphs, Loader loader, size_t budget_bytes);
+
+        GraphPrefetcher(const GraphPrefetcher &) = delete;
+
+        GraphPrefetcher &operator=(const GraphPrefetcher &) = delete;
+
+        // Evicts every graph of the sweep and restores the affinity and OpenMP threads
+        ~GraphPrefetcher();
+
+        // Makes graph i current: waits until its prefetch is done, evicts the earlier graphs and
+        // starts on graph i + 1
+        void advance(size_t i);
+
+        void pause();
+
+        void resume();
+
+        [[nodiscard]] bool enabled() const { return worker.joinable(); }
+
+    private:
+        void run(int cpu);
+
+        // Returns false when stopped
+        bool wait_resumed();
+
+        void prefetch(const std::filesystem::path &path);
+
+        std::vector<std::filesystem::path> graphs;
+        Loader loader;
+        size_t budget_bytes;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        // next graph to prefetch and the number of graphs done
+        size_t requested = 0;
+        size_t done = 0;
+        bool paused = false;
+        bool stopped = false;
+
+        cpu_set_t previous_affinity{};
+        int previous_threads = 0;
+        std::thread worker;
+    };
+
+    // Upper bound of the memory of a weighted CSR load of the file, the temporary edge list included
+    size_t estimate_load_bytes(const std::filesystem::path &path, size_t weight_bytes);
+
+    // ALGOS_PREFETCH_MB if set, 0 disables prefetching, otherwise half of the available memory
+    size_t default_prefetch_budget();
+}// namespace algos
@@ -0,0 +1,109 @@
+#include "ipc_channel.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace algos {
+    namespace {
+        std::runtime_error system_error(const std::string &what) {
+            return std::runtime_error(what + ": " + std::strerror(errno));
+        }
+    }// namespace
+
+    IpcChannel &IpcChannel::operator=(IpcChannel &&other) noexcept {
+        if (this != &other) {
+            close();
+            fd = std::exchange(other.fd, -1);
+        }
+        return *this;
+    }
+
+    std::pair<IpcChannel, IpcChannel> IpcChannel::make_pair() {
+        int fds[2];
+        if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            throw system_error("Failed to create socket pair");
+        }
+        return {IpcChannel(fds[0]), IpcChannel(fds[1])};
+    }
+
+    void IpcChannel::close() {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    void IpcChannel::send(const void *data, size_t size) {
+        const auto *bytes = static_cast<const char *>(data);
+        while (size > 0) {
+            // MSG_NOSIGNAL turns a dead peer into an error instead of SIGPIPE
+            const ssize_t sent = ::send(fd, bytes, size, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                throw system_error("Failed to send to worker channel");
+            }
+            bytes += sent;
+            size -= static_cast<size_t>(sent);
+        }
+    }
+
+    void IpcChannel::recv(void *data, size_t size) {
+        auto *bytes = static_cast<char *>(data);
+        while (size > 0) {
+            const ssize_t received = ::recv(fd, bytes, size, 0);
+            if (received < 0) {
+                if (errno == EINTR) continue;
+                throw system_error("Failed to receive from worker channel");
+            }
+            if (received == 0) {
+                throw std::runtime_error("Worker channel closed by the peer");
+            }
+            bytes += received;
+            size -= static_cast<size_t>(received);
+        }
+    }
+
+    WorkerProcess launch_worker(const std::function<int(IpcChannel &)> &body) {
+        auto [parent_end, child_end] = IpcChannel::make_pair();
+        // buffered output would be written twice otherwise
+        std::cout.flush();
+        std::cerr.flush();
+
+        const pid_t pid = ::fork();
+        if (pid < 0) {
+            throw system_error("Failed to fork worker");
+        }
+        if (pid == 0) {
+            parent_end.close();
+            int code = 1;
+            try {
+                code = body(child_end);
+            } catch (const std::exception &e) {
+                std::cerr << "Worker " << ::getpid() << " failed: " << e.what() << std::endl;
+            }
+            child_end.close();
+            // skip the destructors and atexit handlers of the parent's state
+            ::_exit(code);
+        }
+        child_end.close();
+        return WorkerProcess{pid, std::move(parent_end)};
+    }
+
+    int join_worker(WorkerProcess &worker) {
+        worker.channel.close();
+        if (worker.pid < 0) return 0;
+        int status = 0;
+        while (::waitpid(worker.pid, &status, 0) < 0) {
+            if (errno != EINTR) throw system_error("Failed to wait for worker");
+        }
+        worker.pid = -1;
+        return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    }
+}// namespace algos
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace algos {
+    // Blocking byte channel over one end of a connected Unix domain socket pair
+    class IpcChannel {
+    public:
+        IpcChannel() = default;
+
+        explicit IpcChannel(int fd) : fd(fd) {}
+
+        IpcChannel(IpcChannel &&other) noexcept : fd(std::exchange(other.fd, -1)) {}
+
+        IpcChannel &operator=(IpcChannel &&other) noexcept;
+
+        IpcChannel(const IpcChannel &) = delete;
+
+        IpcChannel &operator=(const IpcChannel &) = delete;
+
+        ~IpcChannel() { close(); }
+
+        static std::pair<IpcChannel, IpcChannel> make_pair();
+
+        void close();
+
+        void send(const void *data, size_t size);
+
+        void recv(void *data, size_t size);
+
+        template<typename T>
+        void send_value(const T &value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            send(&value, sizeof(T));
+        }
+
+        template<typename T>
+        T recv_value() {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value;
+            recv(&value, sizeof(T));
+            return value;
+        }
+
+        // Vectors are sent as their size followed by the elements
+        template<typename T>
+        void send_vector(const std::vector<T> &values) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            send_value<uint64_t>(values.size());
+            send(values.data(), values.size() * sizeof(T));
+        }
+
+        template<typename T>
+        void recv_vector(std::vector<T> &values) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            values.resize(recv_value<uint64_t>());
+            recv(values.data(), values.size() * sizeof(T));
+        }
+
+    private:
+        int fd = -1;
+    };
+
+    struct WorkerProcess {
+        pid_t pid = -1;
+        // parent end of the channel
+        IpcChannel channel;
+    };
+
+    // Forks a worker that runs body on its end of a new channel and exits with the returned code.
+    // The body must not rely on threads of the parent, only the forking thread survives in the child
+    WorkerProcess launch_worker(const std::function<int(IpcChannel &)> &body);
+
+    // Closes the channel and waits for the worker to exit, returns its exit code
+    int join_worker(WorkerProcess &worker);
+}// namespace algos
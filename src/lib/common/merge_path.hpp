@@ -0,0 +1,96 @@
+#pragma once
+
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Edge-balanced partitioning of a CSR by merge path (Merrill and Garland, SC 2016). The row ends
+// offsets[1 .. n] and the edge indices 0 .. m are merged into one path of n + m steps, which is cut into
+// spans of equal length. Every span gets about the same number of rows plus edges, however skewed the
+// degrees are, and a hub row is split over several spans. Results of split rows are combined by
+// segmented_reduce. offsets[0] must be 0.
+namespace algos {
+    struct MergePathCoord {
+        int64_t row;
+        int64_t edge;
+    };
+
+    // Point of the merge path after the given number of steps: rows before row and edges before edge are consumed
+    template<typename Offsets>
+    MergePathCoord merge_path_search(const Offsets &offsets, int64_t n, int64_t diagonal) {
+        const auto m = static_cast<int64_t>(offsets[n]);
+        int64_t lo = std::max<int64_t>(0, diagonal - m), hi = std::min(diagonal, n);
+        while (lo < hi) {
+            const int64_t mid = lo + (hi - lo) / 2;
+            if (static_cast<int64_t>(offsets[mid + 1]) <= diagonal - mid - 1) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return {lo, diagonal - lo};
+    }
+
+    namespace detail {
+        // Spans shorter than this are not worth a task
+        constexpr int64_t MIN_SPAN = 4096;
+        constexpr int64_t SPANS_PER_THREAD = 4;
+
+        inline int64_t merge_path_spans(int64_t steps) {
+            const auto threads = static_cast<int64_t>(scheduler_threads());
+            if (threads == 1) return 1;
+            return std::clamp<int64_t>(steps / MIN_SPAN, 1, threads * SPANS_PER_THREAD);
+        }
+
+        // f(span, start, end) for every span, in parallel
+        template<typename Offsets, typename F>
+        void for_each_span(const Offsets &offsets, int64_t n, int64_t spans, F f) {
+            const int64_t steps = n + static_cast<int64_t>(offsets[n]);
+            const auto diagonal = [steps, spans](int64_t s) { return s * steps / spans; };
+            parallel_for_weighted(spans, diagonal, [&](int64_t s) {
+                f(s, merge_path_search(offsets, n, diagonal(s)), merge_path_search(offsets, n, diagonal(s + 1)));
+            });
+        }
+    }// namespace detail
+
+    // piece(row, begin, end) for every non-empty piece [begin, end) of the edges of a row. Pieces of one
+    // row may run concurrently on different threads
+    template<typename Offsets, typename Piece>
+    void merge_path_for_each(const Offsets &offsets, int64_t n, Piece piece) {
+        const int64_t spans = detail::merge_path_spans(n + static_cast<int64_t>(offsets[n]));
+        detail::for_each_span(offsets, n, spans, [&](int64_t, MergePathCoord start, MergePathCoord end) {
+            int64_t edge = start.edge;
+            for (int64_t row = start.row; row < end.row; ++row) {
+                const auto row_end = static_cast<int64_t>(offsets[row + 1]);
+                if (edge < row_end) piece(row, edge, row_end);
+                edge = row_end;
+            }
+            if (edge < end.edge) piece(end.row, edge, end.edge);
+        });
+    }
+
+    // out[row] = combination of segment(row, begin, end) over the pieces of the row, identity for rows
+    // without edges. The span a row ends in writes out[row], the pieces of earlier spans are carried over
+    // and combined afterwards, so combine must be associative and commutative
+    template<typename T, typename Offsets, typename Segment, typename Combine, typename Out>
+    void segmented_reduce(const Offsets &offsets, int64_t n, T identity, Segment segment, Combine combine, Out &&out) {
+        const int64_t spans = detail::merge_path_spans(n + static_cast<int64_t>(offsets[n]));
+        std::vector<int64_t> carry_row(spans);
+        std::vector<T> carry(spans, identity);
+        detail::for_each_span(offsets, n, spans, [&](int64_t s, MergePathCoord start, MergePathCoord end) {
+            int64_t edge = start.edge;
+            for (int64_t row = start.row; row < end.row; ++row) {
+                const auto row_end = static_cast<int64_t>(offsets[row + 1]);
+                out[row] = edge < row_end ? segment(row, edge, row_end) : identity;
+                edge = row_end;
+            }
+            carry_row[s] = end.row;
+            if (edge < end.edge) carry[s] = segment(end.row, edge, end.edge);
+        });
+        for (int64_t s = 0; s < spans; ++s) {
+            if (carry_row[s] < n) out[carry_row[s]] = combine(out[carry_row[s]], carry[s]);
+        }
+    }
+}// namespace algos
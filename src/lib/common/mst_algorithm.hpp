@@ -1,11 +1,35 @@
 #pragma once
 
 #include "algorithm.hpp"
-#include "tree.hpp"
+#include "result_export.hpp"
+#include "weight_type.hpp"
+
+#include <memory>
 
 namespace algos {
     class MstAlgorithm : public Algorithm {
     public:
         virtual Tree get_result() = 0;
+
+        // Writes the parents into the sink, e.g. a span of the caller or a ResultFile, without building a Tree
+        // where the algorithm overrides it
+        virtual void write_result(ResultSink &sink) { export_tree(get_result(), sink); }
     };
+
+    // Specialize to false for weight types a backend can not store
+    template<template<typename> class Algo, typename W>
+    inline constexpr bool supports_weight_v = true;
+
+    // Instantiates Algo for the runtime weight type, e.g. the one returned by detect_weight_type,
+    // args are passed to the constructor
+    template<template<typename> class Algo, typename... Args>
+    std::unique_ptr<MstAlgorithm> make_mst_algorithm(WeightType type, const Args &...args) {
+        return visit_weight_type(type, [type, &args...]<typename W>() -> std::unique_ptr<MstAlgorithm> {
+            if constexpr (supports_weight_v<Algo, W>) {
+                return std::make_unique<Algo<W>>(args...);
+            } else {
+                throw std::runtime_error("Weight type " + to_string(type) + " is not supported by the algorithm");
+            }
+        });
+    }
 };// namespace algos
\ No newline at end of file
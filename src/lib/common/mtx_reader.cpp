@@ -0,0 +1,55 @@
+#include "mtx_reader.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+namespace algos {
+    MtxHeader read_mtx_header(std::istream &input) {
+        MtxHeader header;
+        std::string line;
+
+        // Banner and comments
+        while (std::getline(input, line)) {
+            if (line.rfind("%%MatrixMarket", 0) == 0) {
+                std::string lower = line;
+                std::ranges::transform(lower, lower.begin(), [](unsigned char c) { return std::tolower(c); });
+                if (lower.find("pattern") != std::string::npos) {
+                    header.field = MtxField::Pattern;
+                } else if (lower.find("real") != std::string::npos || lower.find("double") != std::string::npos) {
+                    header.field = MtxField::Real;
+                }
+                continue;
+            }
+            if (line.empty() || line[0] != '%') break;
+        }
+
+        std::istringstream iss(line);
+        if (!(iss >> header.n_rows >> header.n_cols >> header.nnz)) {
+            throw std::runtime_error("Invalid mtx format, bad size line");
+        }
+        if (header.n_rows < 0 || header.n_cols < 0) {
+            throw std::runtime_error("Invalid mtx format, n < 0");
+        }
+        if (header.nnz < 0) {
+            throw std::runtime_error("Invalid mtx format, nnz < 0");
+        }
+        return header;
+    }
+
+    MtxHeader open_mtx_graph(const std::filesystem::path &path, GraphInput &input, uint64_t max_vertices) {
+        input.open(path);
+        if (!input.is_open()) {
+            throw std::runtime_error("Failed to open file: " + path.string());
+        }
+        const MtxHeader header = read_mtx_header(input);
+        if (header.n_rows != header.n_cols) {
+            throw std::runtime_error("Matrix must be square");
+        }
+        if (static_cast<uint64_t>(header.n_rows) > max_vertices) {
+            throw std::runtime_error("Graph has too many vertices for the loader: " + std::to_string(header.n_rows) +
+                                     ", at most " + std::to_string(max_vertices) + " are supported");
+        }
+        return header;
+    }
+}// namespace algos
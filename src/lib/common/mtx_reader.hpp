@@ -0,0 +1,97 @@
+#pragma once
+
+#include "graph_input.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace algos {
+    // Value field of the MatrixMarket banner, files without a banner are treated as integer
+    enum class MtxField {
+        Pattern,
+        Integer,
+        Real
+    };
+
+    struct MtxHeader {
+        MtxField field = MtxField::Integer;
+        int64_t n_rows = 0;
+        int64_t n_cols = 0;
+        int64_t nnz = 0;
+    };
+
+    // Weight type of the structure-only reads
+    struct NoWeight {};
+
+    // Reads the banner, comments and size line, leaves the stream at the first entry
+    MtxHeader read_mtx_header(std::istream &input);
+
+    // Opens an adjacency matrix, plain or compressed, and reads its header, the matrix must be square with
+    // at most max_vertices vertices. By default the ids fit the int parents of the 32-bit algorithms, loaders
+    // of 64-bit ids (IndexWidth::Wide) ask for more
+    MtxHeader open_mtx_graph(const std::filesystem::path &path, GraphInput &input,
+                             uint64_t max_vertices = std::numeric_limits<int32_t>::max());
+
+    // Reads one edge weight and checks that it is representable in W, pattern matrices have unit weights
+    template<typename W>
+    W read_mtx_weight(std::istream &input, MtxField field) {
+        if (field == MtxField::Pattern) {
+            return W(1);
+        }
+        if constexpr (std::is_integral_v<W>) {
+            // long double keeps every 64-bit integer exact
+            long double w;
+            input >> w;
+            if (w != std::floor(w)) {
+                throw std::runtime_error("Invalid graph, non-integer edge weight");
+            }
+            if (w < static_cast<long double>(std::numeric_limits<W>::lowest()) ||
+                w > static_cast<long double>(std::numeric_limits<W>::max())) {
+                throw std::runtime_error("Invalid graph, edge weight out of range");
+            }
+            return static_cast<W>(w);
+        } else {
+            W w;
+            input >> w;
+            return w;
+        }
+    }
+
+    // Streams the entries after the header as f(u, v, w) with 0-based ids of type V, self loops included,
+    // weights are not read for NoWeight
+    template<typename W, typename V = uint32_t, typename F>
+    void for_each_mtx_entry(std::istream &input, const MtxHeader &header, F &&f) {
+        const int64_t n = header.n_rows;
+        int64_t u, v;
+        for (int64_t i = 0; i < header.nnz; ++i) {
+            input >> u >> v;
+            u--;
+            v--;
+            if (u < 0 || v < 0 || u >= n || v >= n) {
+                throw std::runtime_error("Invalid graph, incorrect vertex numbers");
+            }
+            W w{};
+            if constexpr (!std::is_same_v<W, NoWeight>) {
+                w = read_mtx_weight<W>(input, header.field);
+            }
+            input.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            f(static_cast<V>(u), static_cast<V>(v), w);
+        }
+    }
+
+    // Streams the entries after the header as f(u, v, w) with 0-based ids of type V, self loops are skipped
+    // and weights are not read for NoWeight
+    template<typename W, typename V = uint32_t, typename F>
+    void for_each_mtx_edge(std::istream &input, const MtxHeader &header, F &&f) {
+        for_each_mtx_entry<W, V>(input, header, [&f](V u, V v, W w) {
+            if (u != v) {
+                f(u, v, w);
+            }
+        });
+    }
+}// namespace algos
@@ -0,0 +1,185 @@
+#include "numa_allocator.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace algos {
+    namespace {
+        constexpr size_t HUGE_PAGE = size_t{1} << 21;
+        constexpr size_t SMALL_PAGE = 4096;
+        // from linux/mempolicy.h, libnuma is not required
+        constexpr int MPOL_INTERLEAVE_MODE = 3;
+        constexpr size_t MAX_NODES = 1024;
+        // mbind is given MAX_NODES + 1 as maxnode like libnuma does, the mask holds that many bits
+        // so that no kernel reads past it whether or not it drops the last one
+        constexpr size_t MASK_WORDS = MAX_NODES / 64 + 1;
+
+        size_t round_up(size_t x, size_t to) { return (x + to - 1) / to * to; }
+
+        MemoryPolicy initial_policy() {
+            const char *env = std::getenv("ALGOS_MEMORY");
+            return env ? parse_memory_policy(env) : MemoryPolicy{};
+        }
+
+        std::atomic<MemoryPolicy> &current_policy() {
+            static std::atomic<MemoryPolicy> policy(initial_policy());
+            return policy;
+        }
+
+        // Online nodes as listed in sysfs, e.g. "0-1,4"
+        struct NodeMask {
+            uint64_t words[MASK_WORDS] = {};
+            uint32_t count = 0;
+        };
+
+        NodeMask read_online_nodes() {
+            NodeMask mask;
+            std::ifstream input("/sys/devices/system/node/online");
+            std::string range;
+            while (std::getline(input, range, ',')) {
+                const size_t dash = range.find('-');
+                try {
+                    const auto first = std::stoul(range.substr(0, dash));
+                    const auto last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+                    for (auto node = first; node <= last && node < MAX_NODES; ++node) {
+                        mask.words[node / 64] |= uint64_t{1} << (node % 64);
+                        ++mask.count;
+                    }
+                } catch (const std::logic_error &) {
+                    break;
+                }
+            }
+            if (mask.count == 0) {
+                mask.words[0] = 1;
+                mask.count = 1;
+            }
+            return mask;
+        }
+
+        const NodeMask &online_nodes() {
+            static const NodeMask mask = read_online_nodes();
+            return mask;
+        }
+
+        // 2 MB aligned anonymous mapping, so that transparent huge pages can cover it completely
+        void *map_aligned(size_t length) {
+            void *raw = mmap(nullptr, length + HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) return nullptr;
+            const auto begin = reinterpret_cast<uintptr_t>(raw);
+            const uintptr_t aligned = round_up(begin, HUGE_PAGE);
+            if (aligned > begin) {
+                munmap(raw, aligned - begin);
+            }
+            const uintptr_t tail = begin + length + HUGE_PAGE - (aligned + length);
+            if (tail > 0) {
+                munmap(reinterpret_cast<void *>(aligned + length), tail);
+            }
+            return reinterpret_cast<void *>(aligned);
+        }
+
+        // Faults the pages in when the array is allocated instead of in the first timed run. The interleave
+        // policy decides where they land, so it does not matter which thread touches which page
+        void touch_in_parallel(char *p, size_t bytes) {
+            const auto pages = static_cast<int64_t>((bytes + SMALL_PAGE - 1) / SMALL_PAGE);
+#pragma omp parallel for schedule(static)
+            for (int64_t i = 0; i < pages; ++i) {
+                p[i * SMALL_PAGE] = 0;
+            }
+        }
+    }// namespace
+
+    std::string to_string(MemoryPolicy policy) {
+        std::string res;
+        switch (policy.placement) {
+            case NumaPlacement::FirstTouch:
+                res = "first-touch";
+                break;
+            case NumaPlacement::Interleave:
+                res = "interleave";
+                break;
+        }
+        switch (policy.pages) {
+            case PageSize::Small:
+                break;
+            case PageSize::Transparent:
+                res += "+thp";
+                break;
+            case PageSize::Huge:
+                res += "+huge";
+                break;
+        }
+        return res;
+    }
+
+    MemoryPolicy parse_memory_policy(std::string_view text) {
+        MemoryPolicy policy;
+        const size_t plus = text.find('+');
+        const std::string_view placement = text.substr(0, plus);
+        if (placement == "interleave") {
+            policy.placement = NumaPlacement::Interleave;
+        } else if (placement != "first-touch" && !placement.empty()) {
+            throw std::runtime_error("Unknown NUMA placement: " + std::string(placement));
+        }
+        if (plus != std::string_view::npos) {
+            const std::string_view pages = text.substr(plus + 1);
+            if (pages == "thp") {
+                policy.pages = PageSize::Transparent;
+            } else if (pages == "huge") {
+                policy.pages = PageSize::Huge;
+            } else {
+                throw std::runtime_error("Unknown page size: " + std::string(pages));
+            }
+        }
+        return policy;
+    }
+
+    MemoryPolicy memory_policy() {
+        return current_policy().load(std::memory_order_relaxed);
+    }
+
+    void set_memory_policy(MemoryPolicy policy) {
+        current_policy().store(policy, std::memory_order_relaxed);
+    }
+
+    uint32_t numa_node_count() {
+        return online_nodes().count;
+    }
+
+    void *allocate_pages(size_t bytes) {
+        const MemoryPolicy policy = memory_policy();
+        const size_t length = round_up(bytes, HUGE_PAGE);
+
+        void *p = nullptr;
+        if (policy.pages == PageSize::Huge) {
+            p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p == MAP_FAILED) p = nullptr;
+        }
+        const bool hugetlb = p != nullptr;
+        if (!p) {
+            p = map_aligned(length);
+            if (!p) throw std::bad_alloc();
+        }
+        if (!hugetlb && policy.pages != PageSize::Small) {
+            madvise(p, length, MADV_HUGEPAGE);
+        }
+
+        // Placement is best effort, mbind is missing in some containers
+        if (policy.placement == NumaPlacement::Interleave && numa_node_count() > 1) {
+            syscall(SYS_mbind, p, length, MPOL_INTERLEAVE_MODE, online_nodes().words, MAX_NODES + 1, 0);
+        }
+        if (policy.placement == NumaPlacement::Interleave) {
+            touch_in_parallel(static_cast<char *>(p), bytes);
+        }
+        return p;
+    }
+
+    void deallocate_pages(void *p, size_t bytes) {
+        munmap(p, round_up(bytes, HUGE_PAGE));
+    }
+}// namespace algos
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace algos {
+    // Where the pages of large arrays are placed on multi-socket machines
+    enum class NumaPlacement {
+        // pages land on the node of the thread that writes them first, usually the loader thread
+        FirstTouch,
+        // pages are spread round-robin over all nodes with mbind
+        Interleave
+    };
+
+    enum class PageSize {
+        Small,
+        // 2 MB pages via madvise(MADV_HUGEPAGE), the kernel may still back them with 4K pages
+        Transparent,
+        // 2 MB pages from the hugetlbfs pool (MAP_HUGETLB), falls back to Transparent when the pool is empty
+        Huge
+    };
+
+    struct MemoryPolicy {
+        NumaPlacement placement = NumaPlacement::FirstTouch;
+        PageSize pages = PageSize::Small;
+
+        bool operator==(const MemoryPolicy &) const = default;
+    };
+
+    // "first-touch" or "interleave", optionally followed by "+thp" or "+huge"
+    std::string to_string(MemoryPolicy policy);
+
+    MemoryPolicy parse_memory_policy(std::string_view text);
+
+    // Policy of the allocations made from now on, initially taken from the ALGOS_MEMORY variable
+    MemoryPolicy memory_policy();
+
+    void set_memory_policy(MemoryPolicy policy);
+
+    // Number of NUMA nodes the machine reports, 1 without NUMA support
+    uint32_t numa_node_count();
+
+    // Arrays of at least this many bytes are mapped separately and follow the memory policy,
+    // smaller ones come from the usual heap
+    constexpr size_t LARGE_ALLOCATION = size_t{1} << 21;
+
+    // Mapped at a 2 MB boundary, so that huge pages cover the array from its first byte
+    void *allocate_pages(size_t bytes);
+
+    void deallocate_pages(void *p, size_t bytes);
+
+    template<typename T>
+    class NumaAllocator {
+    public:
+        using value_type = T;
+
+        NumaAllocator() = default;
+
+        template<typename U>
+        NumaAllocator(const NumaAllocator<U> &) {}
+
+        T *allocate(size_t n) {
+            const size_t bytes = n * sizeof(T);
+            if (bytes < LARGE_ALLOCATION) {
+                return static_cast<T *>(::operator new(bytes));
+            }
+            return static_cast<T *>(allocate_pages(bytes));
+        }
+
+        void deallocate(T *p, size_t n) {
+            const size_t bytes = n * sizeof(T);
+            if (bytes < LARGE_ALLOCATION) {
+                ::operator delete(p);
+            } else {
+                deallocate_pages(p, bytes);
+            }
+        }
+
+        template<typename U>
+        bool operator==(const NumaAllocator<U> &) const { return true; }
+    };
+
+    // Storage of graphs and per-vertex state of the native algorithms
+    template<typename T>
+    using numa_vector = std::vector<T, NumaAllocator<T>>;
+}// namespace algos
@@ -1,11 +1,34 @@
 #pragma once
 
 #include "algorithm.hpp"
-#include "tree.hpp"
+#include "result_export.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
 
 namespace algos {
     class ParentBfsAlgorithm : public Algorithm {
     public:
         virtual Tree get_result() = 0;
+
+        // Writes the parents into the sink, e.g. a span of the caller or a ResultFile, without building a Tree
+        // where the algorithm overrides it
+        virtual void write_result(ResultSink &sink) { export_tree(get_result(), sink, root); }
+
+        // With a root only its component is searched and the other vertices are left without a parent,
+        // without one the whole BFS forest is built. Kept across load_graph
+        virtual void set_root(std::optional<uint32_t> vertex) { root = vertex; }
+
+        [[nodiscard]] std::optional<uint32_t> get_root() const { return root; }
+
+        // Roots of the forest, e.g. component_roots of a ConnectedComponentsAlgorithm. The forest is searched
+        // from them first, so vertices are only scanned for unvisited ones when the seeds miss a component.
+        // Ignored with a root, cleared by load_graph
+        void seed_roots(std::vector<uint32_t> roots) { seeds = std::move(roots); }
+
+    protected:
+        std::optional<uint32_t> root;
+        std::vector<uint32_t> seeds;
     };
-}// namespace algos
\ No newline at end of file
+}// namespace algos
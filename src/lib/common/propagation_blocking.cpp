@@ -0,0 +1,84 @@
+#include "propagation_blocking.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace algos {
+    namespace {
+        // Smallest block, below it the bins hold more bookkeeping than updates
+        constexpr uint32_t MIN_BLOCK_SHIFT = 12;
+
+        // "48K", "2048K" or "1M" as in sysfs, 0 when unreadable
+        size_t read_cache_size(const std::filesystem::path &path) {
+            std::ifstream file(path);
+            size_t value = 0;
+            char unit = 0;
+            if (!(file >> value)) return 0;
+            file >> unit;
+            if (unit == 'K') return value << 10;
+            if (unit == 'M') return value << 20;
+            return value;
+        }
+
+        CacheSizes detect_cache_sizes() {
+            CacheSizes res{size_t{32} << 10, size_t{256} << 10, size_t{8} << 20};
+            const std::filesystem::path root = "/sys/devices/system/cpu/cpu0/cache";
+            std::error_code ec;
+            size_t llc = 0;
+            int llc_level = 0;
+            for (const auto &entry: std::filesystem::directory_iterator(root, ec)) {
+                if (entry.path().filename().string().rfind("index", 0) != 0) continue;
+                int level = 0;
+                std::string type;
+                std::ifstream(entry.path() / "level") >> level;
+                std::ifstream(entry.path() / "type") >> type;
+                const size_t size = read_cache_size(entry.path() / "size");
+                if (size == 0 || type == "Instruction") continue;
+                if (level == 1) res.l1d = size;
+                if (level == 2) res.l2 = size;
+                if (level > llc_level) {
+                    llc_level = level;
+                    llc = size;
+                }
+            }
+            if (llc_level >= 3) res.llc = llc;
+            return res;
+        }
+    }// namespace
+
+    const CacheSizes &cache_sizes() {
+        static const CacheSizes sizes = detect_cache_sizes();
+        return sizes;
+    }
+
+    std::string to_string(Propagation propagation) {
+        switch (propagation) {
+            case Propagation::Direct:
+                return "direct";
+            case Propagation::Blocked:
+                return "blocked";
+            case Propagation::Auto:
+                return "auto";
+        }
+        return "unknown";
+    }
+
+    bool use_blocking(Propagation propagation, size_t state_bytes) {
+        if (propagation == Propagation::Auto) return state_bytes > cache_sizes().llc;
+        return propagation == Propagation::Blocked;
+    }
+
+    uint32_t propagation_block_shift(size_t bytes_per_vertex) {
+        size_t block_bytes = cache_sizes().l2 / 2;
+        if (const char *env = std::getenv("ALGOS_BLOCK_BYTES")) {
+            block_bytes = std::stoull(env);
+        }
+        const size_t vertices = std::max<size_t>(1, block_bytes / std::max<size_t>(1, bytes_per_vertex));
+        uint32_t shift = 0;
+        while ((size_t{2} << shift) <= vertices) ++shift;
+        return std::max(shift, MIN_BLOCK_SHIFT);
+    }
+}// namespace algos
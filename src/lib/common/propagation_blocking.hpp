@@ -0,0 +1,98 @@
+#pragma once
+
+#include "scheduler.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Propagation blocking (Beamer, Asanovic, Patterson, IPDPS 2017): instead of updating the state of the
+// destination of every edge at random, updates are first appended to bins by destination block and then
+// every bin is applied on its own. A block of destination state is sized to stay in the cache while its
+// bin is applied, so the random accesses hit the cache and the bins are written and read sequentially.
+// It pays off once the per-vertex state no longer fits into the last level cache.
+namespace algos {
+    struct CacheSizes {
+        size_t l1d;
+        size_t l2;
+        size_t llc;
+    };
+
+    // Sizes of the data caches of the first CPU from sysfs, with common defaults where they are not reported
+    const CacheSizes &cache_sizes();
+
+    // How the native kernels update per-vertex state along edges
+    enum class Propagation {
+        // in place, with atomics where threads may collide
+        Direct,
+        // through destination bins
+        Blocked,
+        // Blocked when the state exceeds the last level cache
+        Auto
+    };
+
+    std::string to_string(Propagation propagation);
+
+    bool use_blocking(Propagation propagation, size_t state_bytes);
+
+    // log2 of the vertices in a destination block: the state of a block takes half of the L2 cache, or
+    // ALGOS_BLOCK_BYTES when set
+    uint32_t propagation_block_shift(size_t bytes_per_vertex);
+
+    // Thread local bins of updates by destination block. Updates are pushed from a parallel loop, apply then
+    // hands every block to a single thread, so the updates of a block need no atomics
+    template<typename Update>
+    class PropagationBins {
+    public:
+        // Empties the bins and sizes them for destinations below vertices
+        void reset(uint64_t vertices, uint32_t block_shift) {
+            shift = block_shift;
+            blocks = static_cast<size_t>((vertices >> shift) + 1);
+            bins.resize(scheduler_threads());
+            bins.for_each([this](std::vector<std::vector<Update>> &local) {
+                local.resize(blocks);
+                for (auto &bin: local) {
+                    bin.clear();
+                }
+            });
+        }
+
+        [[nodiscard]] size_t block_count() const { return blocks; }
+
+        void push(uint32_t dest, const Update &update) {
+            bins.local()[dest >> shift].push_back(update);
+        }
+
+        // f(update) for every pushed update, the blocks in parallel and split on their numbers of updates.
+        // Bins are cleared and keep their capacity
+        template<typename F>
+        void apply(F f) {
+            std::vector<std::vector<std::vector<Update>> *> locals;
+            bins.for_each([&](std::vector<std::vector<Update>> &local) { locals.push_back(&local); });
+            block_updates.assign(blocks + 1, 0);
+            for (size_t b = 0; b < blocks; ++b) {
+                block_updates[b + 1] = block_updates[b] + 1;
+                for (const auto *local: locals) {
+                    block_updates[b + 1] += static_cast<int64_t>((*local)[b].size());
+                }
+            }
+            parallel_for_weighted(
+                    static_cast<int64_t>(blocks), [this](int64_t b) { return block_updates[b]; }, [&](int64_t b) {
+                        for (auto *local: locals) {
+                            for (const Update &update: (*local)[b]) {
+                                f(update);
+                            }
+                            (*local)[b].clear();
+                        }
+                    });
+        }
+
+    private:
+        uint32_t shift = 0;
+        size_t blocks = 0;
+        PerThread<std::vector<std::vector<Update>>> bins{0};
+        // block_updates[b] - updates plus blocks before block b
+        std::vector<int64_t> block_updates;
+    };
+}// namespace algos
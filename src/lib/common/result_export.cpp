@@ -0,0 +1,366 @@
+#include "result_export.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace algos {
+    namespace {
+        constexpr char MAGIC[8] = {'A', 'L', 'G', 'O', 'T', 'R', 'E', 'E'};
+        constexpr uint32_t VERSION = 2;
+        constexpr size_t HEADER_BYTES = 48;
+        // Header of version 1 files, without the sections
+        constexpr size_t V1_HEADER_BYTES = 40;
+
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            uint32_t encoding;
+            uint64_t n;
+            double weight;
+            uint64_t payload_bytes;
+            uint32_t sections;
+            uint32_t reserved;
+        };
+        static_assert(sizeof(Header) == HEADER_BYTES);
+
+        std::runtime_error system_error(const std::string &what) {
+            return std::runtime_error(what + ": " + std::strerror(errno));
+        }
+
+        Header make_header(ParentEncoding encoding, uint64_t n, double weight, uint64_t payload_bytes, uint32_t sections) {
+            Header header{};
+            std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = VERSION;
+            header.encoding = static_cast<uint32_t>(encoding);
+            header.n = n;
+            header.weight = weight;
+            header.payload_bytes = payload_bytes;
+            header.sections = sections;
+            return header;
+        }
+
+        // Sections start at multiples of 8 bytes, so the mapped doubles are aligned
+        uint64_t align8(uint64_t bytes) {
+            return (bytes + 7) / 8 * 8;
+        }
+
+        // Offsets of the sections after parents of payload_bytes, the end of the file last
+        struct SectionOffsets {
+            uint64_t edge_weights;
+            uint64_t levels;
+            uint64_t end;
+        };
+
+        SectionOffsets section_offsets(uint64_t payload_bytes, uint64_t n, uint32_t sections) {
+            SectionOffsets offsets{};
+            uint64_t pos = align8(HEADER_BYTES + payload_bytes);
+            offsets.edge_weights = pos;
+            if (sections & ResultSection::EdgeWeights) pos = align8(pos + n * sizeof(double));
+            offsets.levels = pos;
+            if (sections & ResultSection::Levels) pos = align8(pos + n * sizeof(int32_t));
+            offsets.end = pos;
+            return offsets;
+        }
+
+        size_t entry_bytes(ParentEncoding encoding) {
+            return encoding == ParentEncoding::Int32 ? sizeof(int32_t) : sizeof(int64_t);
+        }
+
+        uint64_t zigzag(int64_t x) {
+            return (static_cast<uint64_t>(x) << 1) ^ static_cast<uint64_t>(x >> 63);
+        }
+
+        int64_t unzigzag(uint64_t x) {
+            return static_cast<int64_t>(x >> 1) ^ -static_cast<int64_t>(x & 1);
+        }
+
+        std::vector<char> encode_delta(const std::vector<int64_t> &parent) {
+            std::vector<char> bytes;
+            bytes.reserve(parent.size() * 2);
+            for (size_t v = 0; v < parent.size(); ++v) {
+                uint64_t x = parent[v] < 0 ? 0 : zigzag(parent[v] - static_cast<int64_t>(v));
+                while (x >= 0x80) {
+                    bytes.push_back(static_cast<char>(x | 0x80));
+                    x >>= 7;
+                }
+                bytes.push_back(static_cast<char>(x));
+            }
+            return bytes;
+        }
+
+        std::vector<int64_t> decode_delta(const std::vector<char> &bytes, uint64_t n) {
+            std::vector<int64_t> parent(n);
+            size_t pos = 0;
+            for (uint64_t v = 0; v < n; ++v) {
+                uint64_t x = 0;
+                for (uint32_t shift = 0;; shift += 7) {
+                    if (pos == bytes.size() || shift > 63) throw std::runtime_error("Result file is truncated");
+                    const auto byte = static_cast<uint8_t>(bytes[pos++]);
+                    x |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                    if (byte < 0x80) break;
+                }
+                parent[v] = x == 0 ? -1 : static_cast<int64_t>(v) + unzigzag(x);
+            }
+            return parent;
+        }
+    }// namespace
+
+    ParentSpan SpanSink::parents(uint64_t vertices) {
+        n = vertices;
+        const bool narrow = std::holds_alternative<std::span<int32_t>>(out);
+        if (narrow && n > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+            throw std::runtime_error("32-bit parents can not hold " + std::to_string(n) + " vertices");
+        }
+        const auto first = [this](auto span) -> ParentSpan {
+            if (span.size() < n) {
+                throw std::runtime_error("Result span holds " + std::to_string(span.size()) + " parents, " +
+                                         std::to_string(n) + " are needed");
+            }
+            return span.first(n);
+        };
+        return std::visit(first, out);
+    }
+
+    std::span<int32_t> SpanSink::levels(uint64_t vertices) {
+        if (levels_out.empty()) return {};
+        if (levels_out.size() < vertices) {
+            throw std::runtime_error("Level span holds " + std::to_string(levels_out.size()) + " entries, " +
+                                     std::to_string(vertices) + " are needed");
+        }
+        return levels_out.first(vertices);
+    }
+
+    std::span<double> SpanSink::edge_weights(uint64_t vertices) {
+        if (weights_out.empty()) return {};
+        if (weights_out.size() < vertices) {
+            throw std::runtime_error("Edge weight span holds " + std::to_string(weights_out.size()) + " entries, " +
+                                     std::to_string(vertices) + " are needed");
+        }
+        return weights_out.first(vertices);
+    }
+
+    ParentSpan TreeSink::parents(uint64_t n) {
+        parent.resize(n);
+        return std::span<int64_t>(parent);
+    }
+
+    ResultFile::ResultFile(std::filesystem::path path, ParentEncoding encoding, uint32_t sections)
+        : path(std::move(path)), encoding(encoding), sections(sections) {}
+
+    ResultFile::~ResultFile() {
+        unmap();
+    }
+
+    void ResultFile::unmap() {
+        if (mapping) {
+            munmap(mapping, mapping_bytes);
+            mapping = nullptr;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    ParentSpan ResultFile::parents(uint64_t vertices) {
+        unmap();
+        n = vertices;
+        if (encoding == ParentEncoding::Delta) {
+            // The sections are zero until the algorithm writes them, as in the mapped file
+            delta_parents.resize(n);
+            delta_weights.assign(sections & ResultSection::EdgeWeights ? n : 0, 0);
+            delta_levels.assign(sections & ResultSection::Levels ? n : 0, 0);
+            return std::span<int64_t>(delta_parents);
+        }
+        if (encoding == ParentEncoding::Int32 && n > static_cast<uint64_t>(std::numeric_limits<int32_t>::max())) {
+            throw std::runtime_error("32-bit parents can not hold " + std::to_string(n) + " vertices");
+        }
+
+        const size_t payload = n * entry_bytes(encoding);
+        mapping_bytes = section_offsets(payload, n, sections).end;
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) throw system_error("Failed to create " + path.string());
+        if (::ftruncate(fd, static_cast<off_t>(mapping_bytes)) != 0) throw system_error("Failed to resize " + path.string());
+        mapping = mmap(nullptr, mapping_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            mapping = nullptr;
+            throw system_error("Failed to map " + path.string());
+        }
+
+        const Header header = make_header(encoding, n, 0, payload, sections);
+        std::memcpy(mapping, &header, HEADER_BYTES);
+        auto *data = static_cast<char *>(mapping) + HEADER_BYTES;
+        if (encoding == ParentEncoding::Int32) {
+            return std::span<int32_t>(reinterpret_cast<int32_t *>(data), n);
+        }
+        return std::span<int64_t>(reinterpret_cast<int64_t *>(data), n);
+    }
+
+    std::span<int32_t> ResultFile::levels(uint64_t vertices) {
+        if (!(sections & ResultSection::Levels) || vertices != n) return {};
+        if (encoding == ParentEncoding::Delta) return delta_levels;
+        if (!mapping) throw std::runtime_error("No parents were written to " + path.string());
+        const uint64_t offset = section_offsets(n * entry_bytes(encoding), n, sections).levels;
+        return {reinterpret_cast<int32_t *>(static_cast<char *>(mapping) + offset), n};
+    }
+
+    std::span<double> ResultFile::edge_weights(uint64_t vertices) {
+        if (!(sections & ResultSection::EdgeWeights) || vertices != n) return {};
+        if (encoding == ParentEncoding::Delta) return delta_weights;
+        if (!mapping) throw std::runtime_error("No parents were written to " + path.string());
+        const uint64_t offset = section_offsets(n * entry_bytes(encoding), n, sections).edge_weights;
+        return {reinterpret_cast<double *>(static_cast<char *>(mapping) + offset), n};
+    }
+
+    void ResultFile::finish(double weight) {
+        if (encoding == ParentEncoding::Delta) {
+            const std::vector<char> bytes = encode_delta(delta_parents);
+            const Header header = make_header(encoding, n, weight, bytes.size(), sections);
+            const SectionOffsets offsets = section_offsets(bytes.size(), n, sections);
+            std::vector<char> file(offsets.end, 0);
+            std::memcpy(file.data(), &header, HEADER_BYTES);
+            std::memcpy(file.data() + HEADER_BYTES, bytes.data(), bytes.size());
+            if (sections & ResultSection::EdgeWeights) {
+                std::memcpy(file.data() + offsets.edge_weights, delta_weights.data(), n * sizeof(double));
+            }
+            if (sections & ResultSection::Levels) {
+                std::memcpy(file.data() + offsets.levels, delta_levels.data(), n * sizeof(int32_t));
+            }
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(file.data(), static_cast<std::streamsize>(file.size()));
+            if (!out) throw std::runtime_error("Failed to write " + path.string());
+            delta_parents = {};
+            delta_weights = {};
+            delta_levels = {};
+            return;
+        }
+        if (!mapping) throw std::runtime_error("No parents were written to " + path.string());
+        std::memcpy(static_cast<char *>(mapping) + offsetof(Header, weight), &weight, sizeof(weight));
+        unmap();
+    }
+
+    void export_levels(ParentSpan parents, ResultSink &sink, std::optional<uint64_t> root) {
+        const auto depths = [&sink, root](auto parent) {
+            const std::span<int32_t> level = sink.levels(parent.size());
+            if (level.empty()) return;
+            constexpr int32_t UNKNOWN = -2;
+            std::ranges::fill(level, UNKNOWN);
+            // The vertices up to one of known level, their levels are set on the way back down
+            std::vector<uint64_t> path;
+            for (uint64_t v = 0; v < parent.size(); ++v) {
+                uint64_t u = v;
+                path.clear();
+                while (level[u] == UNKNOWN && parent[u] >= 0) {
+                    path.push_back(u);
+                    u = static_cast<uint64_t>(parent[u]);
+                    if (path.size() > parent.size()) throw std::runtime_error("Parents contain a cycle");
+                }
+                if (level[u] == UNKNOWN) {
+                    level[u] = root && *root != u ? -1 : 0;
+                }
+                int32_t depth = level[u];
+                for (auto it = path.rbegin(); it != path.rend(); ++it) {
+                    depth = depth < 0 ? -1 : depth + 1;
+                    level[*it] = depth;
+                }
+            }
+        };
+        std::visit(depths, parents);
+    }
+
+    void export_tree(const Tree &tree, ResultSink &sink, std::optional<uint64_t> root) {
+        const auto copy = [&tree](auto out) {
+            for (uint64_t v = 0; v < tree.n; ++v) {
+                out[v] = static_cast<typename decltype(out)::value_type>(tree.parent[v]);
+            }
+        };
+        const ParentSpan parents = sink.parents(tree.n);
+        std::visit(copy, parents);
+        export_levels(parents, sink, root);
+        sink.finish(tree.weight);
+    }
+
+    void export_forest(uint32_t n, const std::vector<std::pair<uint32_t, uint32_t>> &edges,
+                       const std::vector<double> &edge_weights, double weight, ResultSink &sink) {
+        const ParentSpan parents = sink.parents(n);
+        std::visit([n, &edges](auto out) { orient_forest(n, edges, out); }, parents);
+        export_levels(parents, sink);
+        if (const std::span<double> out = sink.edge_weights(n); !out.empty() && !edge_weights.empty()) {
+            // Every edge of the forest is oriented from one of its ends to the other
+            std::ranges::fill(out, 0);
+            std::visit([&](auto parent) {
+                for (size_t e = 0; e < edges.size(); ++e) {
+                    const auto [u, v] = edges[e];
+                    out[parent[u] == static_cast<int64_t>(v) ? u : v] = edge_weights[e];
+                }
+            }, parents);
+        }
+        sink.finish(weight);
+    }
+
+    ResultFileContents read_result_contents(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("Failed to open file: " + path.string());
+        Header header{};
+        in.read(reinterpret_cast<char *>(&header), V1_HEADER_BYTES);
+        if (!in || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error("Not a result file: " + path.string());
+        }
+        if (header.version == VERSION) {
+            in.read(reinterpret_cast<char *>(&header) + V1_HEADER_BYTES, HEADER_BYTES - V1_HEADER_BYTES);
+            if (!in) throw std::runtime_error("Result file is truncated");
+        } else if (header.version != 1) {
+            throw std::runtime_error("Unsupported result file version " + std::to_string(header.version));
+        }
+
+        std::vector<char> bytes(header.payload_bytes);
+        in.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (!in) throw std::runtime_error("Result file is truncated");
+
+        const auto encoding = static_cast<ParentEncoding>(header.encoding);
+        std::vector<int64_t> parent;
+        if (encoding == ParentEncoding::Delta) {
+            parent = decode_delta(bytes, header.n);
+        } else if (encoding == ParentEncoding::Int32 || encoding == ParentEncoding::Int64) {
+            if (bytes.size() != header.n * entry_bytes(encoding)) throw std::runtime_error("Result file is truncated");
+            parent.resize(header.n);
+            for (uint64_t v = 0; v < header.n; ++v) {
+                if (encoding == ParentEncoding::Int32) {
+                    int32_t p;
+                    std::memcpy(&p, bytes.data() + v * sizeof(p), sizeof(p));
+                    parent[v] = p;
+                } else {
+                    std::memcpy(&parent[v], bytes.data() + v * sizeof(int64_t), sizeof(int64_t));
+                }
+            }
+        } else {
+            throw std::runtime_error("Unknown parent encoding " + std::to_string(header.encoding));
+        }
+
+        ResultFileContents contents{Tree{header.n, std::move(parent), header.weight}, {}, {}};
+        const SectionOffsets offsets = section_offsets(header.payload_bytes, header.n, header.sections);
+        const auto read_section = [&](auto &values, uint64_t offset) {
+            values.resize(header.n);
+            in.seekg(static_cast<std::streamoff>(offset));
+            in.read(reinterpret_cast<char *>(values.data()), static_cast<std::streamsize>(header.n * sizeof(values[0])));
+            if (!in) throw std::runtime_error("Result file is truncated");
+        };
+        if (header.sections & ResultSection::EdgeWeights) read_section(contents.edge_weights, offsets.edge_weights);
+        if (header.sections & ResultSection::Levels) read_section(contents.levels, offsets.levels);
+        return contents;
+    }
+
+    Tree read_result_file(const std::filesystem::path &path) {
+        return read_result_contents(path).tree;
+    }
+}// namespace algos
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "tree.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <utility>
+#include <variant>
+#include <vector>
+
+// Results written straight into caller memory instead of a Tree. An algorithm asks its ResultSink for the
+// parent array once it knows the number of vertices and fills it in place: a span of the caller, a file
+// mapped into memory or, for get_result, the vector a Tree takes over. Levels and edge weights are optional,
+// the algorithm asks for them after the parents and a sink that does not want them returns empty spans.
+//
+// Result file format, little endian, 48 byte header followed by the parents and the optional sections:
+//   0   char[8]  magic "ALGOTREE"
+//   8   uint32   version, 2
+//   12  uint32   encoding, ParentEncoding
+//   16  uint64   n, number of vertices
+//   24  double   weight of the tree
+//   32  uint64   bytes of the parents
+//   40  uint32   sections, ResultSection bits
+//   44  uint32   reserved, 0
+//   48  parents  Int32 / Int64: n signed integers, -1 for roots and unreached vertices.
+//                Delta: n LEB128 varints of zigzag(parent[v] - v), 0 for roots and unreached vertices
+//                since no vertex is its own parent
+//   then, each starting at a multiple of 8 bytes and in this order:
+//       EdgeWeights  n doubles, weight of the edge to the parent, 0 for roots and unreached vertices and
+//                    wherever the algorithm does not know the weights, e.g. after a BFS
+//       Levels       n int32, depth in the forest, -1 for unreached vertices
+// Version 1 files have a 40 byte header without the sections field and are still read.
+namespace algos {
+    // Parent array of 32-bit or 64-bit entries, -1 for roots and unreached vertices
+    using ParentSpan = std::variant<std::span<int32_t>, std::span<int64_t>>;
+
+    class ResultSink {
+    public:
+        virtual ~ResultSink() = default;
+
+        // Array for the n parents, requested once per result
+        virtual ParentSpan parents(uint64_t n) = 0;
+
+        // Array for the depth of every vertex in the forest, empty if the sink does not keep levels
+        virtual std::span<int32_t> levels(uint64_t) { return {}; }
+
+        // Array for the weight of the edge of every vertex to its parent, empty if the sink does not keep them
+        virtual std::span<double> edge_weights(uint64_t) { return {}; }
+
+        // Called once the parents are written
+        virtual void finish(double weight) = 0;
+    };
+
+    // Writes into memory of the caller, which must hold at least n parents. The levels and edge weights are
+    // written when the caller passes spans for them
+    class SpanSink final : public ResultSink {
+    public:
+        explicit SpanSink(ParentSpan out, std::span<int32_t> levels_out = {}, std::span<double> weights_out = {})
+            : out(out), levels_out(levels_out), weights_out(weights_out) {}
+
+        ParentSpan parents(uint64_t n) override;
+
+        std::span<int32_t> levels(uint64_t n) override;
+
+        std::span<double> edge_weights(uint64_t n) override;
+
+        void finish(double w) override { total_weight = w; }
+
+        [[nodiscard]] uint64_t vertices() const { return n; }
+
+        [[nodiscard]] double weight() const { return total_weight; }
+
+    private:
+        ParentSpan out;
+        std::span<int32_t> levels_out;
+        std::span<double> weights_out;
+        uint64_t n = 0;
+        double total_weight = 0;
+    };
+
+    // Collects the parents into a Tree, get_result of the algorithms that implement write_result
+    class TreeSink final : public ResultSink {
+    public:
+        ParentSpan parents(uint64_t n) override;
+
+        void finish(double w) override { total_weight = w; }
+
+        Tree take() { return Tree{parent.size(), std::move(parent), total_weight}; }
+
+    private:
+        std::vector<int64_t> parent;
+        double total_weight = 0;
+    };
+
+    enum class ParentEncoding : uint32_t {
+        Int32 = 1,
+        Int64 = 2,
+        Delta = 3
+    };
+
+    // Optional sections of a result file
+    enum ResultSection : uint32_t {
+        EdgeWeights = 1,
+        Levels = 2
+    };
+
+    // Result file in the format above. Int32 and Int64 parents and the sections are written into the mapped
+    // file directly, Delta parents are collected and encoded by finish, so the file stays a few bytes per
+    // vertex. sections is a mask of ResultSection
+    class ResultFile final : public ResultSink {
+    public:
+        explicit ResultFile(std::filesystem::path path, ParentEncoding encoding = ParentEncoding::Int32, uint32_t sections = 0);
+
+        ResultFile(const ResultFile &) = delete;
+
+        ResultFile &operator=(const ResultFile &) = delete;
+
+        ~ResultFile() override;
+
+        ParentSpan parents(uint64_t n) override;
+
+        std::span<int32_t> levels(uint64_t n) override;
+
+        std::span<double> edge_weights(uint64_t n) override;
+
+        void finish(double weight) override;
+
+    private:
+        void unmap();
+
+        std::filesystem::path path;
+        ParentEncoding encoding;
+        uint32_t sections;
+        uint64_t n = 0;
+        int fd = -1;
+        void *mapping = nullptr;
+        size_t mapping_bytes = 0;
+        std::vector<int64_t> delta_parents;
+        std::vector<double> delta_weights;
+        std::vector<int32_t> delta_levels;
+    };
+
+    // Writes the depth of every vertex in the forest of the parents into the levels of the sink, if it keeps
+    // them. With a root, as after a BFS from it, the other vertices without a parent were not reached and get -1
+    void export_levels(ParentSpan parents, ResultSink &sink, std::optional<uint64_t> root = std::nullopt);
+
+    // Default write_result of the algorithms, copies the tree. Edge weights are not known and left to the sink
+    void export_tree(const Tree &tree, ResultSink &sink, std::optional<uint64_t> root = std::nullopt);
+
+    // Orients the forest of the edges as make_tree does, writing the parents into the sink. edge_weights holds
+    // the weight of every edge and may be empty
+    void export_forest(uint32_t n, const std::vector<std::pair<uint32_t, uint32_t>> &edges,
+                       const std::vector<double> &edge_weights, double weight, ResultSink &sink);
+
+    // Contents of a result file, levels and edge_weights are empty if the file has no such section
+    struct ResultFileContents {
+        Tree tree;
+        std::vector<int32_t> levels;
+        std::vector<double> edge_weights;
+    };
+
+    ResultFileContents read_result_contents(const std::filesystem::path &path);
+
+    // Parents and weight of a result file
+    Tree read_result_file(const std::filesystem::path &path);
+}// namespace algos
@@ -0,0 +1,187 @@
+#include "run_isolation.hpp"
+#include "ipc_channel.hpp"
+#include "propagation_blocking.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+#include <sched.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace algos {
+    namespace {
+        bool env_flag(const char *name) {
+            const char *env = std::getenv(name);
+            return env && std::string_view(env) != "0" && !std::string_view(env).empty();
+        }
+
+        std::vector<int> allowed_cpus() {
+            std::vector<int> cpus;
+            cpu_set_t set;
+            if (sched_getaffinity(0, sizeof(set), &set) != 0) return cpus;
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+            }
+            return cpus;
+        }
+    }// namespace
+
+    IsolationConfig IsolationConfig::from_env() {
+        IsolationConfig config;
+        config.enabled = env_flag("ALGOS_ISOLATE");
+        if (const char *env = std::getenv("ALGOS_ISOLATE_CPUS")) {
+            config.cpus = parse_cpu_list(env);
+        }
+        config.flush_llc = env_flag("ALGOS_FLUSH_LLC");
+        config.drop_page_cache = env_flag("ALGOS_DROP_CACHES");
+        return config;
+    }
+
+    std::vector<int> parse_cpu_list(std::string_view text) {
+        std::vector<int> cpus;
+        while (!text.empty()) {
+            const size_t comma = text.find(',');
+            const std::string part(text.substr(0, comma));
+            text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+            if (part.empty()) continue;
+
+            char *end = nullptr;
+            const auto first = static_cast<int>(std::strtol(part.c_str(), &end, 10));
+            int last = first;
+            if (*end == '-') last = static_cast<int>(std::strtol(end + 1, &end, 10));
+            if (end == part.c_str() || *end != '\0' || first < 0 || last < first || last >= CPU_SETSIZE) {
+                throw std::runtime_error("Invalid CPU list: " + part);
+            }
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        std::ranges::sort(cpus);
+        const auto duplicates = std::ranges::unique(cpus);
+        cpus.erase(duplicates.begin(), duplicates.end());
+        return cpus;
+    }
+
+    std::string format_cpu_list(const std::vector<int> &cpus) {
+        std::string res;
+        for (size_t i = 0; i < cpus.size();) {
+            size_t j = i;
+            while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) ++j;
+            if (!res.empty()) res += ",";
+            res += std::to_string(cpus[i]);
+            if (j > i) res += "-" + std::to_string(cpus[j]);
+            i = j + 1;
+        }
+        return res;
+    }
+
+    void pin_to_cpus(const std::vector<int> &cpus) {
+        if (cpus.empty()) return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (const int cpu: cpus) {
+            CPU_SET(cpu, &set);
+        }
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            throw std::runtime_error("Failed to pin to CPUs " + format_cpu_list(cpus));
+        }
+#ifdef _OPENMP
+        omp_set_num_threads(std::min(omp_get_max_threads(), static_cast<int>(cpus.size())));
+#endif
+    }
+
+    void flush_last_level_cache() {
+        // Filling and reading a buffer of twice the cache evicts the lines of the loaded graph
+        const size_t bytes = 2 * cache_sizes().llc;
+        std::vector<char> buffer(bytes, 1);
+        volatile char sink = 0;
+        for (size_t i = 0; i < bytes; i += 64) {
+            sink = sink + buffer[i];
+        }
+    }
+
+    bool drop_page_cache() {
+        ::sync();
+        std::ofstream file("/proc/sys/vm/drop_caches");
+        if (!file.is_open()) return false;
+        file << "3" << std::endl;
+        return static_cast<bool>(file);
+    }
+
+    std::string cpu_frequency_governor(const std::vector<int> &cpus) {
+        std::map<std::string, int> counts;
+        for (const int cpu: cpus.empty() ? allowed_cpus() : cpus) {
+            std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpufreq/scaling_governor");
+            std::string governor;
+            if (file >> governor) ++counts[governor];
+        }
+        if (counts.empty()) return "unknown";
+        if (counts.size() == 1) return counts.begin()->first;
+        std::string res;
+        for (const auto &[governor, count]: counts) {
+            if (!res.empty()) res += ", ";
+            res += governor + " x" + std::to_string(count);
+        }
+        return res;
+    }
+
+    namespace detail {
+        void run_isolated(const IsolationConfig &config, const std::function<void(void *)> &body, void *out, size_t bytes) {
+            if (config.drop_page_cache && !drop_page_cache()) {
+                static bool warned = false;
+                if (!std::exchange(warned, true)) {
+                    std::cerr << "Dropping the page cache is not permitted, runs start with a warm page cache" << std::endl;
+                }
+            }
+
+            // The child answers with a status byte followed by the result or the error message
+            WorkerProcess worker = launch_worker([&](IpcChannel &channel) {
+                std::vector<char> result(bytes);
+                bool failed = false;
+                std::string error;
+                try {
+                    pin_to_cpus(config.cpus);
+                    body(result.data());
+                } catch (const std::exception &e) {
+                    failed = true;
+                    error = e.what();
+                }
+                // the child exits without flushing
+                std::cout.flush();
+                if (failed) {
+                    channel.send_value<uint8_t>(0);
+                    channel.send_vector(std::vector<char>(error.begin(), error.end()));
+                    return 1;
+                }
+                channel.send_value<uint8_t>(1);
+                channel.send(result.data(), bytes);
+                return 0;
+            });
+
+            uint8_t ok = 0;
+            std::vector<char> message;
+            try {
+                ok = worker.channel.recv_value<uint8_t>();
+                if (ok) {
+                    worker.channel.recv(out, bytes);
+                } else {
+                    worker.channel.recv_vector(message);
+                }
+            } catch (const std::runtime_error &) {
+                const int code = join_worker(worker);
+                throw std::runtime_error("Isolated run exited without a result, exit code " + std::to_string(code));
+            }
+            join_worker(worker);
+            if (!ok) throw std::runtime_error(std::string(message.begin(), message.end()));
+        }
+    }// namespace detail
+}// namespace algos
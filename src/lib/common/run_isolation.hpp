@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Isolated benchmark runs. Every run is forked into a fresh child, so it does not inherit the warm caches,
+// the heap or the library threads of the runs before it, and is pinned to a fixed set of CPUs. Between runs
+// the page cache can be dropped and the last level cache flushed. The parent must not start OpenMP regions
+// or the SPLA and GraphBLAS runtimes itself: only the forking thread survives in the child, and a team or
+// device context inherited from the parent can not be used there.
+namespace algos {
+    struct IsolationConfig {
+        // Fork a child per run, ALGOS_ISOLATE=1
+        bool enabled = false;
+        // CPUs of the runs, empty keeps the affinity of the parent, ALGOS_ISOLATE_CPUS=2-5,8
+        std::vector<int> cpus;
+        // Stream over twice the last level cache before the computation, ALGOS_FLUSH_LLC=1
+        bool flush_llc = false;
+        // Write back dirty pages and drop the page cache before every run, needs root, ALGOS_DROP_CACHES=1
+        bool drop_page_cache = false;
+
+        static IsolationConfig from_env();
+    };
+
+    // "0-3,8,10-11" as in /sys/devices/system/cpu/online
+    std::vector<int> parse_cpu_list(std::string_view text);
+
+    std::string format_cpu_list(const std::vector<int> &cpus);
+
+    // Pins the calling thread to the CPUs and caps its OpenMP threads to their number
+    void pin_to_cpus(const std::vector<int> &cpus);
+
+    void flush_last_level_cache();
+
+    // Returns false when it is not permitted
+    bool drop_page_cache();
+
+    // scaling_governor of the CPUs, all of the allowed ones when empty: "performance" when they agree,
+    // "performance x6, powersave x2" otherwise and "unknown" without cpufreq
+    std::string cpu_frequency_governor(const std::vector<int> &cpus = {});
+
+    namespace detail {
+        void run_isolated(const IsolationConfig &config, const std::function<void(void *)> &body, void *out, size_t bytes);
+    }
+
+    // Runs body in a forked child prepared as configured and returns its result. An exception of the
+    // body is rethrown as std::runtime_error, a crashed child throws as well
+    template<typename T>
+    T run_isolated(const IsolationConfig &config, const std::function<T()> &body) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        const auto run = [&body](void *out) {
+            const T res = body();
+            std::memcpy(out, &res, sizeof(T));
+        };
+        detail::run_isolated(config, run, &value, sizeof(T));
+        return value;
+    }
+}// namespace algos
@@ -0,0 +1,357 @@
+#include "scheduler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <pthread.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace algos {
+    namespace {
+        // Lazy splitting keeps at most log2(range / grain) ranges on a deque, a full deque runs the range as is
+        constexpr int64_t DEQUE_CAPACITY = 64;
+        // Smallest task in units of weight, about a vertex or an edge each
+        constexpr int64_t MIN_GRAIN = 1024;
+        // Target number of tasks per thread when the loop is large
+        constexpr int64_t TASKS_PER_THREAD = 64;
+        // Checks of the generation before a sleeping thread blocks
+        constexpr int SPIN_WAIT = 1 << 14;
+
+        using clock = std::chrono::steady_clock;
+
+        struct Range {
+            int64_t begin;
+            int64_t end;
+        };
+
+        // Chase-Lev deque (Le, Pop, Cohen, Zappa Nardelli, PPoPP 2013) with a fixed ring. The owner pushes and
+        // pops at the bottom, thieves take from the top. A slot is only rewritten after the ring wraps
+        // around, which push refuses, so the two halves of a stolen range always belong together
+        class RangeDeque {
+        public:
+            // Only while no loop is running
+            void clear() {
+                top.store(0, std::memory_order_relaxed);
+                bottom.store(0, std::memory_order_relaxed);
+            }
+
+            bool push(Range r) {
+                const int64_t b = bottom.load(std::memory_order_relaxed);
+                const int64_t t = top.load(std::memory_order_acquire);
+                if (b - t >= DEQUE_CAPACITY) return false;
+                Slot &slot = slots[b & (DEQUE_CAPACITY - 1)];
+                slot.begin.store(r.begin, std::memory_order_relaxed);
+                slot.end.store(r.end, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return true;
+            }
+
+            std::optional<Range> pop() {
+                const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+                bottom.store(b, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                int64_t t = top.load(std::memory_order_relaxed);
+                if (t > b) {
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    return std::nullopt;
+                }
+                const Range r = read(b);
+                if (t == b) {
+                    // last range, a thief may take it at the same time
+                    const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                    bottom.store(b + 1, std::memory_order_relaxed);
+                    if (!won) return std::nullopt;
+                }
+                return r;
+            }
+
+            std::optional<Range> steal() {
+                int64_t t = top.load(std::memory_order_acquire);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                const int64_t b = bottom.load(std::memory_order_acquire);
+                if (t >= b) return std::nullopt;
+                const Range r = read(t);
+                if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    return std::nullopt;
+                }
+                return r;
+            }
+
+        private:
+            struct Slot {
+                std::atomic<int64_t> begin;
+                std::atomic<int64_t> end;
+            };
+
+            Range read(int64_t i) const {
+                const Slot &slot = slots[i & (DEQUE_CAPACITY - 1)];
+                return {slot.begin.load(std::memory_order_relaxed), slot.end.load(std::memory_order_relaxed)};
+            }
+
+            alignas(64) std::atomic<int64_t> top{0};
+            alignas(64) std::atomic<int64_t> bottom{0};
+            alignas(64) std::array<Slot, DEQUE_CAPACITY> slots{};
+        };
+
+        struct alignas(64) Worker {
+            RangeDeque deque;
+            uint64_t rng = 0;
+            // written by the owner during a loop, summed up by the caller after it
+            uint64_t tasks = 0;
+            uint64_t steals = 0;
+            clock::duration idle{};
+
+            uint32_t next_random() {
+                rng ^= rng << 13;
+                rng ^= rng >> 7;
+                rng ^= rng << 17;
+                return static_cast<uint32_t>(rng >> 32);
+            }
+        };
+
+        thread_local unsigned current_worker = 0;
+        thread_local bool in_loop = false;
+        thread_local unsigned thread_limit = 0;
+
+        // Threads and deques shared by all loops. One loop runs at a time, its caller is worker 0
+        // and the helper threads are workers 1 .. threads - 1
+        class Pool {
+        public:
+            static Pool &instance() {
+                static Pool pool;
+                return forked ? *forked : pool;
+            }
+
+            // Pool of a forked child. The helpers of the inherited pool do not exist there, so the child
+            // starts a pool of its own and leaves the inherited one, whose destructor would join them, alone
+            static inline Pool *forked = nullptr;
+
+            ~Pool() {
+                stopping = true;
+                generation.fetch_add(1, std::memory_order_release);
+                generation.notify_all();
+                for (auto &t: helpers) {
+                    t.join();
+                }
+            }
+
+            // Returns false without running anything when another loop is in progress
+            bool run(int64_t begin, int64_t end, detail::RangeBody body, detail::RangePrefix prefix, unsigned threads) {
+                std::unique_lock lock(loop_mutex, std::try_to_lock);
+                if (!lock) return false;
+
+                while (workers.size() < threads) {
+                    workers.push_back(std::make_unique<Worker>());
+                    workers.back()->rng = 0x9E3779B97F4A7C15ull * workers.size();
+                }
+                while (helpers.size() + 1 < threads) {
+                    const auto id = static_cast<unsigned>(helpers.size() + 1);
+                    helpers.emplace_back([this, id, seen = generation.load()] { help(id, seen); });
+                }
+
+                loop = {begin, end, body, prefix, threads, 0};
+                loop.grain = std::max(MIN_GRAIN, (weight(begin, end) + threads * TASKS_PER_THREAD - 1) / (threads * TASKS_PER_THREAD));
+                remaining.store(end - begin, std::memory_order_relaxed);
+                finished.store(0, std::memory_order_relaxed);
+                error = nullptr;
+                for (unsigned w = 0; w < threads; ++w) {
+                    workers[w]->deque.clear();
+                }
+                workers[0]->deque.push({begin, end});
+
+                // Every helper checks in, also those the loop has no use for, so none of them still reads loop
+                // or runs the body when the next loop starts, however many threads that one has
+                const auto helping = static_cast<unsigned>(helpers.size());
+                generation.fetch_add(1, std::memory_order_release);
+                generation.notify_all();
+                work(0);
+                while (finished.load(std::memory_order_acquire) < helping) {
+                    std::this_thread::yield();
+                }
+
+                {
+                    std::lock_guard stats_lock(stats_mutex);
+                    ++totals.loops;
+                    for (unsigned w = 0; w < threads; ++w) {
+                        Worker &worker = *workers[w];
+                        totals.tasks += std::exchange(worker.tasks, 0);
+                        totals.steals += std::exchange(worker.steals, 0);
+                        totals.idle_seconds += std::chrono::duration<double>(std::exchange(worker.idle, {})).count();
+                    }
+                }
+                if (error) std::rethrow_exception(error);
+                return true;
+            }
+
+            SchedulerStats stats() {
+                std::lock_guard lock(stats_mutex);
+                return totals;
+            }
+
+            void reset_stats() {
+                std::lock_guard lock(stats_mutex);
+                totals = {};
+            }
+
+        private:
+            struct Loop {
+                int64_t begin;
+                int64_t end;
+                detail::RangeBody body;
+                detail::RangePrefix prefix;
+                unsigned threads;
+                int64_t grain;
+            };
+
+            int64_t weight(int64_t begin, int64_t end) const {
+                if (!loop.prefix.at) return end - begin;
+                return loop.prefix.at(loop.prefix.prefix, end) - loop.prefix.at(loop.prefix.prefix, begin);
+            }
+
+            // Point of [begin, end) halving its weight, both halves non-empty
+            int64_t split_point(int64_t begin, int64_t end) const {
+                if (!loop.prefix.at) return begin + (end - begin) / 2;
+                const int64_t target = loop.prefix.at(loop.prefix.prefix, begin) + weight(begin, end) / 2;
+                int64_t lo = begin + 1, hi = end - 1;
+                while (lo < hi) {
+                    const int64_t mid = lo + (hi - lo) / 2;
+                    if (loop.prefix.at(loop.prefix.prefix, mid) < target) {
+                        lo = mid + 1;
+                    } else {
+                        hi = mid;
+                    }
+                }
+                return lo;
+            }
+
+            void help(unsigned id, uint64_t seen) {
+                current_worker = id;
+                while (true) {
+                    for (int i = 0; i < SPIN_WAIT && generation.load(std::memory_order_acquire) == seen; ++i) {}
+                    generation.wait(seen, std::memory_order_acquire);
+                    seen = generation.load(std::memory_order_acquire);
+                    if (stopping) return;
+                    if (id < loop.threads) {
+                        work(id);
+                    }
+                    finished.fetch_add(1, std::memory_order_release);
+                }
+            }
+
+            void work(unsigned id) {
+                Worker &self = *workers[id];
+                current_worker = id;
+                in_loop = true;
+                while (true) {
+                    std::optional<Range> r = self.deque.pop();
+                    if (!r) r = steal(id);
+                    if (!r) break;
+                    execute(self, *r);
+                }
+                in_loop = false;
+                current_worker = 0;
+            }
+
+            std::optional<Range> steal(unsigned id) {
+                Worker &self = *workers[id];
+                const auto start = clock::now();
+                std::optional<Range> r;
+                while (remaining.load(std::memory_order_acquire) > 0) {
+                    const unsigned victim = self.next_random() % loop.threads;
+                    if (victim == id) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    r = workers[victim]->deque.steal();
+                    if (r) {
+                        ++self.steals;
+                        break;
+                    }
+                }
+                self.idle += clock::now() - start;
+                return r;
+            }
+
+            void execute(Worker &self, Range r) {
+                while (r.end - r.begin > 1 && weight(r.begin, r.end) > loop.grain) {
+                    const int64_t mid = split_point(r.begin, r.end);
+                    if (!self.deque.push({mid, r.end})) break;
+                    r.end = mid;
+                }
+                try {
+                    loop.body.run(loop.body.body, r.begin, r.end);
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                }
+                ++self.tasks;
+                remaining.fetch_sub(r.end - r.begin, std::memory_order_acq_rel);
+            }
+
+            std::mutex loop_mutex;
+            std::vector<std::unique_ptr<Worker>> workers;
+            std::vector<std::thread> helpers;
+            std::atomic<uint64_t> generation{0};
+            std::atomic<bool> stopping{false};
+
+            Loop loop{};
+            // iterations not executed yet, and helpers done with the loop, the ones beyond loop.threads included
+            std::atomic<int64_t> remaining{0};
+            std::atomic<unsigned> finished{0};
+            std::mutex error_mutex;
+            std::exception_ptr error;
+
+            std::mutex stats_mutex;
+            SchedulerStats totals;
+        };
+
+        [[maybe_unused]] const int reset_pool_on_fork = pthread_atfork(nullptr, nullptr, [] { Pool::forked = new Pool; });
+    }// namespace
+
+    unsigned scheduler_threads() {
+#ifdef _OPENMP
+        const auto threads = static_cast<unsigned>(std::max(1, omp_get_max_threads()));
+#else
+        const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+#endif
+        return thread_limit > 0 ? std::min(threads, thread_limit) : threads;
+    }
+
+    void limit_scheduler_threads(unsigned threads) {
+        thread_limit = threads;
+    }
+
+    unsigned worker_id() {
+        return current_worker;
+    }
+
+    SchedulerStats scheduler_stats() {
+        return Pool::instance().stats();
+    }
+
+    void reset_scheduler_stats() {
+        Pool::instance().reset_stats();
+    }
+
+    namespace detail {
+        void parallel_ranges(int64_t begin, int64_t end, RangeBody body, RangePrefix prefix) {
+            if (begin >= end) return;
+            const unsigned threads = scheduler_threads();
+            if (threads > 1 && !in_loop && end - begin > 1 && Pool::instance().run(begin, end, body, prefix, threads)) {
+                return;
+            }
+            body.run(body.body, begin, end);
+        }
+    }// namespace detail
+}// namespace algos
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Work-stealing runtime of the native kernels. A parallel loop starts as one range on the deque of the
+// calling thread. Whoever executes a range first splits it in halves of equal weight, keeps the lower
+// half and pushes the upper one to its own Chase-Lev deque, until the range is below the grain.
+// Idle threads steal the oldest, i.e. largest, ranges from random victims. Weighted loops split on a
+// prefix sum of the work, e.g. vertices plus edges, so a few hubs do not end up in a single task.
+//
+//   parallel_for(0, n, [&](int64_t v) { ... });
+//   parallel_for_edges(g.offsets, g.n, [&](int64_t v) { ... });
+//
+// The number of threads follows omp_get_max_threads of the calling thread, so ThreadCountGuard applies
+// as before. Loops inside a loop body and loops started while another thread runs one are executed
+// sequentially by the caller. An exception of the body is rethrown by the caller once the loop has finished.
+namespace algos {
+    struct SchedulerStats {
+        uint64_t loops = 0;
+        // ranges executed, after splitting
+        uint64_t tasks = 0;
+        uint64_t steals = 0;
+        // summed over the threads, time spent looking for work while a loop was running
+        double idle_seconds = 0;
+    };
+
+    // Threads a loop started by the calling thread runs on
+    unsigned scheduler_threads();
+
+    // Caps scheduler_threads of the calling thread, 0 removes the cap
+    void limit_scheduler_threads(unsigned threads);
+
+    // Index of the calling thread within the running loop, 0 outside of a loop
+    unsigned worker_id();
+
+    // Totals of all loops since the last reset
+    SchedulerStats scheduler_stats();
+
+    void reset_scheduler_stats();
+
+    namespace detail {
+        struct RangeBody {
+            void *body;
+            void (*run)(void *body, int64_t begin, int64_t end);
+        };
+
+        // Weight of [0, i), null for unit weights
+        struct RangePrefix {
+            const void *prefix = nullptr;
+            int64_t (*at)(const void *prefix, int64_t i) = nullptr;
+        };
+
+        void parallel_ranges(int64_t begin, int64_t end, RangeBody body, RangePrefix prefix);
+
+        template<typename Body>
+        RangeBody range_body(Body &body) {
+            return {&body, [](void *b, int64_t begin, int64_t end) {
+                        for (int64_t i = begin; i < end; ++i) {
+                            (*static_cast<Body *>(b))(i);
+                        }
+                    }};
+        }
+    }// namespace detail
+
+    template<typename Body>
+    void parallel_for(int64_t begin, int64_t end, Body &&body) {
+        detail::parallel_ranges(begin, end, detail::range_body(body), {});
+    }
+
+    // prefix(i) - weight of the iterations [0, i), non-decreasing
+    template<typename Prefix, typename Body>
+    void parallel_for_weighted(int64_t n, const Prefix &prefix, Body &&body) {
+        const detail::RangePrefix weights{&prefix, [](const void *p, int64_t i) {
+                                              return static_cast<int64_t>((*static_cast<const Prefix *>(p))(i));
+                                          }};
+        detail::parallel_ranges(0, n, detail::range_body(body), weights);
+    }
+
+    // Loop over the vertices of a CSR, tasks are split so that they hold similar numbers of vertices plus edges
+    template<typename Offsets, typename Body>
+    void parallel_for_edges(const Offsets &offsets, int64_t n, Body &&body) {
+        parallel_for_weighted(n, [&offsets](int64_t i) { return static_cast<int64_t>(offsets[i]) + i; },
+                              std::forward<Body>(body));
+    }
+
+    // One value per thread of a loop, padded to separate cache lines, e.g. thread local output buffers
+    template<typename T>
+    class PerThread {
+    public:
+        explicit PerThread(unsigned threads = scheduler_threads()) : slots(threads) {}
+
+        // Keeps the values of the first threads, so buffers retain their capacity between loops
+        void resize(unsigned threads) { slots.resize(threads); }
+
+        T &local() { return slots[worker_id()].value; }
+
+        template<typename F>
+        void for_each(F f) {
+            for (auto &slot: slots) {
+                f(slot.value);
+            }
+        }
+
+    private:
+        struct alignas(64) Slot {
+            T value{};
+        };
+
+        std::vector<Slot> slots;
+    };
+}// namespace algos
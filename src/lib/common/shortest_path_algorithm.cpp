@@ -0,0 +1,48 @@
+#include "shortest_path_algorithm.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace algos {
+    WeightedCsrGraph<double> load_sssp_graph(const std::filesystem::path &path) {
+        WeightedCsrGraph<double> g = load_weighted_csr<double>(path);
+        if (std::ranges::any_of(g.weights, [](double w) { return w < 0; })) {
+            throw std::runtime_error("Negative edge weights are not supported by shortest paths");
+        }
+        return g;
+    }
+
+    double choose_delta(const WeightedCsrGraph<double> &g) {
+        double sum = 0, min_positive = UNREACHABLE;
+        for (const double w: g.weights) {
+            sum += w;
+            if (w > 0) min_positive = std::min(min_positive, w);
+        }
+        if (g.edges() == 0 || min_positive == UNREACHABLE) return 1;
+        const double mean_weight = sum / g.edges();
+        const double mean_degree = static_cast<double>(g.edges()) / g.n;
+        return std::max(min_positive, 2 * mean_weight / mean_degree);
+    }
+
+    ShortestPaths make_shortest_paths(const WeightedCsrGraph<double> &g, uint32_t source, std::vector<double> distance) {
+        ShortestPaths res{Tree{g.n, std::vector<int64_t>(g.n, -1), 0}, std::move(distance)};
+        if (source >= g.n) return res;
+
+        std::vector<bool> visited(g.n, false);
+        std::vector<uint32_t> queue = {source};
+        visited[source] = true;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const uint32_t u = queue[head];
+            for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                const uint32_t v = g.cols[e];
+                if (!visited[v] && res.distance[u] + g.weights[e] == res.distance[v]) {
+                    visited[v] = true;
+                    res.tree.parent[v] = u;
+                    res.tree.weight += g.weights[e];
+                    queue.push_back(v);
+                }
+            }
+        }
+        return res;
+    }
+}// namespace algos
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include "csr_graph.hpp"
+#include "tree.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace algos {
+    inline constexpr double UNREACHABLE = std::numeric_limits<double>::infinity();
+
+    struct ShortestPaths {
+        // parent[source] and parent of unreachable vertices are -1, weight is the total weight of the tree edges
+        Tree tree;
+        // distance[v] - length of the shortest path from the source, UNREACHABLE if there is none
+        std::vector<double> distance;
+    };
+
+    class ShortestPathAlgorithm : public Algorithm {
+    public:
+        // Source vertex of the next compute, 0 by default
+        void set_source(uint32_t s) { source = s; }
+
+        virtual ShortestPaths get_result() = 0;
+
+    protected:
+        uint32_t source = 0;
+    };
+
+    // Weighted CSR for shortest paths, throws on negative weights
+    WeightedCsrGraph<double> load_sssp_graph(const std::filesystem::path &path);
+
+    // Bucket width of delta-stepping from the weight distribution. For uniform weights it matches the
+    // Meyer–Sanders choice 1 / degree, in general it is 2 * mean weight / mean degree, at least the smallest
+    // positive weight so that the buckets are not emptier than Dijkstra's
+    double choose_delta(const WeightedCsrGraph<double> &g);
+
+    // Orients the tight edges, those with distance[u] + w == distance[v], into a shortest path tree
+    // by a BFS from the source, which also keeps zero weight cycles out of the tree
+    ShortestPaths make_shortest_paths(const WeightedCsrGraph<double> &g, uint32_t source, std::vector<double> distance);
+}// namespace algos
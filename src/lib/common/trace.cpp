@@ -0,0 +1,109 @@
+#include "trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <unistd.h>
+
+namespace algos::trace {
+    namespace {
+        constexpr uint64_t BUFFER_EVENTS = uint64_t{1} << 16;
+
+        // Written only by its thread, head is published with release so that a reader sees whole events
+        struct ThreadBuffer {
+            uint32_t tid;
+            std::atomic<uint64_t> head{0};
+            std::unique_ptr<Event[]> events = std::make_unique<Event[]>(BUFFER_EVENTS);
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            // buffers outlive their threads, so that events of finished threads are written too
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        };
+
+        Registry &registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        ThreadBuffer *register_thread() {
+            Registry &r = registry();
+            std::lock_guard lock(r.mutex);
+            r.buffers.push_back(std::make_unique<ThreadBuffer>());
+            r.buffers.back()->tid = static_cast<uint32_t>(r.buffers.size());
+            return r.buffers.back().get();
+        }
+
+        void write_args(std::ostream &out, const Event &event) {
+            out << "\"args\":{";
+            for (uint32_t i = 0; i < MAX_ARGS && event.arg_names[i]; ++i) {
+                out << (i ? "," : "") << '"' << event.arg_names[i] << "\":" << event.args[i];
+            }
+            out << '}';
+        }
+    }// namespace
+
+    uint64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void record(const Event &event) {
+        thread_local ThreadBuffer *buffer = register_thread();
+        const uint64_t head = buffer->head.load(std::memory_order_relaxed);
+        buffer->events[head % BUFFER_EVENTS] = event;
+        buffer->head.store(head + 1, std::memory_order_release);
+    }
+
+    void write_chrome_trace(const std::filesystem::path &path) {
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            throw std::runtime_error("Failed to open trace file: " + path.string());
+        }
+
+        Registry &r = registry();
+        std::lock_guard lock(r.mutex);
+        uint64_t origin = UINT64_MAX;
+        for (const auto &buffer: r.buffers) {
+            const uint64_t head = buffer->head.load(std::memory_order_acquire);
+            for (uint64_t i = head - std::min(head, BUFFER_EVENTS); i < head; ++i) {
+                origin = std::min(origin, buffer->events[i % BUFFER_EVENTS].start_ns);
+            }
+        }
+
+        const int pid = getpid();
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        for (const auto &buffer: r.buffers) {
+            const uint64_t head = buffer->head.load(std::memory_order_acquire);
+            for (uint64_t i = head - std::min(head, BUFFER_EVENTS); i < head; ++i) {
+                const Event &event = buffer->events[i % BUFFER_EVENTS];
+                out << (first ? "\n" : ",\n") << "{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase
+                    << "\",\"pid\":" << pid << ",\"tid\":" << buffer->tid << ",\"ts\":" << (event.start_ns - origin) / 1000.0;
+                if (event.phase == 'X') {
+                    out << ",\"dur\":" << event.duration_ns / 1000.0;
+                }
+                out << ',';
+                write_args(out, event);
+                out << '}';
+                first = false;
+            }
+        }
+        out << "\n]}\n";
+    }
+
+    void clear() {
+        Registry &r = registry();
+        std::lock_guard lock(r.mutex);
+        for (const auto &buffer: r.buffers) {
+            buffer->head.store(0, std::memory_order_relaxed);
+        }
+    }
+}// namespace algos::trace
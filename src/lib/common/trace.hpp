@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+// Timeline of algorithm iterations in the Chrome trace-event format, viewable in Perfetto or chrome://tracing.
+// Recording is compiled in only with ALGOS_TRACE (cmake -DALGOS_TRACE=ON), otherwise the macros expand to
+// empty objects and cost nothing. Event and argument names must be string literals.
+//
+//   ALGOS_TRACE_SCOPE(round, "boruvka_round");
+//   round.arg("components", count);
+//   ALGOS_TRACE_COUNTER("prim_queue", queue.size());
+namespace algos::trace {
+#if defined(ALGOS_TRACE)
+    constexpr bool ENABLED = true;
+#else
+    constexpr bool ENABLED = false;
+#endif
+
+    constexpr uint32_t MAX_ARGS = 2;
+
+    struct Event {
+        const char *name;
+        // 'X' - complete event with a duration, 'C' - counter
+        char phase;
+        uint64_t start_ns;
+        uint64_t duration_ns;
+        const char *arg_names[MAX_ARGS];
+        int64_t args[MAX_ARGS];
+    };
+
+    uint64_t now_ns();
+
+    // Appends to the ring buffer of the calling thread, the oldest events are overwritten when it is full
+    void record(const Event &event);
+
+    // Events of all threads, to be called when no thread is recording
+    void write_chrome_trace(const std::filesystem::path &path);
+
+    void clear();
+
+    // Records a complete event from construction to destruction
+    class Scope {
+    public:
+        explicit Scope(const char *name) : event{name, 'X', now_ns(), 0, {}, {}} {}
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() {
+            event.duration_ns = now_ns() - event.start_ns;
+            record(event);
+        }
+
+        // Arguments past MAX_ARGS are dropped
+        void arg(const char *name, int64_t value) {
+            for (uint32_t i = 0; i < MAX_ARGS; ++i) {
+                if (!event.arg_names[i] || event.arg_names[i] == name) {
+                    event.arg_names[i] = name;
+                    event.args[i] = value;
+                    return;
+                }
+            }
+        }
+
+    private:
+        Event event;
+    };
+
+    struct NoScope {
+        void arg(const char *, int64_t) {}
+    };
+
+    inline void counter(const char *name, int64_t value) {
+        record(Event{name, 'C', now_ns(), 0, {name, nullptr}, {value, 0}});
+    }
+}// namespace algos::trace
+
+#if defined(ALGOS_TRACE)
+#define ALGOS_TRACE_SCOPE(var, name) ::algos::trace::Scope var(name)
+#define ALGOS_TRACE_COUNTER(name, value) ::algos::trace::counter(name, static_cast<int64_t>(value))
+#else
+#define ALGOS_TRACE_SCOPE(var, name) [[maybe_unused]] ::algos::trace::NoScope var
+#define ALGOS_TRACE_COUNTER(name, value) ((void) 0)
+#endif
@@ -1,14 +1,69 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace algos {
     struct Tree {
-        uint n;
-        // parent[i] = -1 if i is root
-        std::vector<int> parent;
-        uint64_t weight;
+        uint64_t n;
+        // parent[i] = -1 if i is root, 64-bit so that graphs with 64-bit vertex ids fit
+        std::vector<int64_t> parent;
+        // sum of edge weights, exact for integer totals below 2^53
+        double weight;
 
-        Tree(uint n, std::vector<int> parent, uint64_t w) : n(n), parent(std::move(parent)), weight(w) {}
+        Tree(uint64_t n, std::vector<int64_t> parent, double w) : n(n), parent(std::move(parent)), weight(w) {}
+
+        // Parents of the algorithms with 32-bit vertex ids
+        Tree(uint64_t n, const std::vector<int> &parent, double w) : Tree(n, std::vector<int64_t>(parent.begin(), parent.end()), w) {}
     };
+
+    // Orients an undirected forest given by its edge list into parent[0 .. n), the smallest vertex of every
+    // tree becomes the root
+    template<typename Parents>
+    void orient_forest(uint32_t n, const std::vector<std::pair<uint32_t, uint32_t>> &edges, Parents &&parent) {
+        std::vector<uint32_t> offsets(n + 1, 0);
+        for (const auto &[u, v]: edges) {
+            offsets[u + 1]++;
+            offsets[v + 1]++;
+        }
+        for (uint32_t v = 0; v < n; ++v) {
+            offsets[v + 1] += offsets[v];
+        }
+        std::vector<uint32_t> adj(offsets[n]);
+        std::vector<uint32_t> pos(offsets.begin(), offsets.end() - 1);
+        for (const auto &[u, v]: edges) {
+            adj[pos[u]++] = v;
+            adj[pos[v]++] = u;
+        }
+
+        std::vector<bool> visited(n, false);
+        std::vector<uint32_t> queue;
+        queue.reserve(n);
+        for (uint32_t root = 0; root < n; ++root) {
+            if (visited[root]) continue;
+            visited[root] = true;
+            parent[root] = -1;
+            queue.clear();
+            queue.push_back(root);
+            for (size_t head = 0; head < queue.size(); ++head) {
+                const uint32_t u = queue[head];
+                for (uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+                    const uint32_t v = adj[e];
+                    if (!visited[v]) {
+                        visited[v] = true;
+                        parent[v] = u;
+                        queue.push_back(v);
+                    }
+                }
+            }
+        }
+    }
+
+    inline Tree make_tree(uint32_t n, const std::vector<std::pair<uint32_t, uint32_t>> &edges, double weight) {
+        std::vector<int64_t> parent(n);
+        orient_forest(n, edges, parent);
+        return Tree{n, std::move(parent), weight};
+    }
 }// namespace algos
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include "weight_type.hpp"
+#include "graph_cache.hpp"
+#include "mtx_reader.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <system_error>
+
+namespace algos {
+    std::string to_string(WeightType type) {
+        switch (type) {
+            case WeightType::UInt8:
+                return "uint8";
+            case WeightType::UInt16:
+                return "uint16";
+            case WeightType::UInt32:
+                return "uint32";
+            case WeightType::UInt64:
+                return "uint64";
+            case WeightType::Int32:
+                return "int32";
+            case WeightType::Float:
+                return "float";
+            case WeightType::Double:
+                return "double";
+        }
+        return "unknown";
+    }
+
+    namespace {
+        std::filesystem::path sidecar_path(const std::filesystem::path &path) {
+            return std::filesystem::path(path.string() + ".wtype");
+        }
+
+        // Size and modification time of the .mtx file, a sidecar written for another version of it is ignored
+        std::string file_stamp(const std::filesystem::path &path) {
+            std::error_code ec;
+            const auto size = std::filesystem::file_size(path, ec);
+            if (ec) return {};
+            const auto mtime = std::filesystem::last_write_time(path, ec);
+            if (ec) return {};
+            return std::to_string(size) + " " + std::to_string(mtime.time_since_epoch().count());
+        }
+
+        bool read_sidecar(const std::filesystem::path &path, const std::string &stamp, WeightType &type) {
+            std::ifstream in(sidecar_path(path));
+            std::string size, mtime, name;
+            if (stamp.empty() || !(in >> size >> mtime >> name) || size + " " + mtime != stamp) {
+                return false;
+            }
+            for (auto candidate: {WeightType::UInt8, WeightType::UInt16, WeightType::UInt32, WeightType::UInt64,
+                                  WeightType::Int32, WeightType::Float, WeightType::Double}) {
+                if (to_string(candidate) == name) {
+                    type = candidate;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Best effort, the directory of the graph may be read-only
+        void write_sidecar(const std::filesystem::path &path, const std::string &stamp, WeightType type) {
+            if (stamp.empty()) return;
+            std::ofstream out(sidecar_path(path));
+            out << stamp << " " << to_string(type) << "\n";
+        }
+
+        WeightType scan_weight_type(const std::filesystem::path &path) {
+            GraphInput input(path);
+            if (!input.is_open()) {
+                throw std::runtime_error("Failed to open file: " + path.string());
+            }
+            const MtxHeader header = read_mtx_header(input);
+            if (header.field == MtxField::Pattern || header.nnz == 0) {
+                return WeightType::UInt8;
+            }
+
+            WeightRange range;
+            int64_t u, v;
+            long double w;
+            for (int64_t i = 0; i < header.nnz; ++i) {
+                if (!(input >> u >> v >> w)) {
+                    throw std::runtime_error("Invalid mtx format, missing edge weight");
+                }
+                range.add(w);
+            }
+            return range.narrowest();
+        }
+    }// namespace
+
+    void WeightRange::add(long double w) {
+        if (empty || w < min_w) min_w = w;
+        if (empty || w > max_w) max_w = w;
+        empty = false;
+        integral &= w == std::floor(w);
+        fits_float &= static_cast<long double>(static_cast<float>(w)) == w;
+    }
+
+    WeightType WeightRange::narrowest() const {
+        if (integral) {
+            if (min_w < 0) {
+                if (min_w >= std::numeric_limits<int32_t>::min() && max_w <= std::numeric_limits<int32_t>::max()) {
+                    return WeightType::Int32;
+                }
+                return WeightType::Double;
+            }
+            if (max_w <= std::numeric_limits<uint8_t>::max()) return WeightType::UInt8;
+            if (max_w <= std::numeric_limits<uint16_t>::max()) return WeightType::UInt16;
+            if (max_w <= std::numeric_limits<uint32_t>::max()) return WeightType::UInt32;
+            if (max_w <= static_cast<long double>(std::numeric_limits<uint64_t>::max())) return WeightType::UInt64;
+        }
+        return fits_float ? WeightType::Float : WeightType::Double;
+    }
+
+    WeightType detect_weight_type(const std::filesystem::path &path) {
+        if (const auto cached = GraphCache::instance().find<WeightType>(path)) {
+            return *cached;
+        }
+        const std::string stamp = file_stamp(path);
+        WeightType type;
+        if (read_sidecar(path, stamp, type)) {
+            return type;
+        }
+        type = scan_weight_type(path);
+        write_sidecar(path, stamp, type);
+        return type;
+    }
+}// namespace algos
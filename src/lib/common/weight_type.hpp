@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+namespace algos {
+    // Edge weight types the MST algorithms are instantiated for
+    enum class WeightType {
+        UInt8,
+        UInt16,
+        UInt32,
+        UInt64,
+        Int32,
+        Float,
+        Double
+    };
+
+    std::string to_string(WeightType type);
+
+    // Range and kind of the weights seen so far, for picking the type of weights read in a wider one
+    class WeightRange {
+    public:
+        void add(long double w);
+
+        // Narrowest type able to hold every added weight, UInt8 without any
+        [[nodiscard]] WeightType narrowest() const;
+
+    private:
+        // long double keeps 64-bit integers exact
+        long double min_w = 0, max_w = 0;
+        bool empty = true;
+        bool integral = true;
+        bool fits_float = true;
+    };
+
+    // Narrowest weight type able to hold every weight of the .mtx file. The first call scans the whole file and
+    // stores the result next to it in <file>.wtype, later calls only read that while the file keeps its size and
+    // modification time
+    WeightType detect_weight_type(const std::filesystem::path &path);
+
+    // Calls f.template operator()<W>() with the C++ type matching the runtime weight type
+    template<typename F>
+    decltype(auto) visit_weight_type(WeightType type, F &&f) {
+        switch (type) {
+            case WeightType::UInt8:
+                return f.template operator()<uint8_t>();
+            case WeightType::UInt16:
+                return f.template operator()<uint16_t>();
+            case WeightType::UInt32:
+                return f.template operator()<uint32_t>();
+            case WeightType::UInt64:
+                return f.template operator()<uint64_t>();
+            case WeightType::Int32:
+                return f.template operator()<int32_t>();
+            case WeightType::Float:
+                return f.template operator()<float>();
+            case WeightType::Double:
+                return f.template operator()<double>();
+        }
+        throw std::invalid_argument("Unknown weight type");
+    }
+}// namespace algos
@@ -1,5 +1,6 @@
+#include "common/graph_input.hpp"
+
 #include <filesystem>
-#include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
@@ -13,7 +14,7 @@ namespace algos {
         template<typename Vt, typename Et, typename Wt>
         void load_mtx_coo(const std::filesystem::path &path, std::vector<Vt> &rows,
                           std::vector<Vt> &cols, std::vector<Wt> &vals) {
-            std::ifstream in(path);
+            GraphInput in(path);
             if (!in)
                 throw std::runtime_error("Cannot open MTX file: " + path.string());
 
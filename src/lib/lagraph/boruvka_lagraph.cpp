@@ -1,85 +1,168 @@
 #include "boruvka_lagraph.hpp"
+#include "common/mtx_reader.hpp"
+#include "common/trace.hpp"
+#include "grb_weight.hpp"
+#include "lagraph_init.hpp"
 
 #include "GraphBLAS.h"
 #include <LAGraphX.h>
+#include <algorithm>
 #include <chrono>
-#include <fstream>
 #include <functional>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 
 namespace algos {
 
     using clock = std::chrono::steady_clock;
 
-    void BoruvkaLagraph::load_graph(const std::filesystem::path &file_path) {
-        std::ifstream file(file_path);
-        if (!file.is_open()) {
-            throw std::runtime_error("Failed to open file: " + file_path.string());
+    template<typename W>
+    void BoruvkaLagraph<W>::load_graph(const std::filesystem::path &file_path) {
+        GraphInput file;
+        // GraphBLAS indices are 64-bit, so are the vertex ids read here
+        const MtxHeader header = open_mtx_graph(file_path, file, std::numeric_limits<int64_t>::max());
+
+        init_lagraph();
+
+        const auto n = static_cast<GrB_Index>(header.n_rows);
+        weight_shift = 0;
+        weight_by_rank.clear();
+        GrB_Matrix_free(&matrix);
+
+        if constexpr (std::is_floating_point_v<W>) {
+            // LAGraph_msf orders edges by UINT64 values, so real weights are replaced by their ranks
+            std::vector<std::tuple<GrB_Index, GrB_Index, W>> triples(header.nnz);
+            for (auto &[row, col, w]: triples) {
+                file >> row >> col;
+                w = read_mtx_weight<W>(file, header.field);
+                weight_by_rank.push_back(w);
+            }
+            std::ranges::sort(weight_by_rank);
+            weight_by_rank.erase(std::unique(weight_by_rank.begin(), weight_by_rank.end()), weight_by_rank.end());
+
+            GrB_Matrix_new(&matrix, GrB_UINT32, n, n);
+            for (const auto &[row, col, w]: triples) {
+                const auto rank = static_cast<uint32_t>(std::ranges::lower_bound(weight_by_rank, w) - weight_by_rank.begin());
+                GrB_Matrix_setElement_UINT32(matrix, rank, row - 1, col - 1);
+                GrB_Matrix_setElement_UINT32(matrix, rank, col - 1, row - 1);
+            }
+        } else {
+            GrB_Matrix_new(&matrix, GrbWeight<W>::type(), n, n);
+
+            for (int64_t i = 0; i < header.nnz; i++) {
+                int64_t row, col;
+                file >> row >> col;
+                const W w = read_mtx_weight<W>(file, header.field);
+
+                row--;
+                col--;
+
+                GrbWeight<W>::set(matrix, w, row, col);
+                GrbWeight<W>::set(matrix, w, col, row);
+                if constexpr (std::is_signed_v<W>) {
+                    weight_shift = std::min<int64_t>(weight_shift, w);
+                }
+            }
         }
 
-        std::string line;
-        // Skip comments
-        while (std::getline(file, line)) {
-            if (line[0] != '%') break;
+        // LAGraph_msf without sanitizing expects a symmetric UINT64 matrix. The keys are built here once,
+        // so that compute times only LAGraph_msf, and the narrow matrix is released
+        if constexpr (!std::is_same_v<W, uint64_t>) {
+            GrB_Matrix keys = nullptr;
+            GrB_Matrix_new(&keys, GrB_UINT64, n, n);
+            if (weight_shift < 0) {
+                GrB_Matrix_apply_BinaryOp2nd_INT64(keys, GrB_NULL, GrB_NULL, GrB_MINUS_INT64, matrix, weight_shift, GrB_NULL);
+            } else {
+                GrB_Matrix_apply(keys, GrB_NULL, GrB_NULL, GrB_IDENTITY_UINT64, matrix, GrB_NULL);
+            }
+            GrB_Matrix_free(&matrix);
+            matrix = keys;
         }
-
-        int n_rows, n_cols, nnz;
-        std::istringstream iss(line);
-        iss >> n_rows >> n_cols >> nnz;
-
-        if (n_rows != n_cols) {
-            throw std::runtime_error("Matrix must be square");
-        }
-
-        GrB_init(GrB_NONBLOCKING);
-
-        GrB_Matrix_new(&matrix, GrB_UINT64, n_rows, n_cols);
-
-        for (int i = 0; i < nnz; i++) {
-            int row, col;
-            uint64_t weight;
-            file >> row >> col >> weight;
-
-            row--;
-            col--;
-
-            GrB_Matrix_setElement_UINT64(matrix, weight, row, col);
-            GrB_Matrix_setElement_UINT64(matrix, weight, col, row);
-        }
-        num_vertices = n_rows;
+        num_vertices = n;
     }
 
-    std::chrono::milliseconds BoruvkaLagraph::compute() {
+    template<typename W>
+    std::chrono::milliseconds BoruvkaLagraph<W>::compute() {
         const auto start = clock::now();
         compute_();
         const auto end = clock::now();
         return std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     }
 
-    void BoruvkaLagraph::compute_() {
-        LAGraph_msf(&mst_matrix, matrix, false, msg);
+    template<typename W>
+    void BoruvkaLagraph<W>::compute_() {
+        GrB_Matrix_free(&mst_matrix);
+        {
+            ALGOS_TRACE_SCOPE(msf, "LAGraph_msf");
+            LAGraph_msf(&mst_matrix, matrix, false, msg);
+        }
 
-        GrB_Matrix_reduce_UINT64(
-                &weight,
-                GrB_NULL,
-                GrB_PLUS_MONOID_UINT64,
-                mst_matrix,
-                GrB_NULL);
+        if constexpr (std::is_floating_point_v<W>) {
+            GrB_Index nvals;
+            GrB_Matrix_nvals(&nvals, mst_matrix);
+            std::vector<uint64_t> ranks(nvals);
+            GrB_Matrix_extractTuples_UINT64(GrB_NULL, GrB_NULL, ranks.data(), &nvals, mst_matrix);
+            weight = 0;
+            for (GrB_Index i = 0; i < nvals; i++) {
+                weight += weight_by_rank[ranks[i]];
+            }
+        } else {
+            uint64_t key_sum = 0;
+            GrB_Matrix_reduce_UINT64(
+                    &key_sum,
+                    GrB_NULL,
+                    GrB_PLUS_MONOID_UINT64,
+                    mst_matrix,
+                    GrB_NULL);
+            GrB_Index nvals;
+            GrB_Matrix_nvals(&nvals, mst_matrix);
+            weight = static_cast<double>(key_sum) + static_cast<double>(weight_shift) * static_cast<double>(nvals);
+        }
     }
 
-    // Replace complex function with simple stub
-    Tree BoruvkaLagraph::get_result() {
-        // Create a placeholder result
-        std::vector<int> parent(num_vertices, -1);
+    template<typename W>
+    Tree BoruvkaLagraph<W>::get_result() {
+        TreeSink sink;
+        write_result(sink);
+        return sink.take();
+    }
 
-        // Simple parent array where each node points to previous node except node 0
-        for (uint i = 1; i < num_vertices; i++) {
-            parent[i] = i - 1;
+    template<typename W>
+    void BoruvkaLagraph<W>::write_result(ResultSink &sink) {
+        if (num_vertices > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Forests of more than 2^32 - 1 vertices can not be oriented");
         }
-
-        GrB_Matrix_free(&mst_matrix);
-        return Tree{num_vertices, parent, weight};
+        // The forest holds the keys of its edges, they are turned back into the weights
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        std::vector<double> edge_weights;
+        if (mst_matrix) {
+            GrB_Index nvals;
+            GrB_Matrix_nvals(&nvals, mst_matrix);
+            std::vector<GrB_Index> rows(nvals), cols(nvals);
+            std::vector<uint64_t> keys(nvals);
+            GrB_Matrix_extractTuples_UINT64(rows.data(), cols.data(), keys.data(), &nvals, mst_matrix);
+            edges.reserve(nvals);
+            edge_weights.reserve(nvals);
+            for (GrB_Index i = 0; i < nvals; i++) {
+                edges.emplace_back(static_cast<uint32_t>(rows[i]), static_cast<uint32_t>(cols[i]));
+                if constexpr (std::is_floating_point_v<W>) {
+                    edge_weights.push_back(static_cast<double>(weight_by_rank[keys[i]]));
+                } else {
+                    edge_weights.push_back(static_cast<double>(keys[i]) + static_cast<double>(weight_shift));
+                }
+            }
+        }
+        export_forest(static_cast<uint32_t>(num_vertices), edges, edge_weights, weight, sink);
     }
+
+    template class BoruvkaLagraph<uint8_t>;
+    template class BoruvkaLagraph<uint16_t>;
+    template class BoruvkaLagraph<uint32_t>;
+    template class BoruvkaLagraph<uint64_t>;
+    template class BoruvkaLagraph<int32_t>;
+    template class BoruvkaLagraph<float>;
+    template class BoruvkaLagraph<double>;
 }// namespace algos
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <LAGraph.h>
 
 namespace algos {
+    template<typename W = uint64_t>
     class BoruvkaLagraph : public MstAlgorithm {
 
     public:
@@ -14,13 +15,20 @@ namespace algos {
 
         Tree get_result() final;
 
+        void write_result(ResultSink &sink) final;
+
     private:
         void compute_();
 
         char msg[LAGRAPH_MSG_LEN];
-        uint64_t weight = 0;
+        double weight = 0;
+        // integer weights are shifted by it to get the non-negative keys LAGraph_msf needs
+        int64_t weight_shift = 0;
+        // real weights are stored as ranks, weight_by_rank[r] - weight of rank r
+        std::vector<W> weight_by_rank;
+        // UINT64 keys of the edges, the weights shifted or replaced by their ranks
         GrB_Matrix matrix = nullptr;
         GrB_Matrix mst_matrix = nullptr;
-        uint num_vertices = 0;
+        GrB_Index num_vertices = 0;
     };
 }// namespace algos
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "common/connected_components_algorithm.hpp"
+
+#include "GraphBLAS.h"
+#include <LAGraph.h>
+#include <vector>
+
+namespace algos {
+    // LAGr_ConnectedComponents, which runs FastSV over GraphBLAS
+    class ConnectedComponentsLagraph : public ConnectedComponentsAlgorithm {
+
+    public:
+        ~ConnectedComponentsLagraph() override;
+
+        void load_graph(const std::filesystem::path &file_path) final;
+
+        std::chrono::milliseconds compute() final;
+
+        Components get_result() final;
+
+    private:
+        void compute_();
+
+        char msg[LAGRAPH_MSG_LEN];
+        GrB_Matrix matrix = nullptr;
+        uint32_t n = 0;
+        std::vector<uint32_t> label;
+    };
+}// namespace algos
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "GraphBLAS.h"
+#include <cstdint>
+
+namespace algos {
+    // GraphBLAS type and typed setter for an edge weight type
+    template<typename W>
+    struct GrbWeight;
+
+#define ALGOS_GRB_WEIGHT(CTYPE, GRB_TYPE, SUFFIX)                                         \
+    template<>                                                                             \
+    struct GrbWeight<CTYPE> {                                                              \
+        static GrB_Type type() { return GRB_TYPE; }                                        \
+        static GrB_Info set(GrB_Matrix m, CTYPE w, GrB_Index i, GrB_Index j) {             \
+            return GrB_Matrix_setElement_##SUFFIX(m, w, i, j);                             \
+        }                                                                                  \
+    };
+
+    ALGOS_GRB_WEIGHT(uint8_t, GrB_UINT8, UINT8)
+    ALGOS_GRB_WEIGHT(uint16_t, GrB_UINT16, UINT16)
+    ALGOS_GRB_WEIGHT(uint32_t, GrB_UINT32, UINT32)
+    ALGOS_GRB_WEIGHT(uint64_t, GrB_UINT64, UINT64)
+    ALGOS_GRB_WEIGHT(int32_t, GrB_INT32, INT32)
+    ALGOS_GRB_WEIGHT(float, GrB_FP32, FP32)
+    ALGOS_GRB_WEIGHT(double, GrB_FP64, FP64)
+
+#undef ALGOS_GRB_WEIGHT
+}// namespace algos
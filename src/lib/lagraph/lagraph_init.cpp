@@ -0,0 +1,18 @@
+#include "lagraph_init.hpp"
+
+#include <LAGraph.h>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace algos {
+    void init_lagraph() {
+        static std::once_flag once;
+        std::call_once(once, [] {
+            char msg[LAGRAPH_MSG_LEN];
+            if (LAGraph_Init(msg) != GrB_SUCCESS) {
+                throw std::runtime_error(std::string("LAGraph initialization failed: ") + msg);
+            }
+        });
+    }
+}// namespace algos
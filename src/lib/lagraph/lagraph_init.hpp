@@ -0,0 +1,7 @@
+#pragma once
+
+namespace algos {
+    // Initializes GraphBLAS and LAGraph on the first call, later calls return at once. Safe to call from
+    // several threads, e.g. from the workers of run_batch
+    void init_lagraph();
+}// namespace algos
@@ -1,51 +1,40 @@
 #include "parent_bfs_lagraph.hpp"
+#include "common/mtx_reader.hpp"
+#include "common/trace.hpp"
+#include "lagraph_init.hpp"
 #include "GraphBLAS.h"
 #include <LAGraph.h>
 #include <chrono>
-#include <fstream>
 #include <functional>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 
 namespace algos {
     void ParentBfsLagraph::load_graph(const std::filesystem::path &file_path) {
-        std::ifstream file(file_path);
-        if (!file.is_open()) {
-            throw std::runtime_error("Failed to open file: " + file_path.string());
-        }
-
-        std::string line;
-        // Skip comments
-        while (std::getline(file, line)) {
-            if (line[0] != '%') break;
-        }
-
-        int n_rows, n_cols, nnz;
-        std::istringstream iss(line);
-        iss >> n_rows >> n_cols >> nnz;
-        n = n_rows;
-
-        if (n_rows != n_cols) {
-            throw std::runtime_error("Matrix must be square");
-        }
+        GraphInput file;
+        // GraphBLAS indices are 64-bit, so are the vertex ids read here
+        const MtxHeader header = open_mtx_graph(file_path, file, std::numeric_limits<int64_t>::max());
+        n = static_cast<GrB_Index>(header.n_rows);
 
-        LAGraph_Init(msg);
-        GrB_init(GrB_NONBLOCKING);
-
-        GrB_Matrix_new(&matrix, GrB_BOOL, n_rows, n_cols);
-        p = std::vector<int>(n, -1);
-
-        for (int i = 0; i < nnz; i++) {
-            int row, col;
-            file >> row >> col;
+        init_lagraph();
+        LAGraph_Delete(&G, msg);
 
-            row--;
-            col--;
+        GrB_Matrix_new(&matrix, GrB_BOOL, n, n);
+        p = std::vector<int64_t>(n, -1);
 
+        for_each_mtx_edge<NoWeight, GrB_Index>(file, header, [this](GrB_Index row, GrB_Index col, NoWeight) {
             GrB_Matrix_setElement_BOOL(matrix, true, row, col);
             GrB_Matrix_setElement_BOOL(matrix, true, col, row);
-        }
+        });
+        // The graph takes the matrix over and is kept for every compute, e.g. one per root
+        LAGraph_New(&G, &matrix, LAGraph_ADJACENCY_UNDIRECTED, msg);
+        seeds.clear();
+    }
+
+    ParentBfsLagraph::~ParentBfsLagraph() {
+        LAGraph_Delete(&G, msg);
     }
 
     using clock = std::chrono::steady_clock;
@@ -58,42 +47,52 @@ namespace algos {
     }
 
     void ParentBfsLagraph::compute_() {
-        GrB_Vector_new(&level, GrB_INT32, n);
-        GrB_Vector_new(&parent, GrB_INT32, n);
-        LAGraph_New(&G, &matrix, LAGraph_ADJACENCY_UNDIRECTED, msg);
-
-        //        LAGraph_Graph_Print(G, static_cast<LAGraph_PrintLevel>(2), stdout, msg);
-
-        for (int i = 0; i < n; i++) {
-            if (p[i] == -1) {
-                LAGr_BreadthFirstSearch(nullptr, &parent, G, i, msg);
-                GrB_Index nvals;
-                GrB_Vector_nvals(&nvals, parent);
-                auto *indices = static_cast<GrB_Index *>(malloc(nvals * sizeof(GrB_Index)));
-                auto *values = static_cast<int32_t *>(malloc(nvals * sizeof(int32_t)));
-                GrB_Vector_extractTuples_INT32(indices, values, &nvals, parent);
-                for (GrB_Index j = 0; j < nvals; j++) {
-                    p[indices[j]] = values[j];
-                }
+        if (root && *root >= n) {
+            throw std::runtime_error("Root vertex out of range");
+        }
+        p.assign(n, -1);
+        GrB_Index visited = 0;
+        const auto search_from = [&](GrB_Index source) {
+            ALGOS_TRACE_SCOPE(search, "LAGr_BreadthFirstSearch");
+            LAGr_BreadthFirstSearch(nullptr, &parent, G, source, msg);
+            GrB_Index nvals;
+            GrB_Vector_nvals(&nvals, parent);
+            auto *indices = static_cast<GrB_Index *>(malloc(nvals * sizeof(GrB_Index)));
+            // The parents are INT64 for more than 2^31 vertices, INT32 otherwise, both are read as INT64
+            auto *values = static_cast<int64_t *>(malloc(nvals * sizeof(int64_t)));
+            GrB_Vector_extractTuples_INT64(indices, values, &nvals, parent);
+            for (GrB_Index j = 0; j < nvals; j++) {
+                p[indices[j]] = values[j];
             }
+            visited += nvals;
+            free(indices);
+            free(values);
+            GrB_Vector_free(&parent);
+        };
+
+        if (root) {
+            search_from(*root);
+            return;
+        }
+        // One search per seed, the vertices are only scanned when the seeds missed a component
+        for (const uint32_t v: seeds) {
+            if (v >= n) {
+                throw std::runtime_error("Seed vertex out of range");
+            }
+            if (p[v] == -1) search_from(v);
+        }
+        for (GrB_Index i = 0; i < n && visited < n; i++) {
+            if (p[i] == -1) search_from(i);
         }
-
-        GrB_Matrix_free(&matrix);
-        LAGraph_Delete(&G, msg);
-        GrB_Vector_free(&level);
-        GrB_Vector_free(&parent);
-
-        GrB_finalize();
-        LAGraph_Finalize(msg);
     }
 
     Tree ParentBfsLagraph::get_result() {
-        for (int i = 0; i < n; i++) {
-            if (p[i] == i) {
+        for (GrB_Index i = 0; i < n; i++) {
+            if (p[i] == static_cast<int64_t>(i)) {
                 p[i] = -1;
             }
         }
 
-        return Tree{static_cast<uint>(n), p, 0};
+        return Tree{n, p, 0};
     }
 }// namespace algos
\ No newline at end of file
@@ -9,6 +9,8 @@ namespace algos {
     class ParentBfsLagraph : public ParentBfsAlgorithm {
 
     public:
+        ~ParentBfsLagraph() override;
+
         void load_graph(const std::filesystem::path &file_path) final;
 
         std::chrono::milliseconds compute() final;
@@ -18,12 +20,11 @@ namespace algos {
     private:
         void compute_();
 
-        int n = 0;
+        GrB_Index n = 0;
         char msg[LAGRAPH_MSG_LEN];
-        GrB_Vector level = nullptr;
         GrB_Vector parent = nullptr;
         GrB_Matrix matrix = nullptr;
         LAGraph_Graph G = nullptr;
-        std::vector<int> p;
+        std::vector<int64_t> p;
     };
 }// namespace algos
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "shortest_path_lagraph.hpp"
+#include "common/trace.hpp"
+#include "lagraph_init.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+namespace algos {
+
+    using clock = std::chrono::steady_clock;
+
+    ShortestPathLagraph::~ShortestPathLagraph() {
+        LAGraph_Delete(&G, msg);
+    }
+
+    void ShortestPathLagraph::load_graph(const std::filesystem::path &file_path) {
+        graph = load_sssp_graph(file_path);
+
+        init_lagraph();
+        LAGraph_Delete(&G, msg);
+
+        // The CSR already holds both directions of every edge
+        std::vector<GrB_Index> rows(graph.edges()), cols(graph.cols.begin(), graph.cols.end());
+        for (uint32_t v = 0; v < graph.n; ++v) {
+            std::fill(rows.begin() + graph.offsets[v], rows.begin() + graph.offsets[v + 1], v);
+        }
+        GrB_Matrix matrix = nullptr;
+        GrB_Matrix_new(&matrix, GrB_FP64, graph.n, graph.n);
+        GrB_Matrix_build_FP64(matrix, rows.data(), cols.data(), graph.weights.data(), rows.size(), GrB_MIN_FP64);
+
+        // LAGraph_New takes the matrix over, the delta-stepping needs the cached minimum weight
+        LAGraph_New(&G, &matrix, LAGraph_ADJACENCY_UNDIRECTED, msg);
+        LAGraph_Cached_EMin(G, msg);
+    }
+
+    std::chrono::milliseconds ShortestPathLagraph::compute() {
+        const auto start = clock::now();
+        compute_();
+        const auto end = clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    }
+
+    void ShortestPathLagraph::compute_() {
+        if (source >= graph.n) {
+            throw std::runtime_error("Source vertex out of range");
+        }
+        GrB_Scalar delta = nullptr;
+        GrB_Scalar_new(&delta, GrB_FP64);
+        GrB_Scalar_setElement_FP64(delta, requested_delta > 0 ? requested_delta : choose_delta(graph));
+
+        GrB_Vector distance = nullptr;
+        ALGOS_TRACE_SCOPE(call, "LAGr_SingleSourceShortestPath");
+        const int info = LAGr_SingleSourceShortestPath(&distance, G, source, delta, msg);
+        GrB_Scalar_free(&delta);
+        if (info != GrB_SUCCESS) {
+            throw std::runtime_error(std::string("LAGr_SingleSourceShortestPath failed: ") + msg);
+        }
+
+        // Unreachable vertices are either missing or infinite in the result
+        GrB_Index nvals = graph.n;
+        std::vector<GrB_Index> indices(graph.n);
+        std::vector<double> values(graph.n);
+        GrB_Vector_extractTuples_FP64(indices.data(), values.data(), &nvals, distance);
+        dist.assign(graph.n, UNREACHABLE);
+        for (GrB_Index i = 0; i < nvals; ++i) {
+            dist[indices[i]] = values[i];
+        }
+        GrB_Vector_free(&distance);
+    }
+
+    ShortestPaths ShortestPathLagraph::get_result() {
+        return make_shortest_paths(graph, source, dist);
+    }
+}// namespace algos
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "common/csr_graph.hpp"
+#include "common/shortest_path_algorithm.hpp"
+
+#include "GraphBLAS.h"
+#include <LAGraph.h>
+#include <vector>
+
+namespace algos {
+    // LAGr_SingleSourceShortestPath, delta-stepping over the GraphBLAS min-plus semiring, with the delta
+    // of choose_delta. The CSR copy is kept to orient the shortest path tree
+    class ShortestPathLagraph : public ShortestPathAlgorithm {
+
+    public:
+        // 0 picks the delta from the weights with choose_delta
+        explicit ShortestPathLagraph(double delta = 0) : requested_delta(delta) {}
+
+        ~ShortestPathLagraph() override;
+
+        void load_graph(const std::filesystem::path &file_path) final;
+
+        std::chrono::milliseconds compute() final;
+
+        ShortestPaths get_result() final;
+
+    private:
+        void compute_();
+
+        char msg[LAGRAPH_MSG_LEN];
+        double requested_delta;
+        WeightedCsrGraph<double> graph;
+        LAGraph_Graph G = nullptr;
+        std::vector<double> dist;
+    };
+}// namespace algos
@@ -0,0 +1,100 @@
+#include "afforest_native.hpp"
+#include "common/scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+
+namespace algos {
+    namespace {
+        constexpr uint32_t SAMPLES = 1024;
+
+        uint32_t load(std::vector<uint32_t> &comp, uint32_t v) {
+            return std::atomic_ref<uint32_t>(comp[v]).load(std::memory_order_relaxed);
+        }
+
+        // Hooks the higher of the two roots under the lower one, retries while other threads move them
+        void link(uint32_t u, uint32_t v, std::vector<uint32_t> &comp) {
+            uint32_t p1 = load(comp, u), p2 = load(comp, v);
+            while (p1 != p2) {
+                const uint32_t high = std::max(p1, p2), low = std::min(p1, p2);
+                uint32_t p_high = load(comp, high);
+                if (p_high == low) break;
+                if (p_high == high &&
+                    std::atomic_ref<uint32_t>(comp[high]).compare_exchange_strong(p_high, low, std::memory_order_relaxed)) {
+                    break;
+                }
+                p1 = load(comp, load(comp, high));
+                p2 = load(comp, low);
+            }
+        }
+
+        // Points every vertex straight to its root
+        void compress(std::vector<uint32_t> &comp) {
+            parallel_for(0, static_cast<int64_t>(comp.size()), [&](int64_t v) {
+                uint32_t p = load(comp, v);
+                while (p != load(comp, p)) {
+                    p = load(comp, p);
+                }
+                std::atomic_ref<uint32_t>(comp[v]).store(p, std::memory_order_relaxed);
+            });
+        }
+
+        uint32_t most_frequent_label(const std::vector<uint32_t> &comp) {
+            std::mt19937 rng(42);
+            std::uniform_int_distribution<size_t> pick(0, comp.size() - 1);
+            std::unordered_map<uint32_t, uint32_t> counts;
+            for (uint32_t i = 0; i < SAMPLES; ++i) {
+                counts[comp[pick(rng)]]++;
+            }
+            return std::ranges::max_element(counts, {}, [](const auto &entry) { return entry.second; })->first;
+        }
+    }// namespace
+
+    using clock = std::chrono::steady_clock;
+
+    void AfforestNative::load_graph(const std::filesystem::path &file_path) {
+        graph = load_csr(file_path);
+    }
+
+    std::chrono::milliseconds AfforestNative::compute() {
+        const auto start = clock::now();
+        compute_();
+        const auto end = clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    }
+
+    void AfforestNative::compute_() {
+        const uint32_t n = graph.n;
+        comp.resize(n);
+        std::iota(comp.begin(), comp.end(), 0);
+        if (n == 0) return;
+
+        // Sparse sampling of the first edges of every vertex
+        for (uint32_t r = 0; r < neighbor_rounds; ++r) {
+            parallel_for(0, n, [&](int64_t u) {
+                if (r < graph.degree(u)) {
+                    link(u, graph.cols[graph.offsets[u] + r], comp);
+                }
+            });
+            compress(comp);
+        }
+
+        // Edges of the largest intermediate component are skipped, every edge leaving it is also
+        // stored at its other end, which is linked here
+        const uint32_t giant = most_frequent_label(comp);
+        parallel_for_edges(graph.offsets, n, [&](int64_t u) {
+            if (load(comp, u) == giant) return;
+            for (uint32_t e = graph.offsets[u] + std::min(neighbor_rounds, graph.degree(u)); e < graph.offsets[u + 1]; ++e) {
+                link(u, graph.cols[e], comp);
+            }
+        });
+        compress(comp);
+    }
+
+    Components AfforestNative::get_result() {
+        return make_components(comp);
+    }
+}// namespace algos
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "common/connected_components_algorithm.hpp"
+#include "common/csr_graph.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace algos {
+    // Afforest: links the first neighbour_rounds neighbours of every vertex, samples the most frequent
+    // label, which is the giant component on most graphs, and links the remaining edges of the other vertices only
+    class AfforestNative : public ConnectedComponentsAlgorithm {
+
+    public:
+        explicit AfforestNative(uint32_t neighbor_rounds = 2) : neighbor_rounds(neighbor_rounds) {}
+
+        void load_graph(const std::filesystem::path &file_path) final;
+
+        std::chrono::milliseconds compute() final;
+
+        Components get_result() final;
+
+    private:
+        void compute_();
+
+        uint32_t neighbor_rounds;
+        CsrGraph graph;
+        // comp[v] - parent of v in the union-find forest
+        std::vector<uint32_t> comp;
+    };
+}// namespace algos
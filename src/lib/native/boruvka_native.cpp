@@ -0,0 +1,304 @@
+#include "boruvka_native.hpp"
+#include "common/merge_path.hpp"
+#include "common/trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+namespace algos {
+
+    namespace {
+        // Weight rank of a dropped edge of compressed storage
+        constexpr uint32_t NO_RANK = UINT32_MAX;
+
+        // Edges with both ends in one component are dropped by replacing their keys with INF_KEY.
+        // CSR rows are split evenly over threads by merge path, compressed rows are decoded as a whole
+        void drop_internal_edges(const CsrGraph &g, const numa_vector<uint32_t> &offsets, const numa_vector<uint32_t> &comp,
+                                 numa_vector<uint64_t> &work) {
+            merge_path_for_each(offsets, static_cast<int64_t>(comp.size()), [&](int64_t v, int64_t begin, int64_t end) {
+                for (int64_t e = begin; e < end; ++e) {
+                    if (work[e] != INF_KEY && comp[g.cols[e]] == comp[v]) {
+                        work[e] = INF_KEY;
+                    }
+                }
+            });
+        }
+
+        // Compressed storage keeps only the weight ranks, dropped edges get NO_RANK
+        void drop_internal_edges(const CompressedGraph &g, const numa_vector<uint32_t> &offsets, const numa_vector<uint32_t> &comp,
+                                 numa_vector<uint32_t> &ranks) {
+            parallel_for_edges(offsets, static_cast<int64_t>(comp.size()), [&](int64_t v) {
+                uint32_t e = offsets[v];
+                g.for_each_neighbor(static_cast<uint32_t>(v), [&](uint32_t u) {
+                    if (ranks[e] != NO_RANK && comp[u] == comp[v]) {
+                        ranks[e] = NO_RANK;
+                    }
+                    ++e;
+                });
+            });
+        }
+
+        // row_min[v] - the smallest key of the live edges of v, the destinations are decoded from the compressed row
+        void row_min_keys(const CompressedGraph &g, const numa_vector<uint32_t> &offsets, const numa_vector<uint32_t> &ranks,
+                          numa_vector<uint64_t> &row_min) {
+            parallel_for_edges(offsets, static_cast<int64_t>(row_min.size()), [&](int64_t v) {
+                uint32_t e = offsets[v];
+                uint64_t res = INF_KEY;
+                g.for_each_neighbor(static_cast<uint32_t>(v), [&](uint32_t u) {
+                    if (ranks[e] != NO_RANK) {
+                        res = std::min(res, encode_edge_key(ranks[e], u));
+                    }
+                    ++e;
+                });
+                row_min[v] = res;
+            });
+        }
+
+        void atomic_min(uint64_t &x, uint64_t value) {
+            std::atomic_ref<uint64_t> ref(x);
+            uint64_t current = ref.load(std::memory_order_relaxed);
+            while (value < current && !ref.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+    }// namespace
+
+    using clock = std::chrono::steady_clock;
+
+    template<typename W>
+    void BoruvkaNative<W>::load_graph(const std::filesystem::path &file_path) {
+        graph = CsrGraph();
+        keys = numa_vector<uint64_t>();
+        ranks = numa_vector<uint32_t>();
+        edge_list = EdgeListGraph<uint32_t>();
+        compressed = CompressedGraph();
+
+        if (storage == GraphStorage::EdgeList) {
+            EdgeListGraph<W> g = load_edge_list<W>(file_path);
+            weight_by_rank = rank_weights<W>(g.weights);
+            n = g.n;
+            edge_list.n = g.n;
+            edge_list.src = std::move(g.src);
+            edge_list.dst = std::move(g.dst);
+            edge_list.weights.resize(g.weights.size());
+            for (size_t e = 0; e < g.weights.size(); ++e) {
+                edge_list.weights[e] = weight_rank(weight_by_rank, g.weights[e]);
+            }
+            return;
+        }
+
+        WeightedCsrGraph<W> g = load_weighted_csr<W>(file_path);
+        weight_by_rank = rank_weights<W>(g.weights);
+        keys.resize(g.edges());
+        for (uint32_t e = 0; e < g.edges(); ++e) {
+            keys[e] = encode_edge_key(weight_rank(weight_by_rank, g.weights[e]), g.cols[e]);
+        }
+        n = g.n;
+        graph = std::move(static_cast<CsrGraph &>(g));
+
+        if (storage == GraphStorage::Compressed) {
+            // Compressed rows are sorted, so are the keys of every row to keep ranks[e] and the e-th neighbour together.
+            // Only the ranks are kept, the destinations are decoded from the compressed rows
+            for (uint32_t v = 0; v < graph.n; ++v) {
+                const auto begin = keys.begin() + graph.offsets[v], end = keys.begin() + graph.offsets[v + 1];
+                std::sort(begin, end, [](uint64_t a, uint64_t b) { return edge_key_dest(a) < edge_key_dest(b); });
+            }
+            compressed = CompressedGraph::compress(graph);
+            ranks.resize(keys.size());
+            for (size_t e = 0; e < keys.size(); ++e) {
+                ranks[e] = edge_key_rank(keys[e]);
+            }
+            keys = numa_vector<uint64_t>();
+            graph.cols = numa_vector<uint32_t>();
+        }
+    }
+
+    template<typename W>
+    std::chrono::milliseconds BoruvkaNative<W>::compute() {
+        const auto start = clock::now();
+        compute_();
+        const auto end = clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    }
+
+    template<typename W>
+    void BoruvkaNative<W>::compute_() {
+        mst_edges.clear();
+        mst_weights.clear();
+        weight = 0;
+        if (storage == GraphStorage::EdgeList) {
+            compute_edge_list_();
+            return;
+        }
+
+        // comp, comp_min and comp_arg are looked up at random
+        const bool blocked = use_blocking(propagation, size_t{n} * 2 * sizeof(uint64_t));
+        if (blocked) {
+            component_bins.reset(n, propagation_block_shift(sizeof(uint64_t) + sizeof(uint32_t)));
+            edge_bins.reset(n, propagation_block_shift(sizeof(uint32_t)));
+        }
+
+        // Keys of the edges inside one component are replaced by INF_KEY, their ranks by NO_RANK for compressed storage
+        const bool compressed_rows = storage == GraphStorage::Compressed;
+        if (compressed_rows) {
+            rank_work.assign(ranks.begin(), ranks.end());
+        } else {
+            work.assign(keys.begin(), keys.end());
+        }
+        row_min.resize(n);
+        comp_min.resize(n);
+        comp_arg.resize(n);
+        comp.resize(n);
+        std::iota(comp.begin(), comp.end(), 0);
+        components.reset(n);
+
+        while (true) {
+            ALGOS_TRACE_SCOPE(round, "boruvka_round");
+            round.arg("components", n - mst_edges.size());
+            // Find the minimum edge for each vertex and then for each component
+            if (compressed_rows) {
+                row_min_keys(compressed, graph.offsets, rank_work, row_min);
+            } else {
+                row_min_keys(graph.offsets.data(), work.data(), n, row_min.data(), simd_level);
+            }
+            std::ranges::fill(comp_min, INF_KEY);
+            if (blocked) {
+                component_min_blocked_();
+            } else {
+                component_min_keys(row_min.data(), comp.data(), n, comp_min.data(), comp_arg.data());
+            }
+
+            // Add edges to MST and merge components, equal weights may close a cycle which is skipped
+            bool merged = false;
+            for (uint32_t c = 0; c < n; ++c) {
+                if (comp_min[c] == INF_KEY) continue;
+                const uint32_t src = comp_arg[c];
+                const uint32_t dest = edge_key_dest(comp_min[c]);
+                if (components.unite(src, dest)) {
+                    mst_edges.emplace_back(src, dest);
+                    mst_weights.push_back(static_cast<double>(weight_by_rank[edge_key_rank(comp_min[c])]));
+                    weight += mst_weights.back();
+                    merged = true;
+                }
+            }
+            if (!merged) break;
+
+            for (uint32_t v = 0; v < n; ++v) {
+                comp[v] = components.find(v);
+            }
+
+            // Drop the edges that became internal
+            if (blocked) {
+                drop_internal_edges_blocked_();
+            } else if (compressed_rows) {
+                drop_internal_edges(compressed, graph.offsets, comp, rank_work);
+            } else {
+                drop_internal_edges(graph, graph.offsets, comp, work);
+            }
+        }
+    }
+
+    template<typename W>
+    void BoruvkaNative<W>::component_min_blocked_() {
+        parallel_for(0, n, [this](int64_t v) {
+            if (row_min[v] != INF_KEY) {
+                component_bins.push(comp[v], {row_min[v], comp[v], static_cast<uint32_t>(v)});
+            }
+        });
+        // Ties go to the lower vertex as in component_min_keys
+        component_bins.apply([this](const ComponentCandidate &c) {
+            if (c.key < comp_min[c.comp] || (c.key == comp_min[c.comp] && c.vertex < comp_arg[c.comp])) {
+                comp_min[c.comp] = c.key;
+                comp_arg[c.comp] = c.vertex;
+            }
+        });
+    }
+
+    template<typename W>
+    void BoruvkaNative<W>::drop_internal_edges_blocked_() {
+        if (storage == GraphStorage::Compressed) {
+            parallel_for_edges(graph.offsets, n, [&](int64_t v) {
+                uint32_t e = graph.offsets[v];
+                compressed.for_each_neighbor(static_cast<uint32_t>(v), [&](uint32_t u) {
+                    if (rank_work[e] != NO_RANK) edge_bins.push(u, {u, comp[v], e});
+                    ++e;
+                });
+            });
+            edge_bins.apply([this](const EdgeCheck &c) {
+                if (comp[c.dest] == c.comp) rank_work[c.edge] = NO_RANK;
+            });
+            return;
+        }
+        const auto check = [this](int64_t v, uint32_t e, uint32_t u) {
+            if (work[e] != INF_KEY) edge_bins.push(u, {u, comp[v], e});
+        };
+        merge_path_for_each(graph.offsets, n, [&](int64_t v, int64_t begin, int64_t end) {
+            for (int64_t e = begin; e < end; ++e) {
+                check(v, static_cast<uint32_t>(e), graph.cols[e]);
+            }
+        });
+        edge_bins.apply([this](const EdgeCheck &c) {
+            if (comp[c.dest] == c.comp) work[c.edge] = INF_KEY;
+        });
+    }
+
+    template<typename W>
+    void BoruvkaNative<W>::compute_edge_list_() {
+        // Edges still joining two components, keys are (weight rank, edge) so that ties follow the edge order
+        live.resize(edge_list.edges());
+        std::iota(live.begin(), live.end(), 0);
+        comp_min.resize(n);
+        comp.resize(n);
+        std::iota(comp.begin(), comp.end(), 0);
+        components.reset(n);
+
+        while (true) {
+            ALGOS_TRACE_SCOPE(round, "boruvka_round");
+            round.arg("components", n - mst_edges.size());
+            round.arg("edges_remaining", live.size());
+            std::ranges::fill(comp_min, INF_KEY);
+            parallel_for(0, static_cast<int64_t>(live.size()), [&](int64_t i) {
+                const uint32_t e = live[i];
+                const uint64_t key = encode_edge_key(edge_list.weights[e], e);
+                atomic_min(comp_min[comp[edge_list.src[e]]], key);
+                atomic_min(comp_min[comp[edge_list.dst[e]]], key);
+            });
+
+            // Both components of an edge may pick it, the second unite fails
+            bool merged = false;
+            for (uint32_t c = 0; c < n; ++c) {
+                if (comp_min[c] == INF_KEY) continue;
+                const uint32_t e = edge_key_dest(comp_min[c]);
+                if (components.unite(edge_list.src[e], edge_list.dst[e])) {
+                    mst_edges.emplace_back(edge_list.src[e], edge_list.dst[e]);
+                    mst_weights.push_back(static_cast<double>(weight_by_rank[edge_key_rank(comp_min[c])]));
+                    weight += mst_weights.back();
+                    merged = true;
+                }
+            }
+            if (!merged) break;
+
+            for (uint32_t v = 0; v < n; ++v) {
+                comp[v] = components.find(v);
+            }
+            std::erase_if(live, [&](uint32_t e) { return comp[edge_list.src[e]] == comp[edge_list.dst[e]]; });
+        }
+    }
+
+    template<typename W>
+    Tree BoruvkaNative<W>::get_result() {
+        return make_tree(n, mst_edges, weight);
+    }
+
+    template<typename W>
+    void BoruvkaNative<W>::write_result(ResultSink &sink) {
+        export_forest(n, mst_edges, mst_weights, weight, sink);
+    }
+
+    template class BoruvkaNative<uint8_t>;
+    template class BoruvkaNative<uint16_t>;
+    template class BoruvkaNative<uint32_t>;
+    template class BoruvkaNative<uint64_t>;
+    template class BoruvkaNative<int32_t>;
+    template class BoruvkaNative<float>;
+    template class BoruvkaNative<double>;
+}// namespace algos
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "common/compressed_graph.hpp"
+#include "common/csr_graph.hpp"
+#include "common/disjoint_set.hpp"
+#include "common/mst_algorithm.hpp"
+#include "common/propagation_blocking.hpp"
+#include "native/min_edge_kernel.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace algos {
+    // Borůvka over CSR without a sparse linear algebra backend, the lightest edge of every
+    // vertex is found by the SIMD row-min kernel over (weight rank, dest) keys. With compressed
+    // storage only the weight ranks and the varint encoded neighbour lists are kept, the rows are
+    // decoded to find the lightest edges and to drop internal ones.
+    // With edge list storage every edge is kept once and the lightest edge of every component is found
+    // by a pass over the edges still joining two components. With blocked propagation the component
+    // minima and the label checks of the edges go through bins by component and destination block
+    template<typename W = uint32_t>
+    class BoruvkaNative : public MstAlgorithm {
+
+    public:
+        explicit BoruvkaNative(GraphStorage storage = GraphStorage::Csr, Propagation propagation = Propagation::Auto)
+            : storage(storage), propagation(propagation) {}
+
+        void load_graph(const std::filesystem::path &file_path) final;
+
+        std::chrono::milliseconds compute() final;
+
+        Tree get_result() final;
+
+        void write_result(ResultSink &sink) final;
+
+    private:
+        void compute_();
+
+        void compute_edge_list_();
+
+        // comp_min and comp_arg from row_min through bins by component
+        void component_min_blocked_();
+
+        // Drops internal edges through bins by destination, comp[dest] is looked up block by block
+        void drop_internal_edges_blocked_();
+
+        struct ComponentCandidate {
+            uint64_t key;
+            uint32_t comp;
+            uint32_t vertex;
+        };
+
+        struct EdgeCheck {
+            uint32_t dest;
+            uint32_t comp;
+            uint32_t edge;
+        };
+
+        GraphStorage storage;
+        Propagation propagation;
+        uint32_t n = 0;
+        SimdLevel simd_level = detect_simd_level();
+        // graph.cols is released for compressed storage, rows of compressed follow the order of keys
+        CsrGraph graph;
+        CompressedGraph compressed;
+        // keys[e] - encoded key of the edge graph.cols[e], released for compressed storage
+        numa_vector<uint64_t> keys;
+        // ranks[e] - weight rank of the e-th neighbour of the compressed rows
+        numa_vector<uint32_t> ranks;
+        // edge_list.weights[e] - weight rank of the edge, used instead of graph and keys for edge list storage
+        EdgeListGraph<uint32_t> edge_list;
+        std::vector<W> weight_by_rank;
+        // Scratch arrays of compute, kept between runs so that a reused instance does not allocate them again
+        numa_vector<uint64_t> work, row_min, comp_min;
+        numa_vector<uint32_t> comp, comp_arg, live, rank_work;
+        DisjointSet components;
+        PropagationBins<ComponentCandidate> component_bins;
+        PropagationBins<EdgeCheck> edge_bins;
+        std::vector<std::pair<uint32_t, uint32_t>> mst_edges;
+        // weight of every edge of mst_edges
+        std::vector<double> mst_weights;
+        double weight = 0;
+    };
+}// namespace algos
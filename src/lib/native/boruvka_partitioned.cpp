@@ -0,0 +1,251 @@
+#include "boruvka_partitioned.hpp"
+#include "common/disjoint_set.hpp"
+#include "common/mtx_reader.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+#include <tuple>
+
+namespace algos {
+    namespace {
+        enum class Command : uint32_t {
+            Edges,
+            Loaded,
+            Round,
+            Shutdown
+        };
+
+        template<typename W>
+        struct Edge {
+            uint32_t u;
+            uint32_t v;
+            W w;
+        };
+
+        // Component `from` was merged into `to` in the last round
+        struct Relabel {
+            uint32_t from;
+            uint32_t to;
+        };
+
+        // Edges sent to a worker in one message while the graph is loaded
+        constexpr size_t EDGE_BATCH = 1 << 16;
+
+        // Total order of the edges, ties of equal weights are broken by the endpoints so that
+        // the candidates of all components never close a cycle
+        template<typename W>
+        bool lighter(const Edge<W> &a, const Edge<W> &b) {
+            return std::make_tuple(a.w, std::min(a.u, a.v), std::max(a.u, a.v)) <
+                   std::make_tuple(b.w, std::min(b.u, b.v), std::max(b.u, b.v));
+        }
+
+        // Worker side, edges arrive from the coordinator stored from the owned endpoint
+        template<typename W>
+        int run_worker(IpcChannel &channel, uint32_t n) {
+            std::vector<Edge<W>> edges, work, candidates;
+            while (true) {
+                const auto command = channel.recv_value<Command>();
+                if (command == Command::Shutdown) return 0;
+                if (command == Command::Loaded) break;
+                channel.recv_vector(candidates);
+                edges.insert(edges.end(), candidates.begin(), candidates.end());
+            }
+
+            // label[v] - component of v as a forest of relabels, followed with path halving
+            std::vector<uint32_t> label(n);
+            std::vector<Relabel> relabels;
+            const auto find = [&label](uint32_t v) {
+                while (label[v] != v) {
+                    label[v] = label[label[v]];
+                    v = label[v];
+                }
+                return v;
+            };
+            // best[c] - index of the lightest outgoing edge of component c in candidates
+            constexpr uint32_t NONE = UINT32_MAX;
+            std::vector<uint32_t> best(n, NONE);
+            while (true) {
+                const auto command = channel.recv_value<Command>();
+                if (command == Command::Shutdown) return 0;
+
+                // the first round of a run starts from the whole partition and singleton components
+                if (channel.recv_value<uint32_t>() != 0) {
+                    work = edges;
+                    std::iota(label.begin(), label.end(), 0);
+                }
+                channel.recv_vector(relabels);
+                for (auto r: relabels) {
+                    label[r.from] = r.to;
+                }
+                candidates.clear();
+
+                std::erase_if(work, [&find](const Edge<W> &e) { return find(e.u) == find(e.v); });
+                for (const auto &e: work) {
+                    uint32_t &b = best[find(e.u)];
+                    if (b == NONE) {
+                        b = static_cast<uint32_t>(candidates.size());
+                        candidates.push_back(e);
+                    } else if (lighter(e, candidates[b])) {
+                        candidates[b] = e;
+                    }
+                }
+                channel.send_vector(candidates);
+                for (const auto &e: candidates) {
+                    best[find(e.u)] = NONE;
+                }
+            }
+        }
+    }// namespace
+
+    using clock = std::chrono::steady_clock;
+
+    template<typename W>
+    BoruvkaPartitioned<W>::~BoruvkaPartitioned() {
+        try {
+            shutdown();
+        } catch (const std::exception &e) {
+            std::cerr << "Failed to stop Borůvka workers: " << e.what() << std::endl;
+        }
+    }
+
+    template<typename W>
+    void BoruvkaPartitioned<W>::shutdown() {
+        for (auto &worker: workers) {
+            try {
+                worker.channel.send_value(Command::Shutdown);
+            } catch (const std::exception &) {
+                // the worker has already exited, join_worker collects it
+            }
+            join_worker(worker);
+        }
+        workers.clear();
+    }
+
+    template<typename W>
+    void BoruvkaPartitioned<W>::load_graph(const std::filesystem::path &file_path) {
+        shutdown();
+        GraphInput input;
+        const MtxHeader header = open_mtx_graph(file_path, input);
+        n = static_cast<uint32_t>(header.n_rows);
+
+        // Equal vertex ranges, the last worker takes the remainder
+        const uint32_t count = std::max(1u, std::min(worker_count, n));
+        const uint32_t range = std::max(1u, (n + count - 1) / count);
+        for (uint32_t i = 0; i < count; ++i) {
+            workers.push_back(launch_worker([n = n](IpcChannel &channel) {
+                return run_worker<W>(channel, n);
+            }));
+        }
+
+        // The file is parsed once here, every worker only receives the edges of its range
+        try {
+            std::vector<std::vector<Edge<W>>> batches(count);
+            const auto flush = [this, &batches](uint32_t i) {
+                workers[i].channel.send_value(Command::Edges);
+                workers[i].channel.send_vector(batches[i]);
+                batches[i].clear();
+            };
+            const auto route = [&](uint32_t owned, uint32_t other, W w) {
+                const uint32_t i = owned / range;
+                batches[i].push_back({owned, other, w});
+                if (batches[i].size() == EDGE_BATCH) flush(i);
+            };
+            for_each_mtx_edge<W>(input, header, [&](uint32_t u, uint32_t v, W w) {
+                route(u, v, w);
+                route(v, u, w);
+            });
+            for (uint32_t i = 0; i < count; ++i) {
+                if (!batches[i].empty()) flush(i);
+                workers[i].channel.send_value(Command::Loaded);
+            }
+        } catch (...) {
+            shutdown();
+            throw;
+        }
+    }
+
+    template<typename W>
+    std::chrono::milliseconds BoruvkaPartitioned<W>::compute() {
+        const auto start = clock::now();
+        compute_();
+        const auto end = clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    }
+
+    template<typename W>
+    void BoruvkaPartitioned<W>::compute_() {
+        mst_edges.clear();
+        mst_weights.clear();
+        weight = 0;
+
+        DisjointSet components(n);
+        // roots - components still in the forest, relabels - components merged in the last round
+        std::vector<uint32_t> roots(n);
+        std::iota(roots.begin(), roots.end(), 0);
+        std::vector<Relabel> relabels;
+        std::vector<Edge<W>> best(n), candidates;
+        std::vector<bool> has_best(n);
+        bool first_round = true;
+
+        while (true) {
+            for (auto &worker: workers) {
+                worker.channel.send_value(Command::Round);
+                worker.channel.send_value<uint32_t>(first_round);
+                worker.channel.send_vector(relabels);
+            }
+            first_round = false;
+
+            // Lightest outgoing edge of every component over all partitions
+            for (auto &worker: workers) {
+                worker.channel.recv_vector(candidates);
+                for (const auto &e: candidates) {
+                    const uint32_t c = components.find(e.u);
+                    if (!has_best[c] || lighter(e, best[c])) {
+                        best[c] = e;
+                        has_best[c] = true;
+                    }
+                }
+            }
+
+            // Two components may pick the same edge, the second unite skips it
+            bool merged = false;
+            for (auto c: roots) {
+                if (has_best[c] && components.unite(best[c].u, best[c].v)) {
+                    mst_edges.emplace_back(best[c].u, best[c].v);
+                    mst_weights.push_back(static_cast<double>(best[c].w));
+                    weight += mst_weights.back();
+                    merged = true;
+                }
+            }
+            if (!merged) break;
+
+            // Only merged components change their label, at most n - 1 relabels over the whole run
+            relabels.clear();
+            for (auto c: roots) {
+                has_best[c] = false;
+                const uint32_t root = components.find(c);
+                if (root != c) relabels.push_back({c, root});
+            }
+            std::erase_if(roots, [&components](uint32_t c) { return components.find(c) != c; });
+        }
+    }
+
+    template<typename W>
+    Tree BoruvkaPartitioned<W>::get_result() {
+        return make_tree(n, mst_edges, weight);
+    }
+
+    template<typename W>
+    void BoruvkaPartitioned<W>::write_result(ResultSink &sink) {
+        export_forest(n, mst_edges, mst_weights, weight, sink);
+    }
+
+    template class BoruvkaPartitioned<uint8_t>;
+    template class BoruvkaPartitioned<uint16_t>;
+    template class BoruvkaPartitioned<uint32_t>;
+    template class BoruvkaPartitioned<uint64_t>;
+    template class BoruvkaPartitioned<int32_t>;
+    template class BoruvkaPartitioned<float>;
+    template class BoruvkaPartitioned<double>;
+}// namespace algos
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "common/ipc_channel.hpp"
+#include "common/mst_algorithm.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace algos {
+    // Borůvka over worker processes connected by Unix domain sockets. The coordinator parses the file
+    // once and streams each worker the edges of its contiguous vertex range, then only keeps component
+    // labels. In every round workers send the lightest outgoing edge of each component seen in their
+    // range, the coordinator merges the candidates, contracts and sends back the merged components
+    template<typename W = uint32_t>
+    class BoruvkaPartitioned : public MstAlgorithm {
+
+    public:
+        explicit BoruvkaPartitioned(uint32_t worker_count = 4) : worker_count(worker_count) {}
+
+        ~BoruvkaPartitioned() override;
+
+        void load_graph(const std::filesystem::path &file_path) final;
+
+        std::chrono::milliseconds compute() final;
+
+        Tree get_result() final;
+
+        void write_result(ResultSink &sink) final;
+
+    private:
+        void compute_();
+
+        void shutdown();
+
+        uint32_t worker_count;
+        uint32_t n = 0;
+        std::vector<WorkerProcess> workers;
+        std::vector<std::pair<uint32_t, uint32_t>> mst_edges;
+        // weight of every edge of mst_edges
+        std::vector<double> mst_weights;
+        double weight = 0;
+    };
+}// namespace algos
@@ -0,0 +1,183 @@
+#include "delta_stepping_native.hpp"
+#include "common/scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace algos {
+    namespace {
+        // Lowers dist[v] to d, returns false if it is not smaller
+        bool relax(std::vector<double> &dist, uint32_t v, double d) {
+            std::atomic_ref<double> x(dist[v]);
+            double current = x.load(std::memory_order_relaxed);
+            while (d < current) {
+                if (x.compare_exchange_weak(current, d, std::memory_order_relaxed)) return true;
+            }
+            return false;
+        }
+
+        // Buckets indexed by floor(distance / delta), vertices are added when their distance drops
+        // and stale copies are skipped when a bucket is taken
+        class Buckets {
+        public:
+            void add(size_t b, const std::vector<uint32_t> &vertices) {
+                if (vertices.empty()) return;
+                if (b >= bins.size()) bins.resize(b + 1);
+                bins[b].insert(bins[b].end(), vertices.begin(), vertices.end());
+            }
+
+            std::vector<uint32_t> take(size_t b) {
+                if (b >= bins.size()) return {};
+                return std::exchange(bins[b], {});
+            }
+
+            [[nodiscard]] bool empty(size_t b) const { return b >= bins.size() || bins[b].empty(); }
+
+            [[nodiscard]] size_t size() const { return bins.size(); }
+
+        private:
+            std::vector<std::vector<uint32_t>> bins;
+        };
+
+        // Buckets of one thread, only the range [lo, hi) it added to since the last merge is visited
+        // by the merge, so that a thread far ahead does not make every merge walk all of its buckets
+        struct LocalBuckets {
+            std::vector<std::vector<uint32_t>> bins;
+            size_t lo = SIZE_MAX;
+            size_t hi = 0;
+
+            void push(size_t b, uint32_t v) {
+                if (b >= bins.size()) bins.resize(b + 1);
+                bins[b].push_back(v);
+                lo = std::min(lo, b);
+                hi = std::max(hi, b + 1);
+            }
+
+            void merge_into(Buckets &buckets) {
+                for (size_t b = lo; b < hi; ++b) {
+                    buckets.add(b, bins[b]);
+                    bins[b].clear();
+                }
+                lo = SIZE_MAX;
+                hi = 0;
+            }
+        };
+
+        // Per call buffers of relax_edges, kept for the whole run
+        struct RelaxScratch {
+            // cost[i] - vertices plus edges to relax of front[0, i)
+            std::vector<int64_t> cost;
+            PerThread<LocalBuckets> local;
+        };
+
+        // Relaxes the edges in [begin(u), end(u)) of every u in front, improved vertices go to thread local
+        // buckets which are merged at the end
+        template<typename Begin, typename End>
+        void relax_edges(const WeightedCsrGraph<double> &g, std::vector<double> &dist, double delta,
+                         const std::vector<uint32_t> &front, Begin begin, End end, Buckets &buckets, RelaxScratch &scratch) {
+            scratch.cost.resize(front.size() + 1);
+            scratch.cost[0] = 0;
+            for (size_t i = 0; i < front.size(); ++i) {
+                scratch.cost[i + 1] = scratch.cost[i] + 1 + (end(front[i]) - begin(front[i]));
+            }
+            parallel_for_weighted(
+                    static_cast<int64_t>(front.size()), [&](int64_t i) { return scratch.cost[i]; }, [&](int64_t i) {
+                        LocalBuckets &local = scratch.local.local();
+                        const uint32_t u = front[i];
+                        const double du = std::atomic_ref<double>(dist[u]).load(std::memory_order_relaxed);
+                        for (uint32_t e = begin(u); e < end(u); ++e) {
+                            const uint32_t v = g.cols[e];
+                            const double d = du + g.weights[e];
+                            if (relax(dist, v, d)) {
+                                local.push(static_cast<size_t>(d / delta), v);
+                            }
+                        }
+                    });
+            scratch.local.for_each([&](LocalBuckets &local) { local.merge_into(buckets); });
+        }
+    }// namespace
+
+    using clock = std::chrono::steady_clock;
+
+    void DeltaSteppingNative::load_graph(const std::filesystem::path &file_path) {
+        graph = load_sssp_graph(file_path);
+        delta = 0;
+    }
+
+    void DeltaSteppingNative::split_rows() {
+        light_end.resize(graph.n);
+        parallel_for_edges(graph.offsets, graph.n, [&](int64_t v) {
+            uint32_t mid = graph.offsets[v];
+            for (uint32_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+                if (graph.weights[e] < delta) {
+                    std::swap(graph.weights[e], graph.weights[mid]);
+                    std::swap(graph.cols[e], graph.cols[mid]);
+                    mid++;
+                }
+            }
+            light_end[v] = mid;
+        });
+    }
+
+    std::chrono::milliseconds DeltaSteppingNative::compute() {
+        const auto start = clock::now();
+        compute_();
+        const auto end = clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    }
+
+    void DeltaSteppingNative::compute_() {
+        if (source >= graph.n) {
+            throw std::runtime_error("Source vertex out of range");
+        }
+        const double next_delta = requested_delta > 0 ? requested_delta : choose_delta(graph);
+        if (next_delta != delta) {
+            delta = next_delta;
+            split_rows();
+        }
+
+        dist.assign(graph.n, UNREACHABLE);
+        dist[source] = 0;
+        // last pass over a bucket a vertex was settled in, heavy edges are relaxed once per vertex and pass
+        std::vector<size_t> settled_in(graph.n, SIZE_MAX);
+        size_t pass = 0;
+        Buckets buckets;
+        buckets.add(0, {source});
+
+        const auto row_begin = [this](uint32_t u) { return graph.offsets[u]; };
+        const auto row_light_end = [this](uint32_t u) { return light_end[u]; };
+        const auto row_end = [this](uint32_t u) { return graph.offsets[u + 1]; };
+
+        std::vector<uint32_t> front, settled;
+        RelaxScratch scratch;
+        for (size_t b = 0; b < buckets.size(); ++b) {
+            // Heavy edges land in later buckets, except when du + w rounds down to the bucket of u for a
+            // fractional delta. The bucket is then taken again, with the heavy edges of its new vertices
+            while (!buckets.empty(b)) {
+                ++pass;
+                settled.clear();
+                while (true) {
+                    // Copies whose distance moved to an earlier bucket are stale
+                    front.clear();
+                    for (const uint32_t u: buckets.take(b)) {
+                        if (static_cast<size_t>(dist[u] / delta) != b) continue;
+                        front.push_back(u);
+                        if (settled_in[u] != pass) {
+                            settled_in[u] = pass;
+                            settled.push_back(u);
+                        }
+                    }
+                    if (front.empty()) break;
+                    relax_edges(graph, dist, delta, front, row_begin, row_light_end, buckets, scratch);
+                }
+                relax_edges(graph, dist, delta, settled, row_light_end, row_end, buckets, scratch);
+            }
+        }
+    }
+
+    ShortestPaths DeltaSteppingNative::get_result() {
+        return make_shortest_paths(graph, source, dist);
+    }
+}// namespace algos
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "common/csr_graph.hpp"
+#include "common/shortest_path_algorithm.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace algos {
+    // Parallel delta-stepping: buckets of width delta are settled in order, light edges (w < delta)
+    // are relaxed until the bucket stays empty and heavy edges once per settled vertex afterwards.
+    // Rows are split into light and heavy parts when the delta changes
+    class DeltaSteppingNative : public ShortestPathAlgorithm {
+
+    public:
+        // 0 picks the delta from the weights with choose_delta
+        explicit DeltaSteppingNative(double delta = 0) : requested_delta(delta) {}
+
+        void load_graph(const std::filesystem::path &file_path) final;
+
+        std::chrono::milliseconds compute() final;
+
+        ShortestPaths get_result() final;
+
+        [[nodiscard]] double get_delta() const { return delta; }
+
+    private:
+        void compute_();
+
+        void split_rows();
+
+        double requested_delta;
+        double delta = 0;
+        WeightedCsrGraph<double> graph;
+        // graph.offsets[v] .. light_end[v] - light edges of v, light_end[v] .. graph.offsets[v + 1] - heavy ones
+        std::vector<uint32_t> light_end;
+        std::vector<double> dist;
+    };
+}// namespace algos
@@ -0,0 +1,77 @@
+#include "fast_sv_native.hpp"
+#include "common/scheduler.hpp"
+
+#include <atomic>
+#include <numeric>
+
+namespace algos {
+    namespace {
+        uint32_t load(std::vector<uint32_t> &v, uint32_t i) {
+            return std::atomic_ref<uint32_t>(v[i]).load(std::memory_order_relaxed);
+        }
+
+        void atomic_min(std::vector<uint32_t> &v, uint32_t i, uint32_t value) {
+            std::atomic_ref<uint32_t> x(v[i]);
+            uint32_t current = x.load(std::memory_order_relaxed);
+            while (value < current && !x.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+    }// namespace
+
+    using clock = std::chrono::steady_clock;
+
+    void FastSvNative::load_graph(const std::filesystem::path &file_path) {
+        graph = load_csr(file_path);
+    }
+
+    std::chrono::milliseconds FastSvNative::compute() {
+        const auto start = clock::now();
+        compute_();
+        const auto end = clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    }
+
+    void FastSvNative::compute_() {
+        const uint32_t n = graph.n;
+        f.resize(n);
+        std::iota(f.begin(), f.end(), 0);
+        // gf[v] = f[f[v]], mngf[v] - minimum grandparent over v and its neighbours
+        std::vector<uint32_t> gf = f, mngf(n);
+
+        std::atomic<bool> changed = true;
+        while (changed) {
+            parallel_for_edges(graph.offsets, n, [&](int64_t u) {
+                uint32_t m = gf[u];
+                for (const uint32_t v: graph.neighbors(u)) {
+                    m = std::min(m, gf[v]);
+                }
+                mngf[u] = m;
+            });
+
+            // Stochastic hooking of the parent, aggressive hooking and shortcutting of the vertex itself.
+            // Parents only decrease, so concurrent updates keep f[v] <= v and never form a cycle
+            parallel_for(0, n, [&](int64_t u) {
+                atomic_min(f, load(f, u), mngf[u]);
+                atomic_min(f, u, std::min(mngf[u], gf[u]));
+            });
+
+            changed = false;
+            parallel_for(0, n, [&](int64_t u) {
+                const uint32_t next = load(f, load(f, u));
+                if (next != gf[u]) {
+                    gf[u] = next;
+                    changed.store(true, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        // f[u] <= u, so in ascending order f[f[u]] is already a root
+        for (uint32_t u = 0; u < n; ++u) {
+            f[u] = f[f[u]];
+        }
+    }
+
+    Components FastSvNative::get_result() {
+        return make_components(f);
+    }
+}// namespace algos
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "common/connected_components_algorithm.hpp"
+#include "common/csr_graph.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace algos {
+    // FastSV variant of Shiloach–Vishkin: stochastic and aggressive hooking to the minimum grandparent
+    // of the neighbours plus shortcutting, repeated until no grandparent changes
+    class FastSvNative : public ConnectedComponentsAlgorithm {
+
+    public:
+        void load_graph(const std::filesystem::path &file_path) final;
+
+        std::chrono::milliseconds compute() final;
+
+        Components get_result() final;
+
+    private:
+        void compute_();
+
+        CsrGraph graph;
+        // f[v] - parent of v, f[v] <= v
+        std::vector<uint32_t> f;
+    };
+}// namespace algos
@@ -0,0 +1,231 @@
+#include "min_edge_kernel.hpp"
+#include "common/merge_path.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ALGOS_X86 1
+#include <immintrin.h>
+#else
+#define ALGOS_X86 0
+#endif
+
+namespace algos {
+    namespace {
+        // Rows shorter than this are reduced by the scalar loop, vector setup does not pay off for them
+        constexpr uint32_t SIMD_MIN_ROW = 16;
+
+        uint64_t min_key_scalar(const uint64_t *keys, size_t count) {
+            uint64_t res = INF_KEY;
+            for (size_t i = 0; i < count; ++i) {
+                res = std::min(res, keys[i]);
+            }
+            return res;
+        }
+
+        uint64_t relax_min_keys_scalar(const uint32_t *row, uint32_t u, uint64_t *dist, uint32_t *parent, uint32_t begin, uint32_t end) {
+            uint64_t res = INF_KEY;
+            for (uint32_t v = begin; v < end; ++v) {
+                const uint64_t key = encode_edge_key(row[v], v);
+                if (key < dist[v] && dist[v] != INF_KEY) {
+                    dist[v] = key;
+                    parent[v] = u;
+                }
+                res = std::min(res, dist[v]);
+            }
+            return res;
+        }
+
+#if ALGOS_X86
+        // AVX2 has only signed 64-bit compares, keys are compared with the sign bit flipped
+        __attribute__((target("avx2"))) uint64_t min_key_avx2(const uint64_t *keys, size_t count) {
+            const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+            const __m256i inf = _mm256_set1_epi64x(INT64_MAX);// INF_KEY with the flipped sign bit
+            __m256i acc0 = inf, acc1 = inf;
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const __m256i x0 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)), bias);
+                const __m256i x1 = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i + 4)), bias);
+                acc0 = _mm256_blendv_epi8(acc0, x0, _mm256_cmpgt_epi64(acc0, x0));
+                acc1 = _mm256_blendv_epi8(acc1, x1, _mm256_cmpgt_epi64(acc1, x1));
+            }
+            acc0 = _mm256_blendv_epi8(acc0, acc1, _mm256_cmpgt_epi64(acc0, acc1));
+            for (; i < count; i += 4) {
+                // masked tail, lanes past the end read as INF
+                const auto rest = static_cast<int64_t>(count - i);
+                const __m256i lane = _mm256_set_epi64x(3, 2, 1, 0);
+                const __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(rest), lane);
+                const __m256i loaded = _mm256_maskload_epi64(reinterpret_cast<const long long *>(keys + i), mask);
+                const __m256i x = _mm256_blendv_epi8(inf, _mm256_xor_si256(loaded, bias), mask);
+                acc0 = _mm256_blendv_epi8(acc0, x, _mm256_cmpgt_epi64(acc0, x));
+            }
+            alignas(32) int64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc0);
+            const int64_t res = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+            return static_cast<uint64_t>(res) ^ static_cast<uint64_t>(INT64_MIN);
+        }
+
+        __attribute__((target("avx512f"))) uint64_t min_key_avx512(const uint64_t *keys, size_t count) {
+            const __m512i inf = _mm512_set1_epi64(static_cast<int64_t>(INF_KEY));
+            __m512i acc0 = inf, acc1 = inf;
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                acc0 = _mm512_min_epu64(acc0, _mm512_loadu_si512(keys + i));
+                acc1 = _mm512_min_epu64(acc1, _mm512_loadu_si512(keys + i + 8));
+            }
+            acc0 = _mm512_min_epu64(acc0, acc1);
+            for (; i < count; i += 8) {
+                const size_t rest = std::min<size_t>(count - i, 8);
+                const auto mask = static_cast<__mmask8>((1u << rest) - 1);
+                acc0 = _mm512_min_epu64(acc0, _mm512_mask_loadu_epi64(inf, mask, keys + i));
+            }
+            alignas(64) uint64_t lanes[8];
+            _mm512_store_si512(lanes, acc0);
+            return *std::min_element(lanes, lanes + 8);
+        }
+
+        __attribute__((target("avx2"))) uint64_t relax_min_keys_avx2(const uint32_t *row, uint32_t u, uint64_t *dist, uint32_t *parent,
+                                                                     uint32_t begin, uint32_t end) {
+            const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+            const __m256i inf = _mm256_set1_epi64x(static_cast<int64_t>(INF_KEY));
+            const __m128i parents = _mm_set1_epi32(static_cast<int32_t>(u));
+            // low halves of the 64-bit lanes of a mask, to store 32-bit parents under it
+            const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+            __m256i ids = _mm256_add_epi64(_mm256_set1_epi64x(begin), _mm256_setr_epi64x(0, 1, 2, 3));
+            __m256i acc = _mm256_set1_epi64x(INT64_MAX);// INF_KEY with the flipped sign bit
+            uint32_t v = begin;
+            for (; v + 4 <= end; v += 4) {
+                const __m256i ranks = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row + v)));
+                const __m256i key = _mm256_or_si256(_mm256_slli_epi64(ranks, 32), ids);
+                const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dist + v));
+                const __m256i smaller = _mm256_cmpgt_epi64(_mm256_xor_si256(d, bias), _mm256_xor_si256(key, bias));
+                const __m256i closer = _mm256_andnot_si256(_mm256_cmpeq_epi64(d, inf), smaller);
+                const __m256i res = _mm256_blendv_epi8(d, key, closer);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dist + v), res);
+                const __m128i closer32 = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(closer, low_halves));
+                _mm_maskstore_epi32(reinterpret_cast<int *>(parent + v), closer32, parents);
+                const __m256i biased = _mm256_xor_si256(res, bias);
+                acc = _mm256_blendv_epi8(acc, biased, _mm256_cmpgt_epi64(acc, biased));
+                ids = _mm256_add_epi64(ids, _mm256_set1_epi64x(4));
+            }
+            alignas(32) int64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+            const int64_t res = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+            return std::min(static_cast<uint64_t>(res) ^ static_cast<uint64_t>(INT64_MIN), relax_min_keys_scalar(row, u, dist, parent, v, end));
+        }
+
+        __attribute__((target("avx512f"))) uint64_t relax_min_keys_avx512(const uint32_t *row, uint32_t u, uint64_t *dist, uint32_t *parent,
+                                                                          uint32_t begin, uint32_t end) {
+            const __m512i inf = _mm512_set1_epi64(static_cast<int64_t>(INF_KEY));
+            const __m512i parents = _mm512_set1_epi64(u);
+            __m512i ids = _mm512_add_epi64(_mm512_set1_epi64(begin), _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7));
+            __m512i acc = inf;
+            uint32_t v = begin;
+            for (; v + 8 <= end; v += 8) {
+                const __m512i ranks = _mm512_cvtepu32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + v)));
+                const __m512i key = _mm512_or_si512(_mm512_slli_epi64(ranks, 32), ids);
+                const __m512i d = _mm512_loadu_si512(dist + v);
+                const __mmask8 closer = _mm512_cmplt_epu64_mask(key, d) & _mm512_cmpneq_epu64_mask(d, inf);
+                const __m512i res = _mm512_mask_blend_epi64(closer, d, key);
+                _mm512_storeu_si512(dist + v, res);
+                _mm512_mask_cvtepi64_storeu_epi32(parent + v, closer, parents);
+                acc = _mm512_min_epu64(acc, res);
+                ids = _mm512_add_epi64(ids, _mm512_set1_epi64(8));
+            }
+            return std::min<uint64_t>(_mm512_reduce_min_epu64(acc), relax_min_keys_scalar(row, u, dist, parent, v, end));
+        }
+#endif
+
+        using MinKeyFn = uint64_t (*)(const uint64_t *, size_t);
+
+        MinKeyFn min_key_fn(SimdLevel level) {
+#if ALGOS_X86
+            switch (level) {
+                case SimdLevel::Avx512:
+                    return min_key_avx512;
+                case SimdLevel::Avx2:
+                    return min_key_avx2;
+                case SimdLevel::Scalar:
+                    break;
+            }
+#endif
+            return min_key_scalar;
+        }
+    }// namespace
+
+    std::string to_string(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::Scalar:
+                return "scalar";
+            case SimdLevel::Avx2:
+                return "avx2";
+            case SimdLevel::Avx512:
+                return "avx512";
+        }
+        return "unknown";
+    }
+
+    SimdLevel detect_simd_level() {
+        SimdLevel level = SimdLevel::Scalar;
+#if ALGOS_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            level = SimdLevel::Avx512;
+        } else if (__builtin_cpu_supports("avx2")) {
+            level = SimdLevel::Avx2;
+        }
+#endif
+        if (const char *env = std::getenv("ALGOS_SIMD")) {
+            const std::string_view requested(env);
+            if (requested == "scalar") {
+                level = SimdLevel::Scalar;
+            } else if (requested == "avx2" && level == SimdLevel::Avx512) {
+                level = SimdLevel::Avx2;
+            }
+        }
+        return level;
+    }
+
+    uint64_t min_key(const uint64_t *keys, size_t count, SimdLevel level) {
+        return min_key_fn(level)(keys, count);
+    }
+
+    uint64_t relax_min_keys(const uint32_t *row, uint32_t u, uint64_t *dist, uint32_t *parent, uint32_t begin, uint32_t end,
+                            SimdLevel level) {
+#if ALGOS_X86
+        switch (level) {
+            case SimdLevel::Avx512:
+                return relax_min_keys_avx512(row, u, dist, parent, begin, end);
+            case SimdLevel::Avx2:
+                return relax_min_keys_avx2(row, u, dist, parent, begin, end);
+            case SimdLevel::Scalar:
+                break;
+        }
+#endif
+        return relax_min_keys_scalar(row, u, dist, parent, begin, end);
+    }
+
+    void row_min_keys(const uint32_t *offsets, const uint64_t *keys, uint32_t n, uint64_t *row_min, SimdLevel level) {
+        const MinKeyFn simd_min = min_key_fn(level);
+        // Hub rows are split over threads and the minima of their pieces combined
+        segmented_reduce(
+                offsets, n, INF_KEY,
+                [&](int64_t, int64_t begin, int64_t end) {
+                    const auto len = static_cast<size_t>(end - begin);
+                    return len < SIMD_MIN_ROW ? min_key_scalar(keys + begin, len) : simd_min(keys + begin, len);
+                },
+                [](uint64_t a, uint64_t b) { return std::min(a, b); }, row_min);
+    }
+
+    void component_min_keys(const uint64_t *row_min, const uint32_t *comp, uint32_t n, uint64_t *comp_min, uint32_t *comp_arg) {
+        for (uint32_t v = 0; v < n; ++v) {
+            const uint32_t c = comp[v];
+            if (row_min[v] < comp_min[c]) {
+                comp_min[c] = row_min[v];
+                comp_arg[c] = v;
+            }
+        }
+    }
+}// namespace algos
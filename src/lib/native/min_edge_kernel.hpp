@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace algos {
+    // Instruction set used by the native kernels, picked at runtime
+    enum class SimdLevel {
+        Scalar,
+        Avx2,
+        Avx512
+    };
+
+    std::string to_string(SimdLevel level);
+
+    // Best level supported by the CPU, ALGOS_SIMD=scalar|avx2|avx512 lowers it for experiments
+    SimdLevel detect_simd_level();
+
+    // Keys of edges are (weight rank << 32) | dest, so the smallest key is the lightest edge
+    // with ties broken by the destination vertex
+    constexpr uint64_t INF_KEY = UINT64_MAX;
+
+    inline uint64_t encode_edge_key(uint32_t weight_rank, uint32_t dest) {
+        return (static_cast<uint64_t>(weight_rank) << 32) | dest;
+    }
+
+    inline uint32_t edge_key_dest(uint64_t key) { return static_cast<uint32_t>(key); }
+
+    inline uint32_t edge_key_rank(uint64_t key) { return static_cast<uint32_t>(key >> 32); }
+
+    // Distinct weights in increasing order. Ranks keep the order of the weights and fit the upper half
+    // of a key for every weight type
+    template<typename W, typename Weights>
+    std::vector<W> rank_weights(const Weights &weights) {
+        std::vector<W> res(weights.begin(), weights.end());
+        std::ranges::sort(res);
+        res.erase(std::unique(res.begin(), res.end()), res.end());
+        return res;
+    }
+
+    template<typename W>
+    uint32_t weight_rank(const std::vector<W> &weight_by_rank, W w) {
+        return static_cast<uint32_t>(std::ranges::lower_bound(weight_by_rank, w) - weight_by_rank.begin());
+    }
+
+    // Minimum of keys[0 .. count), INF_KEY for an empty range
+    uint64_t min_key(const uint64_t *keys, size_t count, SimdLevel level);
+
+    // row_min[v] = minimum key of row v of the CSR matrix (offsets, keys), rows are split over threads by merge path
+    void row_min_keys(const uint32_t *offsets, const uint64_t *keys, uint32_t n, uint64_t *row_min, SimdLevel level);
+
+    // Prim step over dist[begin, end): the key of (row[v], v) replaces dist[v] when it is smaller, and u becomes
+    // parent[v]. Vertices of the tree hold INF_KEY and are left alone. Returns the smallest key of the range
+    uint64_t relax_min_keys(const uint32_t *row, uint32_t u, uint64_t *dist, uint32_t *parent, uint32_t begin, uint32_t end,
+                            SimdLevel level);
+
+    // comp_min[c] = minimum of row_min[v] over vertices with comp[v] == c, comp_arg[c] - the vertex it comes from.
+    // comp_min must be filled with INF_KEY by the caller
+    void component_min_keys(const uint64_t *row_min, const uint32_t *comp, uint32_t n, uint64_t *comp_min, uint32_t *comp_arg);
+}// namespace algos
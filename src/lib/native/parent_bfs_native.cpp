@@ -0,0 +1,154 @@
+#include "parent_bfs_native.hpp"
+#include "common/merge_path.hpp"
+#include "common/trace.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace algos {
+    namespace {
+        constexpr int UNVISITED = -1;
+        // Levels with fewer edges per destination block are expanded directly, their bins would stay nearly empty
+        constexpr int64_t MIN_BLOCK_UPDATES = 64;
+    }
+
+    using clock = std::chrono::steady_clock;
+
+    void ParentBfsNative::load_graph(const std::filesystem::path &file_path) {
+        graph = load_adjacency(file_path, storage);
+        n = std::visit([](const auto &g) { return g.vertices(); }, graph);
+        seeds.clear();
+    }
+
+    std::chrono::milliseconds ParentBfsNative::compute() {
+        const auto start = clock::now();
+        compute_();
+        const auto end = clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    }
+
+    void ParentBfsNative::compute_() {
+        parent.assign(n, UNVISITED);
+        next_local.resize(scheduler_threads());
+        blocked = use_blocking(propagation, n * sizeof(int));
+        if (blocked) {
+            bins.reset(n, propagation_block_shift(sizeof(int)));
+        }
+        std::visit([this](const auto &g) { bfs(g); }, graph);
+    }
+
+    template<typename Graph>
+    void ParentBfsNative::bfs(const Graph &g) {
+        front.clear();
+        if (root) {
+            if (*root >= n) {
+                throw std::runtime_error("Root vertex out of range");
+            }
+            parent[*root] = static_cast<int>(*root);
+            front.push_back(*root);
+            expand(g);
+            return;
+        }
+
+        for (const uint32_t root: seeds) {
+            if (root >= n) {
+                throw std::runtime_error("Seed vertex out of range");
+            }
+            if (parent[root] != UNVISITED) continue;
+            parent[root] = static_cast<int>(root);
+            front.push_back(root);
+        }
+        expand(g);
+
+        // Components without a seed are searched one by one
+        for (uint32_t root = 0; root < n; ++root) {
+            if (parent[root] != UNVISITED) continue;
+            parent[root] = static_cast<int>(root);
+            front.assign(1, root);
+            expand(g);
+        }
+    }
+
+    template<typename Graph>
+    void ParentBfsNative::expand(const Graph &g) {
+        while (!front.empty()) {
+            ALGOS_TRACE_SCOPE(level, "bfs_level");
+            front_edges.resize(front.size() + 1);
+            front_edges[0] = 0;
+            for (size_t i = 0; i < front.size(); ++i) {
+                front_edges[i + 1] = front_edges[i] + g.degree(front[i]);
+            }
+            level.arg("frontier", static_cast<int64_t>(front.size()));
+            level.arg("edges_scanned", front_edges.back());
+
+            if (blocked && front_edges.back() >= static_cast<int64_t>(bins.block_count()) * MIN_BLOCK_UPDATES) {
+                // Every block is claimed by one thread, the first candidate of a vertex becomes its parent.
+                // parent is only read while the bins are filled
+                for_each_frontier_edge(g, [this](uint32_t u, uint32_t v) {
+                    if (parent[v] == UNVISITED) bins.push(v, {v, u});
+                });
+                bins.apply([this](const Candidate &c) {
+                    if (parent[c.vertex] == UNVISITED) {
+                        parent[c.vertex] = static_cast<int>(c.parent);
+                        next_local.local().push_back(c.vertex);
+                    }
+                });
+            } else {
+                // Every vertex is claimed by exactly one frontier vertex, the winner of the CAS
+                for_each_frontier_edge(g, [this](uint32_t u, uint32_t v) {
+                    std::atomic_ref<int> p(parent[v]);
+                    int expected = UNVISITED;
+                    if (p.load(std::memory_order_relaxed) == UNVISITED &&
+                        p.compare_exchange_strong(expected, static_cast<int>(u), std::memory_order_relaxed)) {
+                        next_local.local().push_back(v);
+                    }
+                });
+            }
+
+            next.clear();
+            next_local.for_each([this](std::vector<uint32_t> &local) {
+                next.insert(next.end(), local.begin(), local.end());
+                local.clear();
+            });
+            front.swap(next);
+        }
+    }
+
+    template<typename Graph, typename F>
+    void ParentBfsNative::for_each_frontier_edge(const Graph &g, F f) {
+        const auto frontier = static_cast<int64_t>(front.size());
+        if constexpr (is_csr_graph_v<Graph>) {
+            // The edges of the frontier are split evenly over the threads, those of a hub as well
+            merge_path_for_each(front_edges, frontier, [&](int64_t i, int64_t begin, int64_t end) {
+                const uint32_t u = front[i];
+                const int64_t base = g.offsets[u] - front_edges[i];
+                for (int64_t e = begin; e < end; ++e) {
+                    f(u, g.cols[base + e]);
+                }
+            });
+        } else {
+            // Compressed rows are decoded from their start, so only whole rows are split on vertices plus edges
+            parallel_for_weighted(frontier, [this](int64_t i) { return front_edges[i] + i; }, [&](int64_t i) {
+                const uint32_t u = front[i];
+                g.for_each_neighbor(u, [&](uint32_t v) { f(u, v); });
+            });
+        }
+    }
+
+    Tree ParentBfsNative::get_result() {
+        TreeSink sink;
+        write_result(sink);
+        return sink.take();
+    }
+
+    void ParentBfsNative::write_result(ResultSink &sink) {
+        // Roots are their own parents while searching
+        const auto copy = [this](auto out) {
+            parallel_for(0, n, [&](int64_t v) { out[v] = parent[v] == v ? -1 : parent[v]; });
+        };
+        const ParentSpan parents = sink.parents(n);
+        std::visit(copy, parents);
+        export_levels(parents, sink, root);
+        sink.finish(0);
+    }
+}// namespace algos
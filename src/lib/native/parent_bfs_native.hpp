@@ -0,0 +1,62 @@
+#pragma once
+
+#include "common/compressed_graph.hpp"
+#include "common/parent_bfs_algorithm.hpp"
+#include "common/propagation_blocking.hpp"
+#include "common/scheduler.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace algos {
+    // Level synchronous top-down BFS forest over CSR or compressed adjacency, the storage
+    // is chosen at construction and used by the next load_graph. Over CSR the edges of a level
+    // are divided evenly between the threads by merge path. With blocked propagation the candidate
+    // parents of large levels are binned by destination block before they are claimed
+    class ParentBfsNative : public ParentBfsAlgorithm {
+
+    public:
+        explicit ParentBfsNative(GraphStorage storage = GraphStorage::Csr, Propagation propagation = Propagation::Auto)
+            : storage(storage), propagation(propagation) {}
+
+        void load_graph(const std::filesystem::path &file_path) final;
+
+        std::chrono::milliseconds compute() final;
+
+        Tree get_result() final;
+
+        void write_result(ResultSink &sink) final;
+
+    private:
+        void compute_();
+
+        template<typename Graph>
+        void bfs(const Graph &g);
+
+        template<typename Graph>
+        void expand(const Graph &g);
+
+        // f(u, v) for every edge of the frontier vertices u, in parallel
+        template<typename Graph, typename F>
+        void for_each_frontier_edge(const Graph &g, F f);
+
+        struct Candidate {
+            uint32_t vertex;
+            uint32_t parent;
+        };
+
+        GraphStorage storage;
+        Propagation propagation;
+        bool blocked = false;
+        Adjacency graph;
+        uint32_t n = 0;
+        // parent[v] = parent id, roots are their own parents, UNVISITED for not visited vertices
+        numa_vector<int> parent;
+        // current and next level, kept between runs
+        std::vector<uint32_t> front, next;
+        // front_edges[i] - edges of front[0, i), the row offsets of the frontier
+        std::vector<int64_t> front_edges;
+        PerThread<std::vector<uint32_t>> next_local;
+        PropagationBins<Candidate> bins;
+    };
+}// namespace algos
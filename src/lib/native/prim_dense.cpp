@@ -0,0 +1,169 @@
+#include "prim_dense.hpp"
+#include "common/csr_graph.hpp"
+#include "common/graph_input.hpp"
+#include "common/mtx_reader.hpp"
+#include "common/scheduler.hpp"
+#include "common/trace.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace algos {
+    namespace {
+        constexpr uint32_t NO_EDGE = UINT32_MAX;
+        constexpr uint32_t NO_PARENT = UINT32_MAX;
+        // Rows are padded to 64 bytes
+        constexpr uint64_t ROW_ALIGN = 16;
+        // Vertices relaxed and scanned together, the keys and the row piece of a block stay within L2
+        constexpr uint32_t BLOCK = 4096;
+        // Below this a step is too short to split over threads
+        constexpr uint32_t PARALLEL_MIN_VERTICES = 1 << 14;
+        // Crossover with BoruvkaNative on random graphs of 1000 to 4000 vertices, it lies between 1% and 5%
+        constexpr double DEFAULT_DENSE_THRESHOLD = 0.05;
+        constexpr uint64_t DEFAULT_DENSE_MAX_MB = 2048;
+
+        uint64_t padded_row(uint64_t n) {
+            return (n + ROW_ALIGN - 1) / ROW_ALIGN * ROW_ALIGN;
+        }
+    }// namespace
+
+    using clock = std::chrono::steady_clock;
+
+    double dense_threshold() {
+        if (const char *env = std::getenv("ALGOS_DENSE_THRESHOLD")) {
+            return std::stod(env);
+        }
+        return DEFAULT_DENSE_THRESHOLD;
+    }
+
+    uint64_t dense_matrix_bytes(uint64_t n) {
+        return n * padded_row(n) * sizeof(uint32_t);
+    }
+
+    bool fits_dense_matrix(uint64_t n) {
+        uint64_t max_mb = DEFAULT_DENSE_MAX_MB;
+        if (const char *env = std::getenv("ALGOS_DENSE_MAX_MB")) {
+            max_mb = std::stoull(env);
+        }
+        return dense_matrix_bytes(n) <= (max_mb << 20);
+    }
+
+    bool prefer_dense_mst(uint64_t n, uint64_t directed_edges) {
+        if (n < 2 || !fits_dense_matrix(n)) return false;
+        return static_cast<double>(directed_edges) >= dense_threshold() * static_cast<double>(n) * static_cast<double>(n - 1);
+    }
+
+    template<typename W>
+    void PrimDense<W>::load_graph(const std::filesystem::path &file_path) {
+        matrix = numa_vector<uint32_t>();
+
+        // The size is checked on the header, sparse graphs too large for a matrix are not loaded at all
+        GraphInput input(file_path);
+        if (!input.is_open()) {
+            throw std::runtime_error("Failed to open file: " + file_path.string());
+        }
+        const auto vertices = static_cast<uint64_t>(read_mtx_header(input).n_rows);
+        if (!fits_dense_matrix(vertices)) {
+            throw std::runtime_error("Adjacency matrix of " + std::to_string(vertices) + " vertices takes " +
+                                     std::to_string(dense_matrix_bytes(vertices) >> 20) + " MB, above ALGOS_DENSE_MAX_MB");
+        }
+
+        const WeightedCsrGraph<W> g = load_weighted_csr<W>(file_path);
+        weight_by_rank = rank_weights<W>(g.weights);
+        n = g.n;
+        stride = padded_row(n);
+        matrix.assign(n * stride, NO_EDGE);
+        for (uint32_t u = 0; u < n; ++u) {
+            uint32_t *row = matrix.data() + u * stride;
+            for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                const uint32_t v = g.cols[e];
+                if (v == u) continue;
+                row[v] = std::min(row[v], weight_rank(weight_by_rank, g.weights[e]));
+            }
+        }
+    }
+
+    template<typename W>
+    std::chrono::milliseconds PrimDense<W>::compute() {
+        const auto start = clock::now();
+        compute_();
+        const auto end = clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    }
+
+    template<typename W>
+    void PrimDense<W>::compute_() {
+        ALGOS_TRACE_SCOPE(scope, "prim_dense");
+        weight = 0;
+        // Vertices of the tree hold INF_KEY, the others the key of their lightest edge to it
+        dist.resize(n);
+        for (uint32_t v = 0; v < n; ++v) {
+            dist[v] = encode_edge_key(NO_EDGE, v);
+        }
+        parent.assign(n, NO_PARENT);
+        const uint32_t blocks = (n + BLOCK - 1) / BLOCK;
+        block_min.resize(blocks);
+        for (uint32_t b = 0; b < blocks; ++b) {
+            block_min[b] = dist[b * BLOCK];
+        }
+
+        const bool parallel = n >= PARALLEL_MIN_VERTICES;
+        for (uint32_t step = 0; step < n; ++step) {
+            const uint64_t key = min_key(block_min.data(), blocks, simd_level);
+            const uint32_t u = edge_key_dest(key);
+            // The rank is NO_EDGE when the tree is complete, u then starts the next one
+            if (edge_key_rank(key) != NO_EDGE) {
+                weight += weight_by_rank[edge_key_rank(key)];
+            }
+            dist[u] = INF_KEY;
+
+            const uint32_t *row = matrix.data() + u * stride;
+            auto relax = [&](int64_t b) {
+                const auto begin = static_cast<uint32_t>(b * BLOCK);
+                block_min[b] = relax_min_keys(row, u, dist.data(), parent.data(), begin, std::min(n, begin + BLOCK), simd_level);
+            };
+            if (parallel) {
+                parallel_for(0, blocks, relax);
+            } else {
+                for (uint32_t b = 0; b < blocks; ++b) {
+                    relax(b);
+                }
+            }
+        }
+    }
+
+    template<typename W>
+    Tree PrimDense<W>::get_result() {
+        TreeSink sink;
+        write_result(sink);
+        return sink.take();
+    }
+
+    template<typename W>
+    void PrimDense<W>::write_result(ResultSink &sink) {
+        const auto copy = [this](auto out) {
+            for (uint32_t v = 0; v < n; ++v) {
+                out[v] = parent[v] == NO_PARENT ? -1 : static_cast<int64_t>(parent[v]);
+            }
+        };
+        const ParentSpan parents = sink.parents(n);
+        std::visit(copy, parents);
+        export_levels(parents, sink);
+        if (const std::span<double> out = sink.edge_weights(n); !out.empty()) {
+            for (uint32_t v = 0; v < n; ++v) {
+                out[v] = parent[v] == NO_PARENT ? 0 : static_cast<double>(weight_by_rank[matrix[parent[v] * stride + v]]);
+            }
+        }
+        sink.finish(weight);
+    }
+
+    template class PrimDense<uint8_t>;
+    template class PrimDense<uint16_t>;
+    template class PrimDense<uint32_t>;
+    template class PrimDense<uint64_t>;
+    template class PrimDense<int32_t>;
+    template class PrimDense<float>;
+    template class PrimDense<double>;
+}// namespace algos
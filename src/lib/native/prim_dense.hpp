@@ -0,0 +1,57 @@
+#pragma once
+
+#include "common/mst_algorithm.hpp"
+#include "common/numa_allocator.hpp"
+#include "native/min_edge_kernel.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace algos {
+    // Density m / (n (n - 1)) from which the dense Prim is considered, ALGOS_DENSE_THRESHOLD overrides it
+    double dense_threshold();
+
+    // Bytes of the adjacency matrix of PrimDense, at most ALGOS_DENSE_MAX_MB (2048 by default) are allocated
+    uint64_t dense_matrix_bytes(uint64_t n);
+
+    bool fits_dense_matrix(uint64_t n);
+
+    // Whether a graph of n vertices and the given stored edges, every undirected edge counted twice,
+    // is dense enough for PrimDense and its matrix fits
+    bool prefer_dense_mst(uint64_t n, uint64_t directed_edges);
+
+    // O(n^2) Prim over an adjacency matrix of weight ranks, for graphs close to complete where the
+    // sparse structures only add overhead. Every step relaxes the row of the vertex added last into
+    // a distance array of (weight rank, vertex) keys and finds the minimum of the relaxed keys in the same
+    // SIMD pass (relax_min_keys), block by block, then the next vertex among the block minima.
+    // Unreachable vertices keep the largest keys short of INF_KEY, ordered by id, so they start the
+    // next tree of the forest. Large graphs relax and scan their blocks in parallel
+    template<typename W = uint32_t>
+    class PrimDense : public MstAlgorithm {
+
+    public:
+        void load_graph(const std::filesystem::path &file_path) final;
+
+        std::chrono::milliseconds compute() final;
+
+        Tree get_result() final;
+
+        void write_result(ResultSink &sink) final;
+
+    private:
+        void compute_();
+
+        uint32_t n = 0;
+        // row length of the matrix, padded to whole cache lines
+        uint64_t stride = 0;
+        SimdLevel simd_level = detect_simd_level();
+        // matrix[u * stride + v] - weight rank of the lightest edge (u, v), NO_EDGE without one
+        numa_vector<uint32_t> matrix;
+        std::vector<W> weight_by_rank;
+        // Scratch arrays of compute, kept between runs so that a reused instance does not allocate them again
+        numa_vector<uint64_t> dist, block_min;
+        numa_vector<uint32_t> parent;
+        double weight = 0;
+    };
+}// namespace algos
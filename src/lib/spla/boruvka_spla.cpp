@@ -1,11 +1,14 @@
 #include "boruvka_spla.hpp"
 
+#include "common/disjoint_set.hpp"
+#include "common/trace.hpp"
+
+#include <algorithm>
+#include <bit>
 #include <cmath>
 #include <fstream>
-#include <set>
 #include <spla.hpp>
 #include <sstream>
-#include <unordered_set>
 
 using namespace std;
 using namespace spla;
@@ -15,87 +18,55 @@ namespace algos {
     using clock = chrono::steady_clock;
     constexpr uint32_t INF = 1e9;
 
-    void BoruvkaSpla::load_graph(const filesystem::path &file_path) {
-        ifstream input(file_path);
-        string line;
-
-        // Skip comments
-        while (getline(input, line))
-            if (line[0] != '%') break;
-
-        int n_input, m_input, nnz_input;
-        istringstream iss(line);
-        iss >> n_input >> m_input >> nnz_input;
-        if (n_input < 0) {
-            throw runtime_error("Invalid mtx format, n < 0");
+    template<typename W>
+    void BoruvkaSpla<W>::load_graph(const filesystem::path &file_path) {
+        WeightedCsrGraph<W> g = load_weighted_csr<W>(file_path);
+        n = g.n;
+
+        // Replace weights by their ranks, this keeps the order and lets them share 32 bits with the index
+        weight_by_rank.assign(g.weights.begin(), g.weights.end());
+        ranges::sort(weight_by_rank);
+        weight_by_rank.erase(unique(weight_by_rank.begin(), weight_by_rank.end()), weight_by_rank.end());
+
+        index_bits = max<uint32_t>(1, bit_width(n > 0 ? n - 1 : 0u));
+        const uint32_t rank_bits = 32 - index_bits;
+        // the largest key is reserved for INF_ENCODED
+        if (weight_by_rank.size() >= (uint64_t(1) << rank_bits)) {
+            throw runtime_error("Too many distinct edge weights, max is " + std::to_string((uint64_t(1) << rank_bits) - 1));
         }
-        if (nnz_input < 0) {
-            throw runtime_error("Invalid mtx format, nnz < 0");
-        }
-        n = n_input;
-        edges = nnz_input;
-        buffer_int = vector<int>(n);
-        adj_list.resize(n);
 
-        constexpr uint32_t WEIGHT_SHIFT = 22;
         constexpr uint32_t INF_ENCODED = UINT32_MAX;
 
         a = Matrix::make(n, n, UINT);
         a->set_format(FormatMatrix::AccCsr);
         a->set_fill_value(Scalar::make_uint(INF_ENCODED));
 
-        int u, v;
-        uint32_t w;
-        for (int i = 0; i < nnz_input; ++i) {
-            input >> u >> v >> w;
-            u--;
-            v--;
-            if (u < 0 || v < 0 || u > n || v > n) {
-                throw runtime_error("Invalid graph, incorrect vertex numbers");
-            }
-            if (w >= (1 << 10)) {
-                throw runtime_error("Edge weight too large, max is 1023");
-            }
-
-            if (u != v) {
-                uint32_t encoded_u_v = (w << WEIGHT_SHIFT) | v;
-                uint32_t encoded_v_u = (w << WEIGHT_SHIFT) | u;
-
-                a->set_uint(u, v, encoded_u_v);
-                a->set_uint(v, u, encoded_v_u);
-
-                adj_list[u].emplace_back(v);
-                adj_list[v].emplace_back(u);
+        // The CSR holds both directions of every edge
+        for (uint u = 0; u < n; ++u) {
+            for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                const uint32_t rank = ranges::lower_bound(weight_by_rank, g.weights[e]) - weight_by_rank.begin();
+                a->set_uint(u, g.cols[e], (rank << index_bits) | g.cols[e]);
             }
         }
+        graph = std::move(static_cast<CsrGraph &>(g));
     }
 
-    chrono::milliseconds BoruvkaSpla::compute() {
+    template<typename W>
+    chrono::milliseconds BoruvkaSpla<W>::compute() {
         const auto start = clock::now();
         compute_();
         const auto end = clock::now();
         return chrono::duration_cast<chrono::milliseconds>(end - start);
     }
 
-    Tree BoruvkaSpla::get_result() {
-        const auto sparse_sz = Scalar::make_int(0);
-        vector p(n, -1);
-        ref_ptr<Vector> zero_vec = Vector::make(n, INT);
-        zero_vec->fill_with(spla::Scalar::make_int(0));
-        auto mst1 = Vector::make(n, INT);
-        mst1->set_fill_value(spla::Scalar::make_int(-1));
-        mst1->fill_with(spla::Scalar::make_int(-1));
-        exec_v_eadd(mst1, mst, zero_vec, spla::PLUS_INT);
-        exec_v_count_mf(sparse_sz, mst);
-        auto keys_view = MemView::make(buffer_int.data(), sparse_sz->as_int());
-        auto values_view = MemView::make(buffer_int.data(), sparse_sz->as_int());
-        mst1->read(keys_view, values_view);
-        const auto keys = static_cast<int *>(keys_view->get_buffer());
-        const auto values = static_cast<int *>(values_view->get_buffer());
-        for (int i = 0; i < sparse_sz->as_int(); i++) {
-            p[keys[i]] = static_cast<int>(std::round(values[i]));
-        }
-        return Tree{n, p, weight};
+    template<typename W>
+    Tree BoruvkaSpla<W>::get_result() {
+        return make_tree(n, mst_edges, weight);
+    }
+
+    template<typename W>
+    void BoruvkaSpla<W>::write_result(ResultSink &sink) {
+        export_forest(n, mst_edges, mst_weights, weight, sink);
     }
 
     // for debug
@@ -151,125 +122,104 @@ namespace algos {
     }
 
 
-    void BoruvkaSpla::compute_() {
-        mst = Vector::make(n, INT);
-        mst->set_fill_value(Scalar::make_int(-1));
-        mst->fill_with(Scalar::make_int(-1));
+    template<typename W>
+    void BoruvkaSpla<W>::compute_() {
+        mst_edges.clear();
+        mst_weights.clear();
         weight = 0;
 
-        constexpr uint32_t WEIGHT_SHIFT = 22;
-        constexpr uint32_t INDEX_MASK = (1 << 22) - 1;
+        const uint32_t WEIGHT_SHIFT = index_bits;
+        const uint32_t INDEX_MASK = (uint32_t(1) << index_bits) - 1;
         constexpr uint32_t INF_ENCODED = UINT32_MAX;
 
+        // f_array[v] - root of the component of v, refreshed from components after every round of merges
+        DisjointSet components(n);
         std::vector<uint32_t> f_array(n);
         for (uint v = 0; v < n; v++) {
             f_array[v] = v;
         }
 
         const auto edge = Vector::make(n, UINT);
-        std::vector edge_array(n, INF_ENCODED);
+        // cedge_array[c] - minimum edge of the component c, cedge_src[c] - the vertex it leaves from
         std::vector cedge_array(n, INF_ENCODED);
-
-        std::vector<std::vector<uint>> comp_to_vertices(n);
-        for (uint i = 0; i < n; i++) {
-            comp_to_vertices[i].push_back(i);
-        }
-
-        // Components that changed in the current iteration
-        std::set<uint> modified_comps;
+        std::vector<uint32_t> cedge_src(n);
+        // merged[c] - the component with root c grew in the current iteration
+        std::vector<uint8_t> merged(n);
+        // dropped[e] - the entry of graph.cols[e] is already INF_ENCODED in a
+        std::vector<uint8_t> dropped(graph.edges(), 0);
+        uint32_t edges_remaining = graph.edges();
 
         for (int iter = 0; iter < n; iter++) {
-            //cout << "Weight: " << weight << ", Iteration: " << iter << '\n';
-            modified_comps.clear();
+            ALGOS_TRACE_SCOPE(round, "boruvka_round");
+            round.arg("components", n - mst_edges.size());
+            round.arg("edges_remaining", edges_remaining);
             edge->set_fill_value(Scalar::make_uint(INF_ENCODED));
             edge->fill_with(Scalar::make_uint(INF_ENCODED));
 
             // Find the minimum edge for each vertex
             exec_m_reduce_by_row(edge, a, MIN_UINT, Scalar::make_uint(INF_ENCODED));
 
-            // Find the minimum edge for each component
+            // Find the minimum edge for each component and the vertex it leaves from
             ranges::fill(cedge_array, INF_ENCODED);
             for (uint v = 0; v < n; v++) {
                 const uint root = f_array[v];
 
                 uint edge_v;
                 edge->get_uint(v, edge_v);
-                edge_array[v] = edge_v;
 
                 if (edge_v < cedge_array[root]) {
                     cedge_array[root] = edge_v;
+                    cedge_src[root] = v;
                 }
             }
 
-            // Add edges to MST and merge components
+            // Add edges to MST and merge components, equal weights may close a cycle which is skipped
             bool added_edges = false;
-            for (uint i = 0; i < n; i++) {
-                uint comp_i = f_array[i];
-
-                if (i == comp_i) {// i - component root
-                    uint cedge_i = cedge_array[i];
-
-                    if (cedge_i != INF_ENCODED) {
-                        const uint dest = cedge_i & INDEX_MASK;
-                        const uint w = cedge_i >> WEIGHT_SHIFT;
-
-                        // Find the source of the minimum edge
-                        uint src = UINT_MAX;
-                        for (uint v: comp_to_vertices[comp_i]) {
-                            if (edge_array[v] == cedge_i) {
-                                src = v;
-                                break;
-                            }
-                        }
-
-                        if (src != UINT_MAX) {
-                            mst->set_int(src, dest);
-                            weight += w;
-                            added_edges = true;
-                        }
-
-                        uint comp_dest = f_array[dest];
-                        const uint new_comp = i < comp_dest ? i : comp_dest;
-
-                        modified_comps.insert(new_comp);
-
-                        if (new_comp != comp_i) {
-                            comp_to_vertices[new_comp].insert(
-                                    comp_to_vertices[new_comp].end(),
-                                    comp_to_vertices[comp_i].begin(),
-                                    comp_to_vertices[comp_i].end());
-                            comp_to_vertices[comp_i].clear();
-                        }
-                        if (new_comp != comp_dest) {
-                            comp_to_vertices[new_comp].insert(
-                                    comp_to_vertices[new_comp].end(),
-                                    comp_to_vertices[comp_dest].begin(),
-                                    comp_to_vertices[comp_dest].end());
-                            comp_to_vertices[comp_dest].clear();
-                        }
-
-                        for (uint v: comp_to_vertices[new_comp]) {
-                            f_array[v] = new_comp;
-                        }
-                    }
+            for (uint c = 0; c < n; c++) {
+                const uint cedge_c = cedge_array[c];
+                if (cedge_c == INF_ENCODED) continue;
+
+                const uint src = cedge_src[c];
+                const uint dest = cedge_c & INDEX_MASK;
+                if (components.unite(src, dest)) {
+                    mst_edges.emplace_back(src, dest);
+                    mst_weights.push_back(static_cast<double>(weight_by_rank[cedge_c >> WEIGHT_SHIFT]));
+                    weight += mst_weights.back();
+                    added_edges = true;
                 }
             }
 
             if (!added_edges) break;
 
-            // filter A matrix
-            for (const uint comp: modified_comps) {
-                const auto &vertices = comp_to_vertices[comp];
-                unordered_set set_vertices(vertices.begin(), vertices.end());
+            ranges::fill(merged, 0);
+            for (uint v = 0; v < n; v++) {
+                const uint32_t root = components.find(v);
+                if (root != f_array[v]) {
+                    merged[root] = 1;
+                    f_array[v] = root;
+                }
+            }
 
-                for (uint i: set_vertices) {
-                    for (uint j: adj_list[i]) {
-                        if (set_vertices.contains(j)) {
-                            a->set_uint(i, j, INF_ENCODED);
-                        }
+            // filter A matrix, only the components that grew may have new internal edges
+            for (uint v = 0; v < n; v++) {
+                if (!merged[f_array[v]]) continue;
+                for (uint32_t e = graph.offsets[v]; e < graph.offsets[v + 1]; ++e) {
+                    const uint32_t u = graph.cols[e];
+                    if (!dropped[e] && f_array[u] == f_array[v]) {
+                        a->set_uint(v, u, INF_ENCODED);
+                        dropped[e] = 1;
+                        --edges_remaining;
                     }
                 }
             }
         }
     }
+
+    template class BoruvkaSpla<uint8_t>;
+    template class BoruvkaSpla<uint16_t>;
+    template class BoruvkaSpla<uint32_t>;
+    template class BoruvkaSpla<uint64_t>;
+    template class BoruvkaSpla<int32_t>;
+    template class BoruvkaSpla<float>;
+    template class BoruvkaSpla<double>;
 }// namespace algos
@@ -1,9 +1,13 @@
 #pragma once
 
+#include "common/csr_graph.hpp"
 #include "common/mst_algorithm.hpp"
 #include <spla.hpp>
 
 namespace algos {
+    // Edges are packed into UINT keys (weight rank << index_bits) | dest, so any weight type works
+    // while the number of distinct weights fits into the bits left over by the vertex index
+    template<typename W = uint32_t>
     class BoruvkaSpla : public MstAlgorithm {
 
     public:
@@ -13,17 +17,22 @@ namespace algos {
 
         Tree get_result() final;
 
+        void write_result(ResultSink &sink) final;
+
     private:
         void compute_();
 
         std::unique_ptr<Tree> tree = nullptr;
         uint n;
-        int edges;
-        uint64_t weight = 0;
+        uint32_t index_bits = 1;
+        // weight_by_rank[r] - original weight of the edges with rank r, sorted ascending
+        std::vector<W> weight_by_rank;
+        double weight = 0;
         spla::ref_ptr<spla::Matrix> a;
-        spla::ref_ptr<spla::Vector> mst;
-        std::vector<std::vector<uint32_t>> adj_list;
-        std::vector<int> buffer_int;
-        std::vector<float> buffer_float;
+        // neighbour lists for dropping the edges that become internal to a component
+        CsrGraph graph;
+        std::vector<std::pair<uint32_t, uint32_t>> mst_edges;
+        // weight of every edge of mst_edges
+        std::vector<double> mst_weights;
     };
 }// namespace algos
@@ -1,45 +1,41 @@
 #include "parent_bfs_spla.hpp"
+#include "common/mtx_reader.hpp"
+#include "common/trace.hpp"
 #include "common/tree.hpp"
-#include <fstream>
+#include <algorithm>
+#include <limits>
 #include <spla.hpp>
 #include <vector>
 
 namespace algos {
     void ParentBfsSpla::load_graph(const std::filesystem::path &file_path) {
-        std::ifstream input(file_path);
-        std::string line;
-
-        // Skip comments
-        while (std::getline(input, line))
-            if (line[0] != '%') break;
-
-        int n_input, m_input, nnz_input;
-        std::istringstream iss(line);
-        iss >> n_input >> m_input >> nnz_input;
-        if (n_input < 0) {
-            throw std::runtime_error("Invalid mtx format, n < 0");
-        }
-        if (nnz_input < 0) {
-            throw std::runtime_error("Invalid mtx format, nnz < 0");
-        }
-        n = n_input;
-        edges_count = nnz_input;
+        GraphInput input;
+        // The parents are stored as int id + 1
+        const MtxHeader header = open_mtx_graph(file_path, input, std::numeric_limits<int32_t>::max() - 1);
+        n = static_cast<int>(header.n_rows);
+        edges_count = header.nnz;
+        // Only the structure is used, so every edge stores the same value
         a = spla::Matrix::make(n, n, spla::INT);
         a->set_fill_value(zero_int);
 
-        int u, v;
-        for (int i = 0; i < nnz_input; ++i) {
-            input >> u >> v;
-            u--;
-            v--;
-            if (u < 0 || v < 0 || u > n || v > n) {
-                throw std::runtime_error("Invalid graph, incorrect vertex numbers");
-            }
-            if (u != v) {
-                a->set_int(u, v, v + 1);
-                a->set_int(v, u, u + 1);
-            }
+        ids = spla::Vector::make(n, spla::INT);
+        ones = spla::Vector::make(n, spla::INT);
+        ones->fill_with(one_int);
+        for (int i = 0; i < n; i++) {
+            ids->set_int(i, i + 1);
         }
+
+        for_each_mtx_edge<NoWeight>(input, header, [this](uint32_t u, uint32_t v, NoWeight) {
+            a->set_int(u, v, 1);
+            a->set_int(v, u, 1);
+        });
+        seeds.clear();
+#if defined(ALGOS_TRACE)
+        // Every edge stores 1, so the row sums are the degrees
+        degree = spla::Vector::make(n, spla::INT);
+        degree->set_fill_value(zero_int);
+        spla::exec_m_reduce_by_row(degree, a, spla::PLUS_INT, zero_int);
+#endif
     }
 
     // for debug
@@ -69,70 +65,126 @@ namespace algos {
     void ParentBfsSpla::compute_() {
         using namespace spla;
 
+        // parent[v] = parent id + 1, 0 for not visited vertices, roots are their own parents
         parent = Vector::make(n, INT);
         parent->set_fill_value(zero_int);
 
-        auto update_parent = Vector::make(n, INT);
-        update_parent->set_fill_value(zero_int);
-
-        auto new_parent = Vector::make(n, INT);
-        new_parent->set_fill_value(zero_int);
+        // parent id + 1 of the vertices found on the current level
+        auto discovered = Vector::make(n, INT);
+        discovered->set_fill_value(zero_int);
 
-        //        auto visited = Vector::make(n, INT);
-        //        visited->set_fill_value(zero_int);
+        // feedback of the in-place parent update, not used
+        auto changed = Vector::make(n, INT);
+        changed->set_fill_value(zero_int);
 
-        auto new_front = Vector::make(n, INT);
-        new_front->set_fill_value(zero_int);
+        auto found = Vector::make(n, INT);
+        found->set_fill_value(zero_int);
 
-        auto prev_front = Vector::make(n, INT);
-        prev_front->set_fill_value(zero_int);
+        // frontier vertices carry their own id + 1 into the product
+        auto front = Vector::make(n, INT);
+        front->set_fill_value(zero_int);
 
         auto desc = Descriptor::make();
         desc->set_early_exit(true);
         desc->set_struct_only(true);
 
+        if (root && *root >= static_cast<uint32_t>(n)) {
+            throw std::runtime_error("Root vertex out of range");
+        }
+
+        // Searches from the vertices already set in parent and front until no vertex is discovered
+        auto front_size = Scalar::make_int(0);
+#if defined(ALGOS_TRACE)
+        auto front_degree = Vector::make(n, INT);
+        front_degree->set_fill_value(zero_int);
+        auto edges_scanned = Scalar::make_int(0);
+#endif
+        const auto expand = [&] {
+            while (front_size->as_int() > 0) {
+                ALGOS_TRACE_SCOPE(level, "bfs_level");
+                level.arg("frontier", front_size->as_int());
+#if defined(ALGOS_TRACE)
+                // Edges of the frontier, as in the native BFS, only computed for the trace
+                exec_v_emult(front_degree, front, degree, SECOND_INT);
+                exec_v_reduce(edges_scanned, zero_int, front_degree, PLUS_INT);
+                level.arg("edges_scanned", edges_scanned->as_int());
+#endif
+                // The only pass over the frontier edges: unvisited neighbours take the id of any frontier vertex
+                exec_vxm_masked(discovered, parent, front, a, FIRST_INT, FIRST_INT, EQZERO_INT, zero_int, desc);
+                exec_v_eadd_fdb(parent, discovered, changed, PLUS_INT);
+
+                exec_v_count_mf(front_size, discovered);
+
+                // Next frontier is ids restricted to the discovered vertices
+                exec_v_emult(found, discovered, ones, MIN_INT);
+                exec_v_emult(front, found, ids, MULT_INT);
+            }
+        };
+        const auto search_from = [&](int v) {
+            parent->set_int(v, v + 1);
+            front->set_int(v, v + 1);
+            front_size = Scalar::make_int(1);
+            expand();
+        };
+
+        if (root) {
+            search_from(static_cast<int>(*root));
+            return;
+        }
+
+        // All seeds start the first level together, the vertices are only scanned when they missed a component
+        if (!seeds.empty()) {
+            for (const uint32_t v: seeds) {
+                if (v >= static_cast<uint32_t>(n)) {
+                    throw std::runtime_error("Seed vertex out of range");
+                }
+                parent->set_int(v, v + 1);
+                front->set_int(v, v + 1);
+            }
+            exec_v_count_mf(front_size, front);
+            expand();
+            auto visited = Scalar::make_uint(0);
+            exec_v_count_mf(visited, parent);
+            if (visited->as_uint() == static_cast<uint32_t>(n)) return;
+        }
         for (int v = 0; v < n; v++) {
             int parent_v;
             parent->get_int(v, parent_v);
             if (parent_v == 0) {
-                parent->set_int(v, v + 1);
-                prev_front->set_int(v, v + 1);
-
-                auto front_size = Scalar::make_int(1);
-
-                while (front_size->as_int() > 0) {
-                    exec_vxm_masked(new_front, parent, prev_front, a, SECOND_INT, FIRST_INT, EQZERO_INT, zero_int, desc);
-                    exec_vxm_masked(update_parent, parent, prev_front, a, FIRST_INT, FIRST_INT, EQZERO_INT, zero_int, desc);
-                    exec_v_eadd(new_parent, update_parent, parent, PLUS_INT);
-
-                    exec_v_count_mf(front_size, new_front);
-
-                    std::swap(parent, new_parent);
-                    std::swap(prev_front, new_front);
-                }
+                search_from(v);
             }
         }
     }
 
     Tree ParentBfsSpla::get_result() {
-        std::vector<int> p(n, -1);
-        if (n <= 1 || edges_count == 0) {
-            return Tree{static_cast<uint>(n), p, 0};
-        }
-        auto sparse_sz = spla::Scalar::make_uint(0);
-        spla::exec_v_count_mf(sparse_sz, parent);
-        auto keys_view = spla::MemView::make(buffer1.data(), sparse_sz->as_uint());
-        auto values_view = spla::MemView::make(buffer2.data(), sparse_sz->as_uint());
-        parent->read(keys_view, values_view);
-        auto keys = (int *) keys_view->get_buffer();
-        auto values = (int *) values_view->get_buffer();
-        for (unsigned int i = 0; i < sparse_sz->as_uint(); i++) {
-            int cur_v = keys[i];
-            if (values[i] != keys[i] + 1) {
-                int cur_p = static_cast<int>(values[i]);
-                p[cur_v] = cur_p - 1;
+        TreeSink sink;
+        write_result(sink);
+        return sink.take();
+    }
+
+    void ParentBfsSpla::write_result(ResultSink &sink) {
+        // The sparse parents are read into the member buffers and scattered straight into the sink
+        const auto scatter = [this](auto p) {
+            std::ranges::fill(p, -1);
+            if (n <= 1 || edges_count == 0) return;
+            auto sparse_sz = spla::Scalar::make_uint(0);
+            spla::exec_v_count_mf(sparse_sz, parent);
+            auto keys_view = spla::MemView::make(buffer1.data(), sparse_sz->as_uint());
+            auto values_view = spla::MemView::make(buffer2.data(), sparse_sz->as_uint());
+            parent->read(keys_view, values_view);
+            auto keys = (int *) keys_view->get_buffer();
+            auto values = (int *) values_view->get_buffer();
+            for (unsigned int i = 0; i < sparse_sz->as_uint(); i++) {
+                int cur_v = keys[i];
+                if (values[i] != keys[i] + 1) {
+                    int cur_p = static_cast<int>(values[i]);
+                    p[cur_v] = cur_p - 1;
+                }
             }
-        }
-        return Tree{static_cast<uint>(n), p, 0};
+        };
+        const ParentSpan parents = sink.parents(n);
+        std::visit(scatter, parents);
+        export_levels(parents, sink, root);
+        sink.finish(0);
     }
 }// namespace algos
\ No newline at end of file
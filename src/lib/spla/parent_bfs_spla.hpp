@@ -15,15 +15,22 @@ namespace algos {
 
         Tree get_result() final;
 
+        void write_result(ResultSink &sink) final;
+
     private:
         void compute_();
 
         void print_vector(const spla::ref_ptr<spla::Vector> &v, const std::string &name = "");
 
         int n;
-        int edges_count;
+        int64_t edges_count;
         spla::ref_ptr<spla::Matrix> a;
         spla::ref_ptr<spla::Vector> parent;
+        // ids[v] = v + 1, ones[v] = 1
+        spla::ref_ptr<spla::Vector> ids;
+        spla::ref_ptr<spla::Vector> ones;
+        // degrees of the vertices, only with tracing
+        spla::ref_ptr<spla::Vector> degree;
         std::vector<int> buffer1;
         std::vector<int> buffer2;
         spla::ref_ptr<spla::Scalar> zero_int = spla::Scalar::make_int(0);
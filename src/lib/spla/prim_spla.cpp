@@ -1,57 +1,46 @@
 #include "prim_spla.hpp"
+#include "common/mtx_reader.hpp"
+#include "common/trace.hpp"
 #include "common/tree.hpp"
-#include <fstream>
+#include <algorithm>
+#include <limits>
 #include <set>
 #include <spla.hpp>
 #include <vector>
 
 namespace algos {
-    void PrimSpla::load_graph(const std::filesystem::path &file_path) {
-        std::ifstream input(file_path);
-        std::string line;
-
-        // Skip comments
-        while (std::getline(input, line))
-            if (line[0] != '%') break;
-
-        int n_input, m_input, nnz_input;
-        std::istringstream iss(line);
-        iss >> n_input >> m_input >> nnz_input;
-        if (n_input < 0) {
-            throw std::runtime_error("Invalid mtx format, n < 0");
-        }
-        if (nnz_input < 0) {
-            throw std::runtime_error("Invalid mtx format, nnz < 0");
-        }
-        n = n_input;
+    template<typename W>
+    void PrimSpla<W>::load_graph(const std::filesystem::path &file_path) {
+        GraphInput input;
+        // SPLA indices are int
+        const MtxHeader header = open_mtx_graph(file_path, input, std::numeric_limits<int32_t>::max());
+        n = header.n_rows;
         buffer1 = std::vector<unsigned int>(n);
-        buffer2 = std::vector<unsigned int>(n);
-        edges_count = nnz_input;
-        a = spla::Matrix::make(n, n, spla::UINT);
+        buffer2 = std::vector<S>(n);
+        edges_count = header.nnz;
+        a = spla::Matrix::make(n, n, SplaWeight<W>::type());
         a->set_format(spla::FormatMatrix::AccCsr);
-        a->set_fill_value(spla::Scalar::make_uint(INF));
+        a->set_fill_value(inf_w);
 
         int u, v;
-        int w;
-        for (int i = 0; i < nnz_input; ++i) {
-            input >> u >> v >> w;
+        for (int64_t i = 0; i < edges_count; ++i) {
+            input >> u >> v;
+            const W w = read_mtx_weight<W>(input, header.field);
             u--;
             v--;
-            if (u < 0 || v < 0 || u > n || v > n) {
+            if (u < 0 || v < 0 || u >= static_cast<int64_t>(n) || v >= static_cast<int64_t>(n)) {
                 throw std::runtime_error("Invalid graph, incorrect vertex numbers");
             }
-            if (w < 0) {
-                throw std::runtime_error("Invalid graph, negative edges");
-            }
             if (u != v) {
-                a->set_uint(u, v, w);
-                a->set_uint(v, u, w);
+                SplaWeight<W>::set(a, u, v, w);
+                SplaWeight<W>::set(a, v, u, w);
             }
         }
     }
 
     // for debug
-    void PrimSpla::print_vector(const spla::ref_ptr<spla::Vector> &v, const std::string &name) {
+    template<typename W>
+    void PrimSpla<W>::print_vector(const spla::ref_ptr<spla::Vector> &v, const std::string &name) {
         std::cout << "-- " << name << " --\n";
         auto sz = spla::Scalar::make_uint(0);
         spla::exec_v_count_mf(sz, v);
@@ -59,20 +48,21 @@ namespace algos {
         auto values_view = spla::MemView::make(buffer2.data(), sz->as_uint(), false);
         v->read(keys_view, values_view);
         auto keys = (unsigned int *) keys_view->get_buffer();
-        auto values = (unsigned int *) values_view->get_buffer();
+        auto values = (S *) values_view->get_buffer();
         for (unsigned int i = 0; i < sz->as_uint(); i++) {
             std::cout << keys[i] << " | " << values[i] << '\n';
         }
     }
 
-    void PrimSpla::update(std::set<std::pair<unsigned int, unsigned int>> &s, const spla::ref_ptr<spla::Vector> &v) {
+    template<typename W>
+    void PrimSpla<W>::update(std::set<std::pair<S, unsigned int>> &s, const spla::ref_ptr<spla::Vector> &v) {
         auto sz = spla::Scalar::make_uint(0);
         spla::exec_v_count_mf(sz, v);
         auto keys_view = spla::MemView::make(buffer1.data(), sz->as_uint(), false);
         auto values_view = spla::MemView::make(buffer2.data(), sz->as_uint(), false);
         v->read(keys_view, values_view);
         auto keys = (unsigned int *) keys_view->get_buffer();
-        auto values = (unsigned int *) values_view->get_buffer();
+        auto values = (S *) values_view->get_buffer();
         for (unsigned int i = 0; i < sz->as_uint(); i++) {
             s.insert({values[i], keys[i]});
         }
@@ -80,85 +70,113 @@ namespace algos {
 
     using clock = std::chrono::steady_clock;
 
-    std::chrono::milliseconds PrimSpla::compute() {
+    template<typename W>
+    std::chrono::milliseconds PrimSpla<W>::compute() {
         auto start = clock::now();
         compute_();
         auto end = clock::now();
         return std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     }
 
-    void PrimSpla::compute_() {
+    template<typename W>
+    void PrimSpla<W>::compute_() {
+        using SW = SplaWeight<W>;
+
         mst = spla::Vector::make(n, spla::UINT);
 
-        auto d = spla::Vector::make(n, spla::UINT);
-        auto changed = spla::Vector::make(n, spla::UINT);
-        auto v_row = spla::Vector::make(n, spla::UINT);
-        auto min_v = spla::Scalar::make_uint(INF);
+        auto d = spla::Vector::make(n, SW::type());
+        auto changed = spla::Vector::make(n, SW::type());
+        auto v_row = spla::Vector::make(n, SW::type());
 
-        changed->set_fill_value(zero_uint);
+        changed->set_fill_value(zero_w);
         mst->set_fill_value(inf_uint);
-        d->set_fill_value(inf_uint);
-        v_row->set_fill_value(inf_uint);
+        d->set_fill_value(inf_w);
+        v_row->set_fill_value(inf_w);
 
         weight = 0;
+        tree_weights.assign(n, 0);
         if (n <= 1 || edges_count == 0) {
             return;
         }
 
-        std::set<std::pair<unsigned int, unsigned int>> s;
+        std::set<std::pair<S, unsigned int>> s;
         std::vector<bool> visited(n, false);
 
         for (int i = 0; i < n; i++) {
             if (!visited[i]) {
                 unsigned int v = i;
-                d->set_uint(v, 0);
+                SW::set(d, v, VISITED);
                 visited[v] = true;
-                spla::exec_m_extract_row(v_row, a, v, spla::IDENTITY_UINT);
-                spla::exec_v_eadd_fdb(d, v_row, changed, spla::MIN_UINT);
+                spla::exec_m_extract_row(v_row, a, v, SW::identity());
+                spla::exec_v_eadd_fdb(d, v_row, changed, SW::min());
                 spla::exec_v_assign_masked(mst, changed, spla::Scalar::make_uint(v), spla::SECOND_UINT,
-                                           spla::NQZERO_UINT);
+                                           SW::nqzero());
 
                 update(s, changed);
+                ALGOS_TRACE_COUNTER("prim_queue", s.size());
                 while (!s.empty()) {
-                    unsigned int w = s.begin()->first;
+                    S w = s.begin()->first;
                     v = s.begin()->second;
                     s.erase(s.begin());
                     if (visited[v]) continue;
 
                     weight += w;
-                    d->set_uint(v, 0);
+                    tree_weights[v] = static_cast<double>(w);
+                    SW::set(d, v, VISITED);
                     visited[v] = true;
-                    spla::exec_m_extract_row(v_row, a, v, spla::IDENTITY_UINT);
-                    spla::exec_v_eadd_fdb(d, v_row, changed, spla::MIN_UINT);
+                    spla::exec_m_extract_row(v_row, a, v, SW::identity());
+                    spla::exec_v_eadd_fdb(d, v_row, changed, SW::min());
                     spla::exec_v_assign_masked(mst, changed, spla::Scalar::make_uint(v),
                                                spla::SECOND_UINT,
-                                               spla::NQZERO_UINT);
+                                               SW::nqzero());
 
                     update(s, changed);
+                    ALGOS_TRACE_COUNTER("prim_queue", s.size());
                 }
             }
         }
     }
 
-    Tree PrimSpla::get_result() {
-        std::vector<int> p(n, -1);
-        if (n <= 1 || edges_count == 0) {
-            return Tree{n, p, 0};
-        }
-        auto sparse_sz = spla::Scalar::make_uint(0);
-        spla::exec_v_count_mf(sparse_sz, mst);
-        auto keys_view = spla::MemView::make(buffer1.data(), sparse_sz->as_int());
-        auto values_view = spla::MemView::make(buffer2.data(), sparse_sz->as_int());
-        mst->read(keys_view, values_view);
-        auto keys = (int *) keys_view->get_buffer();
-        auto values = (unsigned int *) values_view->get_buffer();
-        for (int i = 0; i < sparse_sz->as_int(); i++) {
-            int cur_v = keys[i];
-            if (values[i] != INF) {
-                int cur_p = static_cast<int>(values[i]);
-                p[cur_v] = cur_p;
+    template<typename W>
+    Tree PrimSpla<W>::get_result() {
+        TreeSink sink;
+        write_result(sink);
+        return sink.take();
+    }
+
+    template<typename W>
+    void PrimSpla<W>::write_result(ResultSink &sink) {
+        // The sparse parents are read into the member buffers and scattered straight into the sink
+        const auto scatter = [this](auto p) {
+            std::ranges::fill(p, -1);
+            if (n <= 1 || edges_count == 0) return;
+            auto sparse_sz = spla::Scalar::make_uint(0);
+            spla::exec_v_count_mf(sparse_sz, mst);
+            auto keys_view = spla::MemView::make(buffer1.data(), sparse_sz->as_int());
+            auto values_view = spla::MemView::make(buffer2.data(), sparse_sz->as_int());
+            mst->read(keys_view, values_view);
+            auto keys = (int *) keys_view->get_buffer();
+            auto values = (unsigned int *) values_view->get_buffer();
+            for (int i = 0; i < sparse_sz->as_int(); i++) {
+                int cur_v = keys[i];
+                if (values[i] != UINT32_MAX) {
+                    int cur_p = static_cast<int>(values[i]);
+                    p[cur_v] = cur_p;
+                }
             }
+        };
+        const ParentSpan parents = sink.parents(n);
+        std::visit(scatter, parents);
+        export_levels(parents, sink);
+        if (const std::span<double> out = sink.edge_weights(n); !out.empty()) {
+            std::ranges::copy(tree_weights, out.begin());
         }
-        return Tree{n, p, weight};
+        sink.finish(n <= 1 || edges_count == 0 ? 0 : weight);
     }
+
+    template class PrimSpla<uint8_t>;
+    template class PrimSpla<uint16_t>;
+    template class PrimSpla<uint32_t>;
+    template class PrimSpla<int32_t>;
+    template class PrimSpla<float>;
 }// namespace algos
\ No newline at end of file
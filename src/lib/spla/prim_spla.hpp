@@ -1,12 +1,17 @@
 #pragma once
 
 #include "common/mst_algorithm.hpp"
+#include "spla/spla_weight.hpp"
 #include <chrono>
 #include <set>
 #include <spla.hpp>
 
 namespace algos {
+    template<typename W = uint32_t>
     class PrimSpla : public MstAlgorithm {
+        static_assert(SplaWeightType<W>, "SPLA has no storage type for this weight");
+
+        using S = typename SplaWeight<W>::value_type;
 
     public:
         void load_graph(const std::filesystem::path &file_path) final;
@@ -15,22 +20,32 @@ namespace algos {
 
         Tree get_result() final;
 
+        void write_result(ResultSink &sink) final;
+
     private:
         void compute_();
 
         void print_vector(const spla::ref_ptr<spla::Vector> &v, const std::string &name = "");
 
-        void update(std::set<std::pair<unsigned int, unsigned int>> &s, const spla::ref_ptr<spla::Vector> &v);
+        void update(std::set<std::pair<S, unsigned int>> &s, const spla::ref_ptr<spla::Vector> &v);
 
         uint n;
-        int edges_count;
-        const unsigned int INF = UINT32_MAX;
-        unsigned long long weight = 0;
+        int64_t edges_count;
+        const S INF = std::numeric_limits<S>::max();
+        // distance of the vertices already in the tree, no edge can lower it
+        const S VISITED = std::numeric_limits<S>::lowest();
+        double weight = 0;
+        // weight of the edge through which every vertex joined the tree, 0 for the roots
+        std::vector<double> tree_weights;
         spla::ref_ptr<spla::Matrix> a;
         spla::ref_ptr<spla::Vector> mst;
         std::vector<unsigned int> buffer1;
-        std::vector<unsigned int> buffer2;
-        spla::ref_ptr<spla::Scalar> inf_uint = spla::Scalar::make_uint(INF);
-        spla::ref_ptr<spla::Scalar> zero_uint = spla::Scalar::make_uint(0);
+        std::vector<S> buffer2;
+        spla::ref_ptr<spla::Scalar> inf_w = SplaWeight<W>::scalar(INF);
+        spla::ref_ptr<spla::Scalar> inf_uint = spla::Scalar::make_uint(UINT32_MAX);
+        spla::ref_ptr<spla::Scalar> zero_w = SplaWeight<W>::scalar(0);
     };
+
+    template<typename W>
+    inline constexpr bool supports_weight_v<PrimSpla, W> = SplaWeightType<W>;
 }// namespace algos
\ No newline at end of file
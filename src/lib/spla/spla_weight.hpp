@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <spla.hpp>
+
+namespace algos {
+    // SPLA storage type and operations for an edge weight type.
+    // SPLA only has 32-bit INT, UINT and FLOAT, narrower unsigned weights are widened to UINT
+    template<typename W>
+    struct SplaWeight;
+
+    template<>
+    struct SplaWeight<uint32_t> {
+        using value_type = uint32_t;
+
+        static spla::ref_ptr<spla::Type> type() { return spla::UINT; }
+        static spla::ref_ptr<spla::Scalar> scalar(value_type v) { return spla::Scalar::make_uint(v); }
+        static void set(const spla::ref_ptr<spla::Matrix> &m, uint i, uint j, value_type v) { m->set_uint(i, j, v); }
+        static void set(const spla::ref_ptr<spla::Vector> &v, uint i, value_type x) { v->set_uint(i, x); }
+        static spla::ref_ptr<spla::OpBinary> min() { return spla::MIN_UINT; }
+        static spla::ref_ptr<spla::OpBinary> second() { return spla::SECOND_UINT; }
+        static spla::ref_ptr<spla::OpUnary> identity() { return spla::IDENTITY_UINT; }
+        static spla::ref_ptr<spla::OpSelect> nqzero() { return spla::NQZERO_UINT; }
+    };
+
+    template<>
+    struct SplaWeight<uint8_t> : SplaWeight<uint32_t> {};
+
+    template<>
+    struct SplaWeight<uint16_t> : SplaWeight<uint32_t> {};
+
+    template<>
+    struct SplaWeight<int32_t> {
+        using value_type = int32_t;
+
+        static spla::ref_ptr<spla::Type> type() { return spla::INT; }
+        static spla::ref_ptr<spla::Scalar> scalar(value_type v) { return spla::Scalar::make_int(v); }
+        static void set(const spla::ref_ptr<spla::Matrix> &m, uint i, uint j, value_type v) { m->set_int(i, j, v); }
+        static void set(const spla::ref_ptr<spla::Vector> &v, uint i, value_type x) { v->set_int(i, x); }
+        static spla::ref_ptr<spla::OpBinary> min() { return spla::MIN_INT; }
+        static spla::ref_ptr<spla::OpBinary> second() { return spla::SECOND_INT; }
+        static spla::ref_ptr<spla::OpUnary> identity() { return spla::IDENTITY_INT; }
+        static spla::ref_ptr<spla::OpSelect> nqzero() { return spla::NQZERO_INT; }
+    };
+
+    template<>
+    struct SplaWeight<float> {
+        using value_type = float;
+
+        static spla::ref_ptr<spla::Type> type() { return spla::FLOAT; }
+        static spla::ref_ptr<spla::Scalar> scalar(value_type v) { return spla::Scalar::make_float(v); }
+        static void set(const spla::ref_ptr<spla::Matrix> &m, uint i, uint j, value_type v) { m->set_float(i, j, v); }
+        static void set(const spla::ref_ptr<spla::Vector> &v, uint i, value_type x) { v->set_float(i, x); }
+        static spla::ref_ptr<spla::OpBinary> min() { return spla::MIN_FLOAT; }
+        static spla::ref_ptr<spla::OpBinary> second() { return spla::SECOND_FLOAT; }
+        static spla::ref_ptr<spla::OpUnary> identity() { return spla::IDENTITY_FLOAT; }
+        static spla::ref_ptr<spla::OpSelect> nqzero() { return spla::NQZERO_FLOAT; }
+    };
+
+    template<typename W>
+    concept SplaWeightType = requires { typename SplaWeight<W>::value_type; };
+}// namespace algos
@@ -0,0 +1,103 @@
+#include "autotune/auto_mst.hpp"
+#include "autotune/cost_model.hpp"
+#include "common/graph_features.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <numeric>
+
+namespace tests {
+    TEST(GraphFeaturesTest, CountsDegreesAndDiameter) {
+        // Trefethen_2000 is connected with 2000 vertices
+        const auto file = std::filesystem::path(DATA_DIR) / "Trefethen_2000.mtx";
+        const algos::CsrGraph g = algos::load_csr(file);
+        const algos::GraphFeatures f = algos::compute_graph_features(g);
+        ASSERT_EQ(2000u, f.n);
+        ASSERT_EQ(g.edges(), f.m);
+        ASSERT_EQ(2000u, std::accumulate(f.degree_histogram.begin(), f.degree_histogram.end(), 0u));
+        ASSERT_EQ(0u, f.degree_histogram[0]);
+        ASSERT_GT(f.diameter, 0u);
+        ASSERT_LT(f.diameter, f.n);
+
+        const algos::GraphFeatures point = algos::compute_graph_features(algos::load_csr(std::filesystem::path(DATA_DIR) / "point.mtx"));
+        ASSERT_EQ(0u, point.m);
+        ASSERT_EQ(0u, point.diameter);
+        ASSERT_EQ(0, point.degree_skew);
+    }
+
+    TEST(GraphFeaturesTest, DegreeSkewGrowsWithHubs) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_graph_features_test.mtx";
+        // A cycle of 8 vertices, then a star with the same number of edges
+        std::ofstream(path) << "%%MatrixMarket matrix coordinate pattern symmetric\n8 8 8\n"
+                            << "2 1\n3 2\n4 3\n5 4\n6 5\n7 6\n8 7\n8 1\n";
+        const algos::GraphFeatures cycle = algos::compute_graph_features(algos::load_csr(path));
+        std::ofstream(path) << "%%MatrixMarket matrix coordinate pattern symmetric\n9 9 8\n"
+                            << "2 1\n3 1\n4 1\n5 1\n6 1\n7 1\n8 1\n9 1\n";
+        const algos::GraphFeatures star = algos::compute_graph_features(algos::load_csr(path));
+        std::filesystem::remove(path);
+        ASSERT_EQ(2, cycle.mean_degree);
+        ASSERT_NEAR(0, cycle.degree_skew, 1e-12);
+        ASSERT_EQ(8u, star.max_degree);
+        ASSERT_GT(star.degree_skew, 1);
+    }
+
+    TEST(CostModelTest, FitRecoversLinearCost) {
+        // time = 2 + 0.001 * m + 0.5 * diameter
+        std::vector<algos::CostSample> samples;
+        for (uint32_t i = 1; i <= 8; ++i) {
+            algos::GraphFeatures f;
+            f.n = 100 * i;
+            f.m = 1000 * i * i;
+            f.diameter = 10 + (i * 7) % 5;
+            samples.push_back({f, 2 + 0.001 * static_cast<double>(f.m) + 0.5 * f.diameter});
+        }
+        const algos::CostCoefficients c = algos::fit_cost_model(samples);
+        for (const auto &s: samples) {
+            ASSERT_NEAR(s.milliseconds, algos::predict_cost(c, s.features), 1e-2 * s.milliseconds);
+        }
+        for (const double x: c) {
+            ASSERT_GE(x, 0);
+        }
+    }
+
+    TEST(CostModelTest, SavesAndLoads) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_cost_model_test.txt";
+        algos::CostModel model;
+        model.set("BoruvkaNative@4", {1, 2, 3, 4, 5, 6, 7});
+        model.save(path);
+        const auto loaded = algos::CostModel::load(path);
+        std::filesystem::remove(path);
+        ASSERT_EQ(model.get("BoruvkaNative@4"), loaded.get("BoruvkaNative@4"));
+        ASSERT_FALSE(loaded.get("PrimSpla").has_value());
+
+        // Models saved without the degree terms leave them at 0
+        std::ofstream(path) << "PrimSpla 1 2 3 4 5 6 7\n";
+        const auto old = algos::CostModel::load(path);
+        std::filesystem::remove(path);
+        ASSERT_EQ((algos::CostCoefficients{1, 2, 3, 4, 5, 6, 7, 0, 0}), old.get("PrimSpla"));
+    }
+
+    TEST(AutoMstTest, PicksCheapestCandidate) {
+        // Only BoruvkaNative@1 is cheap, everything else is priced out
+        algos::CostModel model;
+        for (const auto &candidate: algos::AutoMst::candidates()) {
+            model.set(candidate.key(), {candidate.key() == "BoruvkaNative@1" ? 0.0 : 1e9, 0, 0, 0, 0, 0, 0});
+        }
+        algos::AutoMst algo(model);
+        algo.load_graph(std::filesystem::path(DATA_DIR) / "test1.mtx");
+        ASSERT_EQ("BoruvkaNative@1", algo.chosen_candidate());
+        algo.compute();
+        ASSERT_EQ(22, algo.get_result().weight);
+        // The graph lent to the candidate is not kept
+        ASSERT_EQ(0u, algos::GraphCache::instance().bytes());
+    }
+
+    TEST(AutoMstTest, ParsedGraphPicksWeightType) {
+        for (const auto *filename: {"Trefethen_2000.mtx", "test1_negative.mtx", "test1_real.mtx", "point.mtx"}) {
+            const auto file = std::filesystem::path(DATA_DIR) / filename;
+            const algos::ParsedGraph parsed(file, true);
+            ASSERT_EQ(algos::detect_weight_type(file), parsed.weight_type()) << filename;
+            ASSERT_EQ(algos::compute_graph_features(algos::load_csr(file)).m, parsed.features().m) << filename;
+        }
+    }
+}// namespace tests
@@ -0,0 +1,73 @@
+#include "common/batch.hpp"
+#include "native/boruvka_native.hpp"
+#include "native/parent_bfs_native.hpp"
+#include "test_commons.hpp"
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+namespace tests {
+    std::vector<std::filesystem::path> batch_graphs(size_t repeat) {
+        const std::filesystem::path files[] = {"test1.mtx", "small.mtx", "two_components_int.mtx", "Trefethen_2000.mtx", "point.mtx"};
+        std::vector<std::filesystem::path> res;
+        for (size_t r = 0; r < repeat; ++r) {
+            for (const auto &file: files) {
+                res.push_back(std::filesystem::path(DATA_DIR) / file);
+            }
+        }
+        return res;
+    }
+
+    TEST(BatchTest, MatchesSequentialRuns) {
+        const auto graphs = batch_graphs(8);
+        std::vector<double> expected;
+        for (const auto &path: graphs) {
+            algos::BoruvkaNative<double> algo;
+            algo.load_graph(path);
+            algo.compute();
+            expected.push_back(algo.get_result().weight);
+        }
+
+        for (const unsigned workers: {1u, 2u, 4u}) {
+            std::vector<double> weights(graphs.size(), -1);
+            const algos::BatchStats stats = algos::run_batch<algos::BoruvkaNative<double>>(
+                    graphs, [] { return std::make_unique<algos::BoruvkaNative<double>>(); },
+                    [&](size_t i, algos::BoruvkaNative<double> &algo) { weights[i] = algo.get_result().weight; }, workers);
+            ASSERT_EQ(graphs.size(), stats.graphs);
+            ASSERT_EQ(0u, stats.failed) << stats.first_error;
+            ASSERT_EQ(workers, stats.workers);
+            ASSERT_GT(stats.graphs_per_second(), 0);
+            ASSERT_EQ(expected, weights);
+        }
+    }
+
+    TEST(BatchTest, ReusedInstanceBuildsForests) {
+        const auto graphs = batch_graphs(4);
+        std::vector<int> vertices(graphs.size(), -1);
+        const algos::BatchStats stats = algos::run_batch<algos::ParentBfsNative>(
+                graphs, [] { return std::make_unique<algos::ParentBfsNative>(); },
+                [&](size_t i, algos::ParentBfsNative &algo) {
+                    const algos::Tree tree = algo.get_result();
+                    ASSERT_TRUE(is_tree_or_forest(tree.parent));
+                    vertices[i] = static_cast<int>(tree.n);
+                },
+                3);
+        ASSERT_EQ(0u, stats.failed) << stats.first_error;
+        for (size_t i = 0; i < graphs.size(); ++i) {
+            ASSERT_EQ(static_cast<int>(algos::load_csr(graphs[i]).n), vertices[i]);
+        }
+    }
+
+    TEST(BatchTest, FailedGraphsAreCounted) {
+        auto graphs = batch_graphs(2);
+        graphs.insert(graphs.begin() + 3, std::filesystem::path(DATA_DIR) / "missing.mtx");
+        size_t done = 0;
+        const algos::BatchStats stats = algos::run_batch<algos::BoruvkaNative<double>>(
+                graphs, [] { return std::make_unique<algos::BoruvkaNative<double>>(); },
+                [&](size_t, algos::BoruvkaNative<double> &) { ++done; }, 1);
+        ASSERT_EQ(1u, stats.failed);
+        ASSERT_EQ(graphs.size() - 1, done);
+        ASSERT_NE(std::string::npos, stats.first_error.find("missing.mtx"));
+    }
+}// namespace tests
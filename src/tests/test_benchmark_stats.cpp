@@ -0,0 +1,70 @@
+#include "common/benchmark_stats.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+
+namespace tests {
+    std::vector<double> noisy_times(double mean, size_t count, uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        std::normal_distribution<double> noise(mean, mean * 0.02);
+        std::vector<double> res(count);
+        for (auto &x: res) x = noise(rng);
+        return res;
+    }
+
+    TEST(BenchmarkStatsTest, MannWhitney) {
+        const auto a = noisy_times(100, 20, 1), b = noisy_times(100, 20, 2), slow = noisy_times(110, 20, 3);
+        ASSERT_GT(algos::mann_whitney_p(a, b), 0.05);
+        ASSERT_LT(algos::mann_whitney_p(a, slow), 1e-4);
+        ASSERT_EQ(algos::mann_whitney_p(a, slow), algos::mann_whitney_p(slow, a));
+        // all ties, e.g. times that round to the same milliseconds
+        ASSERT_EQ(1, algos::mann_whitney_p({3, 3, 3}, {3, 3}));
+        ASSERT_EQ(1, algos::mann_whitney_p({}, {1, 2}));
+    }
+
+    TEST(BenchmarkStatsTest, BootstrapCoversSpeedup) {
+        const auto base = noisy_times(100, 30, 4), fast = noisy_times(50, 30, 5);
+        const algos::Interval interval = algos::bootstrap_speedup(base, fast, 0.95, 1000);
+        ASSERT_LT(interval.low, 2.0);
+        ASSERT_GT(interval.high, 2.0);
+        ASSERT_GT(interval.low, 1.8);
+        ASSERT_EQ(2.5, algos::median({4, 1, 2, 3}));
+    }
+
+    TEST(BenchmarkStatsTest, FlagsOnlySignificantSlowdowns) {
+        const std::vector<algos::BenchmarkSamples> baseline = {
+                {"BoruvkaNative", "a.mtx", noisy_times(100, 20, 6)},
+                {"BoruvkaNative", "b.mtx", noisy_times(100, 20, 7)},
+                {"BfsNative", "a.mtx", noisy_times(100, 20, 8)},
+                {"PrimSpla", "a.mtx", noisy_times(100, 20, 9)}};
+        const std::vector<algos::BenchmarkSamples> candidate = {
+                {"BfsNative", "a.mtx", noisy_times(80, 20, 10)},
+                {"BoruvkaNative", "b.mtx", noisy_times(101, 20, 11)},
+                {"BoruvkaNative", "a.mtx", noisy_times(120, 20, 12)}};
+        const auto res = algos::compare_benchmarks(baseline, candidate, algos::CompareOptions{});
+        ASSERT_EQ(3u, res.size());
+        ASSERT_EQ("a.mtx", res[0].graph);
+        ASSERT_TRUE(res[0].regression);
+        ASSERT_LT(res[0].speedup, 0.9);
+        ASSERT_FALSE(res[1].regression);
+        ASSERT_FALSE(res[2].regression);
+        ASSERT_GT(res[2].speedup, 1.1);
+    }
+
+    TEST(BenchmarkStatsTest, ReadsResultFiles) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_benchmark_stats_test.csv";
+        {
+            std::ofstream file(path);
+            file << "Algorithm,Graph,Run,1,2,3\nPrimSpla,small.mtx,4,5.5,6\nBfsNative,small.mtx,1\n";
+        }
+        const auto samples = algos::read_benchmark_csv(path);
+        std::filesystem::remove(path);
+        ASSERT_EQ(2u, samples.size());
+        ASSERT_EQ("PrimSpla", samples[0].algorithm);
+        ASSERT_EQ((std::vector<double>{4, 5.5, 6}), samples[0].times);
+        ASSERT_EQ("small.mtx", samples[1].graph);
+        ASSERT_EQ(1u, samples[1].times.size());
+        ASSERT_THROW(algos::read_benchmark_csv(path), std::runtime_error);
+    }
+}// namespace tests
@@ -23,7 +23,7 @@ namespace tests {
         return acc;
     };
 
-    inline bool is_tree_or_forest(const std::vector<int> &parent) {
+    inline bool is_tree_or_forest(const std::vector<int64_t> &parent) {
         int n = int(parent.size());
         std::vector visited(n, false);
         std::vector<std::vector<int>> g(n);
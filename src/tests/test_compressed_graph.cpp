@@ -0,0 +1,66 @@
+#include "common/compressed_graph.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <tuple>
+#include <vector>
+
+namespace tests {
+    TEST(CompressedGraphTest, VarintRoundTrip) {
+        std::vector<uint8_t> bytes;
+        const std::vector<uint32_t> values = {0, 1, 127, 128, 300, 16383, 16384, UINT32_MAX};
+        for (const uint32_t x: values) {
+            algos::CompressedGraph::encode_varint(x, bytes);
+        }
+        ASSERT_EQ(1 + 1 + 1 + 2 + 2 + 2 + 3 + 5, bytes.size());
+        const uint8_t *p = bytes.data();
+        for (const uint32_t x: values) {
+            ASSERT_EQ(x, algos::CompressedGraph::decode_varint(p));
+        }
+        ASSERT_EQ(bytes.data() + bytes.size(), p);
+    }
+
+    TEST(CompressedGraphTest, DecodesSortedNeighbours) {
+        for (const char *filename: {"point.mtx", "test1.mtx", "Trefethen_2000.mtx", "two_components_unw.mtx"}) {
+            const auto file = std::filesystem::path(DATA_DIR) / filename;
+            const algos::CsrGraph csr = algos::load_csr(file);
+            const algos::CompressedGraph compressed = algos::CompressedGraph::compress(csr);
+            ASSERT_EQ(csr.n, compressed.vertices());
+            ASSERT_EQ(csr.edges(), compressed.edges());
+            for (uint32_t v = 0; v < csr.n; ++v) {
+                std::vector<uint32_t> expected(csr.neighbors(v).begin(), csr.neighbors(v).end()), actual;
+                std::ranges::sort(expected);
+                compressed.for_each_neighbor(v, [&](uint32_t u) { actual.push_back(u); });
+                ASSERT_EQ(expected, actual) << filename << " " << v;
+                ASSERT_EQ(csr.degree(v), compressed.degree(v));
+            }
+        }
+    }
+
+    TEST(CompressedGraphTest, EdgeListMatchesCsr) {
+        for (const char *filename: {"point.mtx", "test1.mtx", "Trefethen_2000.mtx", "two_components_int.mtx"}) {
+            const auto file = std::filesystem::path(DATA_DIR) / filename;
+            const auto edges = algos::load_edge_list<uint32_t>(file);
+            const auto csr = algos::load_weighted_csr<uint32_t>(file);
+            ASSERT_EQ(csr.edges(), 2 * edges.edges());
+            for (size_t e = 0; e < edges.edges(); ++e) {
+                ASSERT_LT(edges.src[e], edges.dst[e]);
+            }
+            ASSERT_LT(edges.memory_bytes(), csr.memory_bytes() + csr.weights.size() * sizeof(uint32_t));
+
+            // the CSR holds every edge of the list in both directions
+            std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> expected, actual;
+            for (uint32_t v = 0; v < csr.n; ++v) {
+                for (uint32_t e = csr.offsets[v]; e < csr.offsets[v + 1]; ++e) {
+                    if (v < csr.cols[e]) expected.emplace_back(v, csr.cols[e], csr.weights[e]);
+                }
+            }
+            for (size_t e = 0; e < edges.edges(); ++e) {
+                actual.emplace_back(edges.src[e], edges.dst[e], edges.weights[e]);
+            }
+            std::ranges::sort(expected);
+            std::ranges::sort(actual);
+            ASSERT_EQ(expected, actual) << filename;
+        }
+    }
+}// namespace tests
@@ -0,0 +1,78 @@
+#include "common/connected_components_algorithm.hpp"
+#include "common/csr_graph.hpp"
+#include "lagraph/connected_components_lagraph.hpp"
+#include "native/afforest_native.hpp"
+#include "native/fast_sv_native.hpp"
+#include "native/parent_bfs_native.hpp"
+#include "test_commons.hpp"
+#include <filesystem>
+#include <gtest/gtest.h>
+
+namespace tests {
+    // Labels by the smallest vertex of every component, found by a sequential BFS
+    inline std::vector<uint32_t> reference_labels(const algos::CsrGraph &g) {
+        std::vector<uint32_t> label(g.n, UINT32_MAX);
+        for (uint32_t root = 0; root < g.n; ++root) {
+            if (label[root] != UINT32_MAX) continue;
+            label[root] = root;
+            std::vector<uint32_t> queue = {root};
+            for (size_t head = 0; head < queue.size(); ++head) {
+                for (const uint32_t v: g.neighbors(queue[head])) {
+                    if (label[v] == UINT32_MAX) {
+                        label[v] = root;
+                        queue.push_back(v);
+                    }
+                }
+            }
+        }
+        return label;
+    }
+
+    template<typename T>
+    class ConnectedComponentsTest : public ::testing::Test {
+    protected:
+        T algo;
+    };
+
+    using AlgosTypes = ::testing::Types<algos::AfforestNative, algos::FastSvNative, algos::ConnectedComponentsLagraph>;
+    TYPED_TEST_SUITE(ConnectedComponentsTest, AlgosTypes);
+
+    static const std::pair<std::string, uint32_t> cc_test_cases[] = {
+            {"point.mtx", 1},
+            {"one_edge.mtx", 1},
+            {"test1_unweighted.mtx", 2},
+            {"small_unweighted.mtx", 1962},
+            {"two_components_unw.mtx", 2},
+            {"Trefethen_2000.mtx", 1}};
+
+    TYPED_TEST(ConnectedComponentsTest, MatchesSequentialBfs) {
+        for (const auto &[filename, count]: cc_test_cases) {
+            auto file = std::filesystem::path(DATA_DIR) / filename;
+            this->algo.load_graph(file);
+            this->algo.compute();
+            const algos::Components res = this->algo.get_result();
+            ASSERT_EQ(count, res.count) << filename;
+            ASSERT_EQ(reference_labels(algos::load_csr(file)), res.label) << filename;
+        }
+    }
+
+    TEST(ConnectedComponentsTest, RootsSeedForestBfs) {
+        auto file = std::filesystem::path(DATA_DIR) / "two_components_unw.mtx";
+        algos::AfforestNative cc;
+        cc.load_graph(file);
+        cc.compute();
+        const auto roots = algos::component_roots(cc.get_result());
+        ASSERT_EQ(2u, roots.size());
+
+        algos::ParentBfsNative bfs;
+        bfs.load_graph(file);
+        bfs.seed_roots(roots);
+        bfs.compute();
+        const auto res = bfs.get_result();
+        ASSERT_TRUE(is_tree_or_forest(res.parent));
+        for (const uint32_t root: roots) {
+            ASSERT_EQ(-1, res.parent[root]);
+        }
+        ASSERT_EQ(2, std::count(res.parent.begin(), res.parent.end(), -1));
+    }
+}// namespace tests
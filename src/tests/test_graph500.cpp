@@ -0,0 +1,89 @@
+#include "common/graph500.hpp"
+#include "native/parent_bfs_native.hpp"
+#include <filesystem>
+#include <gtest/gtest.h>
+
+namespace tests {
+    TEST(Graph500Test, KroneckerGraphIsDeterministic) {
+        const algos::EdgeList a = algos::kronecker_graph(10, 8, 7);
+        const algos::EdgeList b = algos::kronecker_graph(10, 8, 7);
+        ASSERT_EQ(1024u, a.n);
+        ASSERT_EQ(8u * 1024, a.edges.size());
+        ASSERT_EQ(a.edges, b.edges);
+        ASSERT_NE(a.edges, algos::kronecker_graph(10, 8, 8).edges);
+        for (const auto &[u, v]: a.edges) {
+            ASSERT_LT(u, a.n);
+            ASSERT_LT(v, a.n);
+        }
+    }
+
+    TEST(Graph500Test, TreesOfKroneckerGraphAreValid) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_graph500_test.mtx";
+        algos::write_mtx(path, algos::kronecker_graph(10));
+        const algos::CsrGraph g = algos::load_csr(path);
+        const auto roots = algos::sample_roots(g, 16);
+        ASSERT_EQ(16u, roots.size());
+
+        algos::ParentBfsNative bfs;
+        bfs.load_graph(path);
+        std::filesystem::remove(path);
+        for (const uint32_t root: roots) {
+            ASSERT_GT(g.degree(root), 0u);
+            bfs.set_root(root);
+            bfs.compute();
+            auto parent = bfs.get_result().parent;
+            const uint64_t edges = algos::validate_bfs_tree(g, root, parent);
+            ASSERT_GT(edges, 0u);
+            ASSERT_LE(edges, g.edges() / 2);
+
+            // a vertex hung under the root skips levels unless it is a neighbour of the root
+            for (uint32_t v = 0; v < g.n; ++v) {
+                if (parent[v] != -1 && parent[parent[v]] != -1) {
+                    auto broken = parent;
+                    broken[v] = static_cast<int>(root);
+                    ASSERT_ANY_THROW(algos::validate_bfs_tree(g, root, broken));
+                    break;
+                }
+            }
+            for (uint32_t v = 0; v < g.n; ++v) {
+                if (parent[v] != -1 && parent[v] != static_cast<int>(root)) {
+                    auto cycle = parent;
+                    cycle[parent[v]] = static_cast<int>(v);
+                    ASSERT_ANY_THROW(algos::validate_bfs_tree(g, root, cycle));
+                    break;
+                }
+            }
+        }
+    }
+
+    TEST(Graph500Test, UnreachedVertexIsRejected) {
+        const algos::CsrGraph g = algos::load_csr(std::filesystem::path(DATA_DIR) / "test1_unweighted.mtx");
+        algos::ParentBfsNative bfs;
+        bfs.load_graph(std::filesystem::path(DATA_DIR) / "test1_unweighted.mtx");
+        const uint32_t root = algos::sample_roots(g, 1)[0];
+        bfs.set_root(root);
+        bfs.compute();
+        auto parent = bfs.get_result().parent;
+        algos::validate_bfs_tree(g, root, parent);
+        for (uint32_t v = 0; v < g.n; ++v) {
+            if (parent[v] != -1) {
+                parent[v] = -1;
+                break;
+            }
+        }
+        ASSERT_ANY_THROW(algos::validate_bfs_tree(g, root, parent));
+    }
+
+    TEST(Graph500Test, TepsStatistics) {
+        const algos::TepsStatistics stats = algos::teps_statistics({4, 1, 2, 4, 1});
+        ASSERT_DOUBLE_EQ(1, stats.min);
+        ASSERT_DOUBLE_EQ(1, stats.first_quartile);
+        ASSERT_DOUBLE_EQ(2, stats.median);
+        ASSERT_DOUBLE_EQ(4, stats.third_quartile);
+        ASSERT_DOUBLE_EQ(4, stats.max);
+        // 5 / (1 + 1 + 0.5 + 0.25 + 0.25)
+        ASSERT_DOUBLE_EQ(5.0 / 3, stats.harmonic_mean);
+        ASSERT_GT(stats.harmonic_stddev, 0);
+        ASSERT_ANY_THROW(algos::teps_statistics({}));
+    }
+}// namespace tests
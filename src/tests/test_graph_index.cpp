@@ -0,0 +1,98 @@
+#include "common/csr_graph.hpp"
+#include "common/graph500.hpp"
+#include "common/graph_index.hpp"
+#include "common/tree.hpp"
+#include "native/parent_bfs_native.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+namespace tests {
+    template<typename A, typename B>
+    void expect_same_structure(const A &a, const B &b) {
+        ASSERT_EQ(a.n, b.n);
+        ASSERT_EQ(a.offsets.size(), b.offsets.size());
+        ASSERT_EQ(a.cols.size(), b.cols.size());
+        for (size_t i = 0; i < a.offsets.size(); ++i) {
+            ASSERT_EQ(a.offsets[i], b.offsets[i]);
+        }
+        for (size_t i = 0; i < a.cols.size(); ++i) {
+            ASSERT_EQ(a.cols[i], b.cols[i]);
+        }
+    }
+
+    TEST(GraphIndexTest, WidthFollowsTheGraphSize) {
+        constexpr uint64_t max_int = std::numeric_limits<int32_t>::max();
+        constexpr uint64_t max_uint = std::numeric_limits<uint32_t>::max();
+        ASSERT_EQ(algos::IndexWidth::Narrow, algos::index_width(10, 20));
+        ASSERT_EQ(algos::IndexWidth::Narrow, algos::index_width(max_int, max_uint));
+        ASSERT_EQ(algos::IndexWidth::WideEdges, algos::index_width(max_int, max_uint + 1));
+        ASSERT_EQ(algos::IndexWidth::Wide, algos::index_width(max_int + 1, 0));
+        for (const auto width: {algos::IndexWidth::Narrow, algos::IndexWidth::WideEdges, algos::IndexWidth::Wide}) {
+            ASSERT_EQ(width, algos::parse_index_width(algos::to_string(width)));
+        }
+        ASSERT_THROW(algos::parse_index_width("huge"), std::runtime_error);
+        ASSERT_EQ(algos::IndexWidth::Narrow, algos::detect_index_width(std::filesystem::path(DATA_DIR) / "small.mtx"));
+    }
+
+    TEST(GraphIndexTest, NarrowLoadersStopBelowTwoToThe31) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_graph_index_test.mtx";
+        algos::GraphInput input;
+        std::ofstream(path) << "%%MatrixMarket matrix coordinate pattern symmetric\n2147483647 2147483647 0\n";
+        ASSERT_NO_THROW(algos::open_mtx_graph(path, input));
+        std::ofstream(path) << "%%MatrixMarket matrix coordinate pattern symmetric\n2147483648 2147483648 0\n";
+        ASSERT_THROW(algos::open_mtx_graph(path, input), std::runtime_error);
+        ASSERT_THROW(algos::load_csr(path), std::runtime_error);
+        ASSERT_NO_THROW(algos::open_mtx_graph(path, input, std::numeric_limits<uint64_t>::max()));
+        std::filesystem::remove(path);
+    }
+
+    TEST(GraphIndexTest, EveryWidthLoadsTheSameGraph) {
+        for (const char *filename: {"point.mtx", "small.mtx", "Trefethen_2000.mtx"}) {
+            const auto file = std::filesystem::path(DATA_DIR) / filename;
+            const algos::CsrGraph narrow = algos::load_csr(file);
+            expect_same_structure(narrow, algos::load_csr<uint32_t, uint64_t>(file));
+            expect_same_structure(narrow, algos::load_csr<uint64_t, uint64_t>(file));
+
+            const auto weighted = algos::load_weighted_csr<uint16_t>(file);
+            const auto wide = algos::load_weighted_csr<uint16_t, uint64_t, uint64_t>(file);
+            expect_same_structure(weighted, wide);
+            ASSERT_TRUE(std::equal(weighted.weights.begin(), weighted.weights.end(), wide.weights.begin(), wide.weights.end()));
+        }
+    }
+
+    TEST(GraphIndexTest, TreeWidensNarrowParents) {
+        const algos::Tree tree(3, std::vector<int>{-1, 0, 1}, 2);
+        ASSERT_EQ(3u, tree.n);
+        ASSERT_EQ((std::vector<int64_t>{-1, 0, 1}), tree.parent);
+    }
+
+    // ALGOS_INDEX_WIDTH runs the 64-bit offsets of the native BFS on a small graph
+    TEST(GraphIndexTest, NativeBfsOverWideEdgeOffsets) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_graph_index_test.mtx";
+        algos::write_mtx(path, algos::kronecker_graph(10));
+        const algos::CsrGraph g = algos::load_csr(path);
+
+        setenv("ALGOS_INDEX_WIDTH", "wide-edges", 1);
+        ASSERT_EQ(algos::IndexWidth::WideEdges, algos::detect_index_width(path));
+        for (const auto storage: {algos::GraphStorage::Csr, algos::GraphStorage::Compressed}) {
+            algos::ParentBfsNative bfs(storage);
+            bfs.load_graph(path);
+            for (const uint32_t root: algos::sample_roots(g, 4)) {
+                bfs.set_root(root);
+                bfs.compute();
+                ASSERT_NO_THROW(algos::validate_bfs_tree(g, root, bfs.get_result().parent));
+            }
+        }
+
+        setenv("ALGOS_INDEX_WIDTH", "wide", 1);
+        algos::ParentBfsNative bfs;
+        ASSERT_THROW(bfs.load_graph(path), std::runtime_error);
+        unsetenv("ALGOS_INDEX_WIDTH");
+        std::filesystem::remove(path);
+    }
+}// namespace tests
@@ -0,0 +1,107 @@
+#include "common/csr_graph.hpp"
+#include "common/graph500.hpp"
+#include "common/graph_input.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+#if defined(ALGOS_WITH_ZLIB)
+#include <zlib.h>
+#endif
+#if defined(ALGOS_WITH_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace tests {
+    std::string read_file(const std::filesystem::path &path) {
+        std::ifstream input(path, std::ios::binary);
+        std::stringstream text;
+        text << input.rdbuf();
+        return text.str();
+    }
+
+    void write_file(const std::filesystem::path &path, const std::string &data) {
+        std::ofstream(path, std::ios::binary) << data;
+    }
+
+#if defined(ALGOS_WITH_ZLIB)
+    void write_gzip(const std::filesystem::path &path, const std::string &data) {
+        gzFile file = gzopen(path.c_str(), "wb");
+        gzwrite(file, data.data(), static_cast<unsigned>(data.size()));
+        gzclose(file);
+    }
+#endif
+
+    void expect_same_graph(const algos::CsrGraph &a, const algos::CsrGraph &b) {
+        ASSERT_EQ(a.n, b.n);
+        ASSERT_TRUE(std::ranges::equal(a.offsets, b.offsets));
+        ASSERT_TRUE(std::ranges::equal(a.cols, b.cols));
+    }
+
+    TEST(GraphInputTest, DetectsGraphFiles) {
+        ASSERT_TRUE(algos::is_graph_file("a/graph.mtx"));
+        ASSERT_TRUE(algos::is_graph_file("graph.mtx.gz"));
+        ASSERT_TRUE(algos::is_graph_file("graph.mtx.zst"));
+        ASSERT_FALSE(algos::is_graph_file("graph.tar.gz"));
+        ASSERT_FALSE(algos::is_graph_file("graph.csv"));
+    }
+
+    TEST(GraphInputTest, ReadsPlainFiles) {
+        const auto path = std::filesystem::path(DATA_DIR) / "test1.mtx";
+        ASSERT_EQ(algos::Compression::None, algos::detect_compression(path));
+        algos::GraphInput input(path);
+        ASSERT_TRUE(input.is_open());
+        std::stringstream text;
+        text << input.rdbuf();
+        ASSERT_EQ(read_file(path), text.str());
+
+        algos::GraphInput missing(std::filesystem::path(DATA_DIR) / "missing.mtx");
+        ASSERT_FALSE(missing.is_open());
+        ASSERT_TRUE(missing.fail());
+    }
+
+#if defined(ALGOS_WITH_ZLIB)
+    TEST(GraphInputTest, ReadsGzipAcrossBlocks) {
+        // large enough to span several decoded blocks
+        const auto plain = std::filesystem::temp_directory_path() / "algos_input_test.mtx";
+        const auto packed = std::filesystem::temp_directory_path() / "algos_input_test.mtx.gz";
+        algos::write_mtx(plain, algos::kronecker_graph(15, 16));
+        write_gzip(packed, read_file(plain));
+
+        ASSERT_EQ(algos::Compression::Gzip, algos::detect_compression(packed));
+        expect_same_graph(algos::load_csr(plain), algos::load_csr(packed));
+        std::filesystem::remove(plain);
+        std::filesystem::remove(packed);
+    }
+
+    TEST(GraphInputTest, TruncatedGzipThrows) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_input_truncated.mtx.gz";
+        write_gzip(path, read_file(std::filesystem::path(DATA_DIR) / "small.mtx"));
+        const std::string packed = read_file(path);
+        write_file(path, packed.substr(0, packed.size() / 2));
+        ASSERT_ANY_THROW(algos::load_weighted_csr<uint32_t>(path));
+        std::filesystem::remove(path);
+    }
+#endif
+
+#if defined(ALGOS_WITH_ZSTD)
+    TEST(GraphInputTest, ReadsZstd) {
+        const auto source = std::filesystem::path(DATA_DIR) / "small.mtx";
+        const auto path = std::filesystem::temp_directory_path() / "algos_input_test.mtx.zst";
+        const std::string data = read_file(source);
+        std::string packed(ZSTD_compressBound(data.size()), '\0');
+        packed.resize(ZSTD_compress(packed.data(), packed.size(), data.data(), data.size(), 3));
+        write_file(path, packed);
+
+        ASSERT_EQ(algos::Compression::Zstd, algos::detect_compression(path));
+        const auto expected = algos::load_weighted_csr<uint32_t>(source);
+        const auto actual = algos::load_weighted_csr<uint32_t>(path);
+        expect_same_graph(expected, actual);
+        ASSERT_TRUE(std::ranges::equal(expected.weights, actual.weights));
+        std::filesystem::remove(path);
+    }
+#endif
+}// namespace tests
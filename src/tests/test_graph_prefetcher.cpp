@@ -0,0 +1,78 @@
+#include "common/csr_graph.hpp"
+#include "common/graph_cache.hpp"
+#include "common/graph_prefetcher.hpp"
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <memory>
+
+namespace tests {
+    const std::filesystem::path prefetch_graphs[] = {
+            std::filesystem::path(DATA_DIR) / "test1.mtx",
+            std::filesystem::path(DATA_DIR) / "small.mtx",
+            std::filesystem::path(DATA_DIR) / "Trefethen_2000.mtx"};
+
+    void prefetch_structure(const std::filesystem::path &path) {
+        auto g = std::make_shared<const algos::CsrGraph>(algos::load_csr(path));
+        const size_t bytes = g->memory_bytes();
+        algos::GraphCache::instance().insert(path, std::move(g), bytes);
+    }
+
+    TEST(GraphCacheTest, LoadsReturnCachedGraphs) {
+        auto &cache = algos::GraphCache::instance();
+        const auto path = prefetch_graphs[0];
+        const algos::CsrGraph original = algos::load_csr(path);
+
+        auto fake = std::make_shared<algos::CsrGraph>();
+        fake->n = 1;
+        fake->offsets.assign(2, 0);
+        cache.insert<algos::CsrGraph>(path, fake, 42);
+        ASSERT_EQ(42u, cache.bytes());
+        ASSERT_EQ(1u, algos::load_csr(path).n);
+        // other types of the same file are not served from it
+        ASSERT_EQ(original.n, algos::load_weighted_csr<uint32_t>(path).n);
+
+        cache.erase(path);
+        ASSERT_EQ(0u, cache.bytes());
+        ASSERT_EQ(original.n, algos::load_csr(path).n);
+    }
+
+    TEST(GraphCacheTest, EstimateBoundsTheLoad) {
+        for (const auto &path: prefetch_graphs) {
+            const auto g = algos::load_weighted_csr<double>(path);
+            ASSERT_GE(algos::estimate_load_bytes(path, sizeof(double)), g.memory_bytes() + g.weights.size() * sizeof(double));
+        }
+    }
+
+    TEST(GraphPrefetcherTest, KeepsCurrentAndNextGraph) {
+        auto &cache = algos::GraphCache::instance();
+        {
+            algos::GraphPrefetcher prefetcher({std::begin(prefetch_graphs), std::end(prefetch_graphs)}, prefetch_structure, size_t{1} << 30);
+            if (!prefetcher.enabled()) {
+                GTEST_SKIP() << "prefetching needs at least two CPUs";
+            }
+            prefetcher.advance(0);
+            ASSERT_NE(nullptr, cache.find<algos::CsrGraph>(prefetch_graphs[0]));
+
+            prefetcher.pause();
+            prefetcher.resume();
+            prefetcher.advance(1);
+            ASSERT_EQ(nullptr, cache.find<algos::CsrGraph>(prefetch_graphs[0]));
+            ASSERT_NE(nullptr, cache.find<algos::CsrGraph>(prefetch_graphs[1]));
+            ASSERT_EQ(algos::load_csr(prefetch_graphs[1]).cols.size(), cache.find<algos::CsrGraph>(prefetch_graphs[1])->cols.size());
+        }
+        ASSERT_EQ(0u, cache.bytes());
+    }
+
+    TEST(GraphPrefetcherTest, BudgetLimitsBuilds) {
+        algos::GraphPrefetcher disabled({std::begin(prefetch_graphs), std::end(prefetch_graphs)}, prefetch_structure, 0);
+        ASSERT_FALSE(disabled.enabled());
+
+        algos::GraphPrefetcher small({std::begin(prefetch_graphs), std::end(prefetch_graphs)}, prefetch_structure, 1);
+        if (!small.enabled()) {
+            GTEST_SKIP() << "prefetching needs at least two CPUs";
+        }
+        small.advance(0);
+        small.advance(1);
+        ASSERT_EQ(0u, algos::GraphCache::instance().bytes());
+    }
+}// namespace tests
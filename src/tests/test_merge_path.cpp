@@ -0,0 +1,107 @@
+#include "common/merge_path.hpp"
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace tests {
+    // Kronecker-like degrees: a few hubs with most of the edges, many small and empty rows
+    std::vector<uint32_t> skewed_offsets(int64_t n) {
+        std::mt19937 rng(7);
+        std::vector<uint32_t> offsets(n + 1);
+        for (int64_t v = 0; v < n; ++v) {
+            const uint32_t degree = v % 1000 == 3 ? 50000 : rng() % 4;
+            offsets[v + 1] = offsets[v] + degree;
+        }
+        return offsets;
+    }
+
+    class MergePathTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+#ifdef _OPENMP
+            previous = omp_get_max_threads();
+            omp_set_num_threads(4);
+#endif
+        }
+
+        void TearDown() override {
+#ifdef _OPENMP
+            omp_set_num_threads(previous);
+#endif
+        }
+
+        int previous = 1;
+    };
+
+    TEST_F(MergePathTest, SearchSplitsRowsAndEdges) {
+        const std::vector<uint32_t> offsets = {0, 3, 3, 10};
+        const int64_t n = 3;
+        for (int64_t d = 0; d <= n + offsets[n]; ++d) {
+            const algos::MergePathCoord c = algos::merge_path_search(offsets, n, d);
+            ASSERT_EQ(d, c.row + c.edge);
+            // the consumed rows end no later than the consumed edges, the next row end is not consumed yet
+            if (c.row > 0) {
+                ASSERT_LE(offsets[c.row], c.edge);
+            }
+            if (c.row < n) {
+                ASSERT_LE(c.edge, offsets[c.row + 1]);
+            }
+        }
+    }
+
+    TEST_F(MergePathTest, PiecesCoverEveryEdgeOnce) {
+        const int64_t n = 20000;
+        const auto offsets = skewed_offsets(n);
+        std::vector<std::atomic<int>> visits(offsets[n]);
+        std::atomic<int64_t> misplaced = 0;
+        algos::merge_path_for_each(offsets, n, [&](int64_t row, int64_t begin, int64_t end) {
+            if (begin < offsets[row] || end > offsets[row + 1] || begin >= end) misplaced.fetch_add(1);
+            for (int64_t e = begin; e < end; ++e) {
+                visits[e].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        ASSERT_EQ(0, misplaced.load());
+        ASSERT_TRUE(std::ranges::all_of(visits, [](const std::atomic<int> &x) { return x.load() == 1; }));
+    }
+
+    TEST_F(MergePathTest, SegmentedReduceMatchesRowByRow) {
+        const int64_t n = 20000;
+        const auto offsets = skewed_offsets(n);
+        std::mt19937_64 rng(11);
+        std::vector<uint64_t> values(offsets[n]);
+        for (auto &x: values) {
+            x = rng();
+        }
+
+        std::vector<uint64_t> expected(n, UINT64_MAX), sums(n), expected_sums(n);
+        for (int64_t v = 0; v < n; ++v) {
+            for (uint32_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+                expected[v] = std::min(expected[v], values[e]);
+                expected_sums[v] += values[e];
+            }
+        }
+
+        std::vector<uint64_t> mins(n);
+        algos::segmented_reduce(
+                offsets, n, UINT64_MAX,
+                [&](int64_t, int64_t begin, int64_t end) { return *std::min_element(values.begin() + begin, values.begin() + end); },
+                [](uint64_t a, uint64_t b) { return std::min(a, b); }, mins);
+        ASSERT_EQ(expected, mins);
+
+        algos::segmented_reduce(
+                offsets, n, uint64_t{0},
+                [&](int64_t, int64_t begin, int64_t end) {
+                    uint64_t s = 0;
+                    for (int64_t e = begin; e < end; ++e) s += values[e];
+                    return s;
+                },
+                [](uint64_t a, uint64_t b) { return a + b; }, sums);
+        ASSERT_EQ(expected_sums, sums);
+    }
+}// namespace tests
@@ -0,0 +1,88 @@
+#include "native/min_edge_kernel.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace tests {
+    TEST(MinEdgeKernelTest, SimdMatchesScalar) {
+        std::mt19937_64 rng(7);
+        // rows of every length around the vector widths to cover the masked tails
+        std::vector<uint32_t> offsets = {0};
+        for (uint32_t len = 0; len < 70; ++len) {
+            offsets.push_back(offsets.back() + len);
+        }
+        const auto n = static_cast<uint32_t>(offsets.size() - 1);
+        std::vector<uint64_t> keys(offsets.back());
+        for (auto &key: keys) {
+            key = rng();
+        }
+        // keys on both sides of the sign bit, AVX2 compares them as signed
+        keys[5] = algos::INF_KEY - 1;
+        keys[6] = 1;
+
+        std::vector<uint64_t> expected(n), actual(n);
+        algos::row_min_keys(offsets.data(), keys.data(), n, expected.data(), algos::SimdLevel::Scalar);
+        for (uint32_t v = 0; v < n; ++v) {
+            uint64_t min = algos::INF_KEY;
+            for (uint32_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+                min = std::min(min, keys[e]);
+            }
+            ASSERT_EQ(min, expected[v]);
+        }
+
+        const algos::SimdLevel best = algos::detect_simd_level();
+        for (const auto level: {algos::SimdLevel::Avx2, algos::SimdLevel::Avx512}) {
+            if (level > best) continue;
+            algos::row_min_keys(offsets.data(), keys.data(), n, actual.data(), level);
+            ASSERT_EQ(expected, actual) << algos::to_string(level);
+            for (uint32_t len = 0; len < 40; ++len) {
+                ASSERT_EQ(algos::min_key(keys.data() + 3, len, algos::SimdLevel::Scalar),
+                          algos::min_key(keys.data() + 3, len, level))
+                        << algos::to_string(level) << " " << len;
+            }
+        }
+    }
+
+    TEST(MinEdgeKernelTest, RelaxMatchesScalar) {
+        std::mt19937_64 rng(11);
+        const uint32_t n = 83;
+        std::vector<uint32_t> row(n);
+        std::vector<uint64_t> dist(n);
+        for (uint32_t v = 0; v < n; ++v) {
+            row[v] = rng() % 4 == 0 ? UINT32_MAX : static_cast<uint32_t>(rng() % 100);
+            dist[v] = rng() % 5 == 0 ? algos::INF_KEY : algos::encode_edge_key(static_cast<uint32_t>(rng() % 100), v);
+        }
+        const algos::SimdLevel best = algos::detect_simd_level();
+        // ranges starting off the vector widths, with every tail length
+        for (uint32_t begin: {0u, 3u, 5u}) {
+            for (uint32_t end = begin; end <= n; ++end) {
+                std::vector<uint64_t> expected_dist = dist;
+                std::vector<uint32_t> expected_parent(n, 0);
+                const uint64_t expected = algos::relax_min_keys(row.data(), 7, expected_dist.data(), expected_parent.data(), begin, end,
+                                                                algos::SimdLevel::Scalar);
+                for (const auto level: {algos::SimdLevel::Avx2, algos::SimdLevel::Avx512}) {
+                    if (level > best) continue;
+                    std::vector<uint64_t> actual_dist = dist;
+                    std::vector<uint32_t> actual_parent(n, 0);
+                    ASSERT_EQ(expected, algos::relax_min_keys(row.data(), 7, actual_dist.data(), actual_parent.data(), begin, end, level))
+                            << algos::to_string(level) << " " << begin << " " << end;
+                    ASSERT_EQ(expected_dist, actual_dist) << algos::to_string(level);
+                    ASSERT_EQ(expected_parent, actual_parent) << algos::to_string(level);
+                }
+            }
+        }
+    }
+
+    TEST(MinEdgeKernelTest, ComponentMinKeepsArgmin) {
+        const std::vector<uint64_t> row_min = {algos::encode_edge_key(3, 1), algos::encode_edge_key(1, 0), algos::INF_KEY, algos::encode_edge_key(2, 0)};
+        const std::vector<uint32_t> comp = {0, 0, 2, 2};
+        std::vector<uint64_t> comp_min(4, algos::INF_KEY);
+        std::vector<uint32_t> comp_arg(4, 0);
+        algos::component_min_keys(row_min.data(), comp.data(), 4, comp_min.data(), comp_arg.data());
+        ASSERT_EQ(row_min[1], comp_min[0]);
+        ASSERT_EQ(1u, comp_arg[0]);
+        ASSERT_EQ(row_min[3], comp_min[2]);
+        ASSERT_EQ(3u, comp_arg[2]);
+        ASSERT_EQ(algos::INF_KEY, comp_min[1]);
+    }
+}// namespace tests
@@ -1,8 +1,15 @@
+#include <cstdlib>
 #include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 
+#include "autotune/auto_mst.hpp"
 #include "common/mst_algorithm.hpp"
+#include "common/weight_type.hpp"
 #include "lagraph/boruvka_lagraph.hpp"
+#include "native/boruvka_native.hpp"
+#include "native/boruvka_partitioned.hpp"
+#include "native/prim_dense.hpp"
 #include "spla/boruvka_spla.hpp"
 #include "spla/prim_spla.hpp"
 #include "test_commons.hpp"
@@ -11,21 +18,39 @@
 
 namespace tests {
     template<class T>
-    algos::MstAlgorithm *create_mst_algo();// implement parametrized function for each MST algorithm
+    algos::MstAlgorithm *create_mst_algo() {
+        return new T();
+    }
+
+    template<typename W>
+    struct BoruvkaNativeCompressed {};
+
+    template<>
+    algos::MstAlgorithm *create_mst_algo<BoruvkaNativeCompressed<uint16_t>>() {
+        return new algos::BoruvkaNative<uint16_t>(algos::GraphStorage::Compressed);
+    }
 
     template<>
-    algos::MstAlgorithm *create_mst_algo<algos::PrimSpla>() {
-        return new algos::PrimSpla();
+    algos::MstAlgorithm *create_mst_algo<BoruvkaNativeCompressed<double>>() {
+        return new algos::BoruvkaNative<double>(algos::GraphStorage::Compressed);
     }
 
+    template<typename W>
+    struct BoruvkaNativeEdgeList {};
+
     template<>
-    algos::MstAlgorithm *create_mst_algo<algos::BoruvkaSpla>() {
-        return new algos::BoruvkaSpla();
+    algos::MstAlgorithm *create_mst_algo<BoruvkaNativeEdgeList<uint16_t>>() {
+        return new algos::BoruvkaNative<uint16_t>(algos::GraphStorage::EdgeList);
     }
 
     template<>
-    algos::MstAlgorithm *create_mst_algo<algos::BoruvkaLagraph>() {
-        return new algos::BoruvkaLagraph();
+    algos::MstAlgorithm *create_mst_algo<BoruvkaNativeEdgeList<int32_t>>() {
+        return new algos::BoruvkaNative<int32_t>(algos::GraphStorage::EdgeList);
+    }
+
+    template<>
+    algos::MstAlgorithm *create_mst_algo<BoruvkaNativeEdgeList<double>>() {
+        return new algos::BoruvkaNative<double>(algos::GraphStorage::EdgeList);
     }
 
     template<typename T>
@@ -38,7 +63,12 @@ namespace tests {
         algos::MstAlgorithm *const algo;
     };
 
-    using AlgosTypes = ::testing::Types<algos::BoruvkaSpla, algos::PrimSpla, algos::BoruvkaLagraph>;// extend this with other MST algorimths
+    using AlgosTypes = ::testing::Types<algos::BoruvkaSpla<>, algos::PrimSpla<>, algos::BoruvkaLagraph<>,
+                                        algos::BoruvkaSpla<uint16_t>, algos::PrimSpla<uint16_t>, algos::BoruvkaLagraph<uint16_t>,
+                                        algos::PrimSpla<float>, algos::BoruvkaLagraph<double>,
+                                        algos::BoruvkaNative<>, algos::BoruvkaNative<uint16_t>, algos::BoruvkaNative<uint64_t>,
+                                        BoruvkaNativeCompressed<uint16_t>, BoruvkaNativeEdgeList<uint16_t>, algos::BoruvkaPartitioned<uint16_t>,
+                                        algos::PrimDense<>, algos::PrimDense<uint16_t>, algos::AutoMst>;// extend this with other MST algorimths
     TYPED_TEST_SUITE(MstAlgorithmTest, AlgosTypes);
 
     static const GraphCase mst_test_cases[] = {
@@ -60,4 +90,151 @@ namespace tests {
             ASSERT_TRUE(is_tree_or_forest(res.parent));
         }
     }
+
+    TYPED_TEST(MstAlgorithmTest, WritesLevelsAndEdgeWeights) {
+        auto file = std::filesystem::path(DATA_DIR) / "Trefethen_2000.mtx";
+        this->algo->load_graph(file);
+        this->algo->compute();
+        std::vector<int64_t> parent(2000);
+        std::vector<int32_t> level(2000);
+        std::vector<double> edge_weight(2000);
+        algos::SpanSink sink{std::span<int64_t>(parent), level, edge_weight};
+        this->algo->write_result(sink);
+
+        double total = 0;
+        for (size_t v = 0; v < parent.size(); ++v) {
+            total += edge_weight[v];
+            if (parent[v] < 0) {
+                ASSERT_EQ(0, level[v]);
+                ASSERT_EQ(0, edge_weight[v]);
+            } else {
+                ASSERT_EQ(level[parent[v]] + 1, level[v]);
+            }
+        }
+        ASSERT_EQ(1999, sink.weight());
+        ASSERT_EQ(1999, total);
+    }
+
+    template<typename T>
+    class SignedMstAlgorithmTest : public MstAlgorithmTest<T> {};
+
+    using SignedAlgosTypes = ::testing::Types<algos::BoruvkaSpla<int32_t>, algos::PrimSpla<int32_t>, algos::BoruvkaLagraph<int32_t>,
+                                              algos::BoruvkaSpla<float>, algos::PrimSpla<float>, algos::BoruvkaLagraph<float>,
+                                              algos::BoruvkaSpla<double>, algos::BoruvkaLagraph<double>,
+                                              algos::BoruvkaNative<int32_t>, algos::BoruvkaNative<double>, BoruvkaNativeEdgeList<int32_t>,
+                                              algos::PrimDense<int32_t>, algos::PrimDense<double>, algos::AutoMst>;
+    TYPED_TEST_SUITE(SignedMstAlgorithmTest, SignedAlgosTypes);
+
+    TYPED_TEST(SignedMstAlgorithmTest, IsCorrectMstWithNegativeWeights) {
+        auto file = std::filesystem::path(DATA_DIR) / "test1_negative.mtx";
+        this->algo->load_graph(file);
+        this->algo->compute();
+        auto res = this->algo->get_result();
+        ASSERT_EQ(-18, res.weight);
+        ASSERT_TRUE(is_tree_or_forest(res.parent));
+    }
+
+    template<typename T>
+    class RealMstAlgorithmTest : public MstAlgorithmTest<T> {};
+
+    using RealAlgosTypes = ::testing::Types<algos::BoruvkaSpla<float>, algos::PrimSpla<float>, algos::BoruvkaLagraph<float>,
+                                            algos::BoruvkaSpla<double>, algos::BoruvkaLagraph<double>,
+                                            algos::BoruvkaNative<float>, algos::BoruvkaNative<double>, BoruvkaNativeCompressed<double>, BoruvkaNativeEdgeList<double>,
+                                            algos::PrimDense<float>, algos::AutoMst>;
+    TYPED_TEST_SUITE(RealMstAlgorithmTest, RealAlgosTypes);
+
+    TYPED_TEST(RealMstAlgorithmTest, IsCorrectMstWithRealWeights) {
+        auto file = std::filesystem::path(DATA_DIR) / "test1_real.mtx";
+        this->algo->load_graph(file);
+        this->algo->compute();
+        auto res = this->algo->get_result();
+        ASSERT_EQ(24, res.weight);
+        ASSERT_TRUE(is_tree_or_forest(res.parent));
+    }
+
+    TEST(PartitionedMstTest, MatchesBoruvkaLagraph) {
+        for (const auto &entry: std::filesystem::directory_iterator(DATA_DIR)) {
+            if (entry.path().extension() != ".mtx" || entry.path().filename().string().find("unw") != std::string::npos) continue;
+            const algos::WeightType type = algos::detect_weight_type(entry.path());
+            auto expected = algos::make_mst_algorithm<algos::BoruvkaLagraph>(type);
+            expected->load_graph(entry.path());
+            expected->compute();
+            const double expected_weight = expected->get_result().weight;
+            for (const uint32_t workers: {1u, 2u, 3u, 8u}) {
+                auto algo = algos::make_mst_algorithm<algos::BoruvkaPartitioned>(type, workers);
+                algo->load_graph(entry.path());
+                algo->compute();
+                const auto res = algo->get_result();
+                ASSERT_EQ(expected_weight, res.weight) << entry.path().filename() << " " << workers;
+                ASSERT_TRUE(is_tree_or_forest(res.parent));
+            }
+        }
+    }
+
+    TEST(PrimDenseTest, UsedAboveDensityThreshold) {
+        ASSERT_FALSE(algos::prefer_dense_mst(1, 0));
+        ASSERT_TRUE(algos::prefer_dense_mst(100, 100 * 99));
+        ASSERT_FALSE(algos::prefer_dense_mst(2000, 43906));
+        ASSERT_FALSE(algos::prefer_dense_mst(1 << 20, uint64_t{1} << 40));
+
+        setenv("ALGOS_DENSE_THRESHOLD", "0.01", 1);
+        ASSERT_TRUE(algos::prefer_dense_mst(2000, 43906));
+        unsetenv("ALGOS_DENSE_THRESHOLD");
+
+        setenv("ALGOS_DENSE_MAX_MB", "1", 1);
+        algos::PrimDense<uint16_t> algo;
+        ASSERT_THROW(algo.load_graph(std::filesystem::path(DATA_DIR) / "Trefethen_2000.mtx"), std::runtime_error);
+        unsetenv("ALGOS_DENSE_MAX_MB");
+    }
+
+    TEST(WeightTypeTest, DetectsNarrowestType) {
+        const std::pair<std::string, algos::WeightType> cases[] = {
+                {"point.mtx", algos::WeightType::UInt8},
+                {"small.mtx", algos::WeightType::UInt8},
+                {"Trefethen_2000.mtx", algos::WeightType::UInt16},
+                {"two_components_int.mtx", algos::WeightType::UInt8},
+                {"test1_negative.mtx", algos::WeightType::Int32},
+                {"test1_real.mtx", algos::WeightType::Float}};
+        for (const auto &[filename, expected]: cases) {
+            auto file = std::filesystem::path(DATA_DIR) / filename;
+            ASSERT_EQ(expected, algos::detect_weight_type(file)) << filename;
+        }
+    }
+
+    TEST(WeightTypeTest, ReusesResultStoredNextToFile) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_weight_type_test.mtx";
+        const auto sidecar = std::filesystem::path(path.string() + ".wtype");
+        std::filesystem::copy_file(std::filesystem::path(DATA_DIR) / "Trefethen_2000.mtx", path,
+                                   std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::remove(sidecar);
+        ASSERT_EQ(algos::WeightType::UInt16, algos::detect_weight_type(path));
+        ASSERT_TRUE(std::filesystem::exists(sidecar));
+
+        // A second call trusts the stored type instead of scanning
+        std::string size, mtime, name;
+        std::ifstream(sidecar) >> size >> mtime >> name;
+        std::ofstream(sidecar) << size << " " << mtime << " double\n";
+        ASSERT_EQ(algos::WeightType::Double, algos::detect_weight_type(path));
+
+        // A changed file is scanned again
+        std::ofstream(path) << "%%MatrixMarket matrix coordinate integer symmetric\n2 2 1\n2 1 7\n";
+        ASSERT_EQ(algos::WeightType::UInt8, algos::detect_weight_type(path));
+        std::filesystem::remove(path);
+        std::filesystem::remove(sidecar);
+    }
+
+    TEST(WeightTypeTest, NarrowWeightOutOfRangeThrows) {
+        auto file = std::filesystem::path(DATA_DIR) / "Trefethen_2000.mtx";
+        algos::PrimSpla<uint8_t> algo;
+        ASSERT_THROW(algo.load_graph(file), std::runtime_error);
+    }
+
+    TEST(WeightTypeTest, MakesAlgorithmForDetectedType) {
+        auto file = std::filesystem::path(DATA_DIR) / "Trefethen_2000.mtx";
+        auto algo = algos::make_mst_algorithm<algos::BoruvkaLagraph>(algos::detect_weight_type(file));
+        algo->load_graph(file);
+        algo->compute();
+        ASSERT_EQ(1999, algo->get_result().weight);
+        ASSERT_THROW(algos::make_mst_algorithm<algos::PrimSpla>(algos::WeightType::Double), std::runtime_error);
+    }
 }// namespace tests
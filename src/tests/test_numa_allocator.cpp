@@ -0,0 +1,53 @@
+#include "common/csr_graph.hpp"
+#include "common/numa_allocator.hpp"
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <numeric>
+
+namespace tests {
+    // Restores the policy of the other tests
+    class NumaAllocatorTest : public ::testing::Test {
+    protected:
+        ~NumaAllocatorTest() override { algos::set_memory_policy(saved); }
+
+        const algos::MemoryPolicy saved = algos::memory_policy();
+    };
+
+    TEST_F(NumaAllocatorTest, ParsesPolicies) {
+        for (const char *text: {"first-touch", "interleave", "interleave+thp", "interleave+huge", "first-touch+thp"}) {
+            ASSERT_EQ(text, algos::to_string(algos::parse_memory_policy(text)));
+        }
+        ASSERT_EQ(algos::MemoryPolicy{}, algos::parse_memory_policy(""));
+        ASSERT_THROW(algos::parse_memory_policy("striped"), std::runtime_error);
+        ASSERT_THROW(algos::parse_memory_policy("partition"), std::runtime_error);
+        ASSERT_THROW(algos::parse_memory_policy("interleave+1g"), std::runtime_error);
+        ASSERT_GE(algos::numa_node_count(), 1u);
+    }
+
+    TEST_F(NumaAllocatorTest, LargeArraysKeepTheirContents) {
+        for (const char *text: {"first-touch", "interleave+thp", "first-touch+huge"}) {
+            algos::set_memory_policy(algos::parse_memory_policy(text));
+            // crosses the large allocation threshold while growing
+            algos::numa_vector<uint64_t> values;
+            for (uint64_t i = 0; i < 3 * algos::LARGE_ALLOCATION / sizeof(uint64_t); ++i) {
+                values.push_back(i);
+            }
+            // huge pages, transparent or not, need the 2 MB boundary allocate_pages promises
+            ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(values.data()) % (size_t{1} << 21)) << text;
+            algos::numa_vector<uint64_t> copy = values;
+            ASSERT_TRUE(std::equal(values.begin(), values.end(), copy.begin())) << text;
+            ASSERT_EQ(values.size() * (values.size() - 1) / 2, std::accumulate(copy.begin(), copy.end(), uint64_t{0}));
+        }
+    }
+
+    TEST_F(NumaAllocatorTest, GraphsLoadUnderEveryPolicy) {
+        const auto file = std::filesystem::path(DATA_DIR) / "Trefethen_2000.mtx";
+        const algos::CsrGraph expected = algos::load_csr(file);
+        for (const char *text: {"interleave", "interleave+huge", "first-touch+thp"}) {
+            algos::set_memory_policy(algos::parse_memory_policy(text));
+            const algos::CsrGraph g = algos::load_csr(file);
+            ASSERT_EQ(expected.offsets, g.offsets) << text;
+            ASSERT_EQ(expected.cols, g.cols) << text;
+        }
+    }
+}// namespace tests
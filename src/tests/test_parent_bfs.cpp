@@ -1,7 +1,11 @@
+#include "autotune/auto_parent_bfs.hpp"
+#include "common/graph500.hpp"
 #include "common/parent_bfs_algorithm.hpp"
 #include "lagraph/parent_bfs_lagraph.hpp"
+#include "native/parent_bfs_native.hpp"
 #include "spla/parent_bfs_spla.hpp"
 #include "test_commons.hpp"
+#include <algorithm>
 #include <filesystem>
 
 #ifdef I
@@ -24,6 +28,23 @@ namespace tests {
         return new algos::ParentBfsLagraph();
     }
 
+    template<>
+    algos::ParentBfsAlgorithm *create_bfs_algo<algos::ParentBfsNative>() {
+        return new algos::ParentBfsNative();
+    }
+
+    struct ParentBfsNativeCompressed {};
+
+    template<>
+    algos::ParentBfsAlgorithm *create_bfs_algo<ParentBfsNativeCompressed>() {
+        return new algos::ParentBfsNative(algos::GraphStorage::Compressed);
+    }
+
+    template<>
+    algos::ParentBfsAlgorithm *create_bfs_algo<algos::AutoParentBfs>() {
+        return new algos::AutoParentBfs();
+    }
+
     template<typename T>
     class BfsAlgorithmTest : public ::testing::Test {
     protected:
@@ -34,7 +55,7 @@ namespace tests {
         algos::ParentBfsAlgorithm *const algo;
     };
 
-    using AlgosTypes = ::testing::Types<algos::ParentBfsSpla, algos::ParentBfsLagraph>;
+    using AlgosTypes = ::testing::Types<algos::ParentBfsSpla, algos::ParentBfsLagraph, algos::ParentBfsNative, ParentBfsNativeCompressed, algos::AutoParentBfs>;
     TYPED_TEST_SUITE(BfsAlgorithmTest, AlgosTypes);
 
     static const GraphCase mst_test_cases[] = {
@@ -52,4 +73,36 @@ namespace tests {
             ASSERT_TRUE(is_tree_or_forest(res.parent));
         }
     }
-}// namespace tests
\ No newline at end of file
+
+    TYPED_TEST(BfsAlgorithmTest, SingleRootTreeIsValid) {
+        for (const GraphCase &test_case: mst_test_cases) {
+            auto file = std::filesystem::path(DATA_DIR) / test_case.filename;
+            const algos::CsrGraph g = algos::load_csr(file);
+            this->algo->load_graph(file);
+            for (const uint32_t root: algos::sample_roots(g, 3)) {
+                this->algo->set_root(root);
+                this->algo->compute();
+                ASSERT_NO_THROW(algos::validate_bfs_tree(g, root, this->algo->get_result().parent));
+            }
+            this->algo->set_root(std::nullopt);
+        }
+    }
+
+    // The seeds become the roots of their components, a component without a seed is still searched
+    TYPED_TEST(BfsAlgorithmTest, SeedsRootTheForest) {
+        auto file = std::filesystem::path(DATA_DIR) / "two_components_unw.mtx";
+        for (const auto &seeds: {std::vector<uint32_t>{2, 6}, std::vector<uint32_t>{6}}) {
+            this->algo->load_graph(file);
+            this->algo->seed_roots(seeds);
+            this->algo->compute();
+            const auto res = this->algo->get_result();
+            ASSERT_TRUE(is_tree_or_forest(res.parent));
+            for (const uint32_t root: seeds) {
+                ASSERT_EQ(-1, res.parent[root]);
+            }
+            ASSERT_EQ(2, std::count(res.parent.begin(), res.parent.end(), -1));
+        }
+        this->algo->seed_roots({100});
+        ASSERT_THROW(this->algo->compute(), std::runtime_error);
+    }
+}// namespace tests
@@ -0,0 +1,98 @@
+#include "common/graph500.hpp"
+#include "common/propagation_blocking.hpp"
+#include "native/boruvka_native.hpp"
+#include "native/parent_bfs_native.hpp"
+#include "test_commons.hpp"
+#include <cstdlib>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace tests {
+    // Smallest blocks, so that the graphs below span several of them
+    class PropagationBlockingTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+            setenv("ALGOS_BLOCK_BYTES", "1", 1);
+#ifdef _OPENMP
+            previous = omp_get_max_threads();
+            omp_set_num_threads(4);
+#endif
+        }
+
+        void TearDown() override {
+            unsetenv("ALGOS_BLOCK_BYTES");
+#ifdef _OPENMP
+            omp_set_num_threads(previous);
+#endif
+        }
+
+        int previous = 1;
+    };
+
+    TEST_F(PropagationBlockingTest, CacheSizesAreKnown) {
+        const algos::CacheSizes &sizes = algos::cache_sizes();
+        ASSERT_GT(sizes.l1d, 0u);
+        ASSERT_LE(sizes.l1d, sizes.l2);
+        ASSERT_LE(sizes.l2, sizes.llc);
+        ASSERT_EQ(12u, algos::propagation_block_shift(4));
+        ASSERT_FALSE(algos::use_blocking(algos::Propagation::Auto, 1));
+        ASSERT_TRUE(algos::use_blocking(algos::Propagation::Blocked, 1));
+    }
+
+    TEST_F(PropagationBlockingTest, BinsApplyEveryUpdateOnce) {
+        const uint32_t n = 100000;
+        algos::PropagationBins<uint32_t> bins;
+        std::vector<uint32_t> hits(n);
+        for (int round = 0; round < 2; ++round) {
+            bins.reset(n, 12);
+            ASSERT_EQ((n >> 12) + 1, bins.block_count());
+            algos::parallel_for(0, 3 * n, [&](int64_t i) {
+                const auto dest = static_cast<uint32_t>(i * 7919 % n);
+                bins.push(dest, dest);
+            });
+            // a block is applied by one thread, so plain increments do not race
+            bins.apply([&](uint32_t dest) { ++hits[dest]; });
+        }
+        for (uint32_t v = 0; v < n; ++v) {
+            ASSERT_EQ(6u, hits[v]) << v;
+        }
+    }
+
+    TEST_F(PropagationBlockingTest, BlockedBfsTreesAreValid) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_propagation_test.mtx";
+        algos::write_mtx(path, algos::kronecker_graph(14));
+        const algos::CsrGraph g = algos::load_csr(path);
+        for (const auto storage: {algos::GraphStorage::Csr, algos::GraphStorage::Compressed}) {
+            algos::ParentBfsNative bfs(storage, algos::Propagation::Blocked);
+            bfs.load_graph(path);
+            for (const uint32_t root: algos::sample_roots(g, 4)) {
+                bfs.set_root(root);
+                bfs.compute();
+                ASSERT_NO_THROW(algos::validate_bfs_tree(g, root, bfs.get_result().parent));
+            }
+        }
+        std::filesystem::remove(path);
+    }
+
+    TEST_F(PropagationBlockingTest, BlockedBoruvkaMatchesDirect) {
+        for (const char *filename: {"small.mtx", "Trefethen_2000.mtx", "two_components_int.mtx"}) {
+            const auto file = std::filesystem::path(DATA_DIR) / filename;
+            for (const auto storage: {algos::GraphStorage::Csr, algos::GraphStorage::Compressed}) {
+                algos::BoruvkaNative<uint16_t> direct(storage, algos::Propagation::Direct);
+                algos::BoruvkaNative<uint16_t> blocked(storage, algos::Propagation::Blocked);
+                direct.load_graph(file);
+                blocked.load_graph(file);
+                direct.compute();
+                blocked.compute();
+                const auto res = blocked.get_result();
+                ASSERT_EQ(direct.get_result().weight, res.weight) << filename;
+                ASSERT_TRUE(is_tree_or_forest(res.parent)) << filename;
+            }
+        }
+    }
+}// namespace tests
@@ -0,0 +1,113 @@
+#include "common/result_export.hpp"
+#include "native/boruvka_native.hpp"
+#include "native/parent_bfs_native.hpp"
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace tests {
+    const algos::Tree SAMPLE(6, std::vector<int>{-1, 0, 0, 1, -1, 4}, 7.5);
+
+    TEST(ResultExportTest, SpanSinkWritesCallerMemory) {
+        std::vector<int32_t> narrow(8, 42);
+        algos::SpanSink narrow_sink{std::span<int32_t>(narrow)};
+        algos::export_tree(SAMPLE, narrow_sink);
+        ASSERT_EQ(6u, narrow_sink.vertices());
+        ASSERT_EQ(7.5, narrow_sink.weight());
+        ASSERT_EQ((std::vector<int32_t>{-1, 0, 0, 1, -1, 4, 42, 42}), narrow);
+
+        std::vector<int64_t> wide(6);
+        algos::SpanSink wide_sink{std::span<int64_t>(wide)};
+        algos::export_tree(SAMPLE, wide_sink);
+        ASSERT_EQ(SAMPLE.parent, wide);
+
+        std::vector<int32_t> small(5);
+        algos::SpanSink small_sink{std::span<int32_t>(small)};
+        ASSERT_THROW(algos::export_tree(SAMPLE, small_sink), std::runtime_error);
+    }
+
+    TEST(ResultExportTest, ResultFileRoundTrip) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_result_export_test.bin";
+        for (const auto encoding: {algos::ParentEncoding::Int32, algos::ParentEncoding::Int64, algos::ParentEncoding::Delta}) {
+            {
+                algos::ResultFile file(path, encoding);
+                algos::export_tree(SAMPLE, file);
+            }
+            if (encoding == algos::ParentEncoding::Int32) {
+                ASSERT_EQ(48u + 4 * SAMPLE.n, std::filesystem::file_size(path));
+            }
+            const algos::Tree tree = algos::read_result_file(path);
+            ASSERT_EQ(SAMPLE.n, tree.n);
+            ASSERT_EQ(SAMPLE.parent, tree.parent);
+            ASSERT_EQ(SAMPLE.weight, tree.weight);
+        }
+        std::filesystem::remove(path);
+    }
+
+    TEST(ResultExportTest, LevelsFollowTheParents) {
+        std::vector<int64_t> parent(6);
+        std::vector<int32_t> level(6);
+        algos::SpanSink sink{std::span<int64_t>(parent), level};
+        algos::export_tree(SAMPLE, sink);
+        ASSERT_EQ((std::vector<int32_t>{0, 1, 1, 2, 0, 1}), level);
+
+        // From a root the other trees were not reached
+        algos::export_tree(SAMPLE, sink, 0);
+        ASSERT_EQ((std::vector<int32_t>{0, 1, 1, 2, -1, -1}), level);
+    }
+
+    TEST(ResultExportTest, ResultFileSections) {
+        const auto path = std::filesystem::temp_directory_path() / "algos_result_export_test.bin";
+        const std::vector<std::pair<uint32_t, uint32_t>> edges = {{1, 0}, {0, 2}, {3, 1}, {4, 5}};
+        const std::vector<double> weights = {1.5, 2, 3, 1};
+        for (const auto encoding: {algos::ParentEncoding::Int32, algos::ParentEncoding::Int64, algos::ParentEncoding::Delta}) {
+            {
+                algos::ResultFile file(path, encoding, algos::ResultSection::EdgeWeights | algos::ResultSection::Levels);
+                algos::export_forest(6, edges, weights, 7.5, file);
+            }
+            const algos::ResultFileContents contents = algos::read_result_contents(path);
+            ASSERT_EQ(SAMPLE.parent, contents.tree.parent);
+            ASSERT_EQ(7.5, contents.tree.weight);
+            ASSERT_EQ((std::vector<int32_t>{0, 1, 1, 2, 0, 1}), contents.levels);
+            ASSERT_EQ((std::vector<double>{0, 1.5, 2, 3, 0, 1}), contents.edge_weights);
+        }
+
+        // Files without sections keep them empty
+        {
+            algos::ResultFile file(path);
+            algos::export_tree(SAMPLE, file);
+        }
+        const algos::ResultFileContents contents = algos::read_result_contents(path);
+        ASSERT_TRUE(contents.levels.empty());
+        ASSERT_TRUE(contents.edge_weights.empty());
+        std::filesystem::remove(path);
+    }
+
+    TEST(ResultExportTest, AlgorithmsWriteTheirResult) {
+        const auto graph = std::filesystem::path(DATA_DIR) / "Trefethen_2000.mtx";
+        const auto path = std::filesystem::temp_directory_path() / "algos_result_export_test.bin";
+
+        algos::ParentBfsNative bfs;
+        bfs.load_graph(graph);
+        bfs.set_root(0);
+        bfs.compute();
+        {
+            algos::ResultFile file(path);
+            bfs.write_result(file);
+        }
+        ASSERT_EQ(bfs.get_result().parent, algos::read_result_file(path).parent);
+
+        algos::BoruvkaNative<double> boruvka;
+        boruvka.load_graph(graph);
+        boruvka.compute();
+        const algos::Tree expected = boruvka.get_result();
+        {
+            algos::ResultFile file(path, algos::ParentEncoding::Delta);
+            boruvka.write_result(file);
+        }
+        const algos::Tree written = algos::read_result_file(path);
+        ASSERT_EQ(expected.parent, written.parent);
+        ASSERT_EQ(expected.weight, written.weight);
+        std::filesystem::remove(path);
+    }
+}// namespace tests
@@ -0,0 +1,62 @@
+#include "common/run_isolation.hpp"
+#include "common/scheduler.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <stdexcept>
+#include <unistd.h>
+#include <vector>
+
+namespace tests {
+    TEST(RunIsolationTest, CpuLists) {
+        ASSERT_EQ((std::vector<int>{0, 1, 2, 3, 8, 10, 11}), algos::parse_cpu_list("0-3,8,10-11"));
+        ASSERT_EQ((std::vector<int>{1, 2, 5}), algos::parse_cpu_list("5,1-2,2"));
+        ASSERT_EQ("0-3,8,10-11", algos::format_cpu_list({0, 1, 2, 3, 8, 10, 11}));
+        ASSERT_TRUE(algos::parse_cpu_list("").empty());
+        ASSERT_THROW(algos::parse_cpu_list("3-1"), std::runtime_error);
+        ASSERT_THROW(algos::parse_cpu_list("two"), std::runtime_error);
+        ASSERT_FALSE(algos::cpu_frequency_governor().empty());
+    }
+
+    TEST(RunIsolationTest, RunsInAPinnedChild) {
+        cpu_set_t allowed;
+        ASSERT_EQ(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+        int cpu = 0;
+        while (!CPU_ISSET(cpu, &allowed)) ++cpu;
+
+        algos::IsolationConfig config;
+        config.enabled = true;
+        config.cpus = {cpu};
+        struct Placement {
+            pid_t pid;
+            int cpu;
+        };
+        const auto placement = algos::run_isolated<Placement>(config, [] { return Placement{getpid(), sched_getcpu()}; });
+        ASSERT_NE(getpid(), placement.pid);
+        ASSERT_EQ(cpu, placement.cpu);
+    }
+
+    TEST(RunIsolationTest, ChildFailuresReachTheParent) {
+        const algos::IsolationConfig config;
+        try {
+            algos::run_isolated<int>(config, []() -> int { throw std::runtime_error("no graph"); });
+            FAIL();
+        } catch (const std::runtime_error &e) {
+            ASSERT_STREQ("no graph", e.what());
+        }
+        ASSERT_THROW(algos::run_isolated<int>(config, []() -> int { std::abort(); }), std::runtime_error);
+    }
+
+    // The helper threads of the parent's pool are gone in the child, which has to start its own
+    TEST(RunIsolationTest, SchedulerWorksAfterFork) {
+        const auto sum = [] {
+            std::atomic<int64_t> total = 0;
+            algos::parallel_for(0, 1 << 16, [&](int64_t i) { total.fetch_add(i, std::memory_order_relaxed); });
+            return total.load();
+        };
+        const int64_t expected = sum();
+        ASSERT_EQ(expected, algos::run_isolated<int64_t>({}, sum));
+        ASSERT_EQ(expected, algos::run_isolated<int64_t>({}, sum));
+    }
+}// namespace tests
@@ -0,0 +1,125 @@
+#include "common/scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace tests {
+    // Runs the loops of the test on a fixed number of threads, also on machines with fewer CPUs
+    class SchedulerTest : public ::testing::Test {
+    protected:
+        void SetUp() override {
+#ifdef _OPENMP
+            previous = omp_get_max_threads();
+            omp_set_num_threads(4);
+#endif
+        }
+
+        void TearDown() override {
+#ifdef _OPENMP
+            omp_set_num_threads(previous);
+#endif
+        }
+
+        int previous = 1;
+    };
+
+    TEST_F(SchedulerTest, VisitsEveryIndexOnce) {
+        for (const int64_t n: {0, 1, 7, 1000, 100000}) {
+            std::vector<std::atomic<int>> visits(n);
+            algos::parallel_for(0, n, [&](int64_t i) { visits[i].fetch_add(1); });
+            for (int64_t i = 0; i < n; ++i) {
+                ASSERT_EQ(1, visits[i].load()) << n << " " << i;
+            }
+        }
+    }
+
+    TEST_F(SchedulerTest, WeightedLoopSplitsOnEdges) {
+        // one hub with most of the edges and many leaves
+        const int64_t n = 50000;
+        std::vector<uint32_t> offsets(n + 1);
+        for (int64_t v = 0; v < n; ++v) {
+            offsets[v + 1] = offsets[v] + (v == n / 2 ? 1000000 : 2);
+        }
+        std::vector<std::atomic<int>> visits(n);
+        algos::parallel_for_edges(offsets, n, [&](int64_t v) { visits[v].fetch_add(1); });
+        for (int64_t v = 0; v < n; ++v) {
+            ASSERT_EQ(1, visits[v].load());
+        }
+    }
+
+    TEST_F(SchedulerTest, PerThreadBuffersCollectAllItems) {
+        const int64_t n = 200000;
+        algos::PerThread<std::vector<int64_t>> local;
+        algos::parallel_for(0, n, [&](int64_t i) { local.local().push_back(i); });
+        std::vector<int64_t> all;
+        local.for_each([&](std::vector<int64_t> &items) { all.insert(all.end(), items.begin(), items.end()); });
+        std::ranges::sort(all);
+        std::vector<int64_t> expected(n);
+        std::iota(expected.begin(), expected.end(), 0);
+        ASSERT_EQ(expected, all);
+    }
+
+    TEST_F(SchedulerTest, NestedLoopsRunInline) {
+        std::atomic<int64_t> sum = 0;
+        algos::parallel_for(0, 100, [&](int64_t i) {
+            algos::parallel_for(0, 100, [&](int64_t j) { sum.fetch_add(i * j, std::memory_order_relaxed); });
+        });
+        ASSERT_EQ(4950 * 4950, sum.load());
+    }
+
+    TEST_F(SchedulerTest, RethrowsExceptionsOfTheBody) {
+        std::atomic<int64_t> done = 0;
+        ASSERT_THROW(algos::parallel_for(0, 100000,
+                                         [&](int64_t i) {
+                                             if (i == 4242) throw std::runtime_error("failed");
+                                             done.fetch_add(1, std::memory_order_relaxed);
+                                         }),
+                     std::runtime_error);
+        // the pool is usable afterwards
+        std::atomic<int64_t> count = 0;
+        algos::parallel_for(0, 100000, [&](int64_t) { count.fetch_add(1, std::memory_order_relaxed); });
+        ASSERT_EQ(100000, count.load());
+    }
+
+    // Helpers left out of a loop with fewer threads must not run into the next, wider one
+    TEST_F(SchedulerTest, AlternatingThreadCaps) {
+#ifdef _OPENMP
+        omp_set_num_threads(8);
+#endif
+        std::atomic<int> running = 0;
+        for (int round = 0; round < 2000; ++round) {
+            for (const unsigned cap: {8u, 2u}) {
+                algos::limit_scheduler_threads(cap);
+                std::atomic<int64_t> count = 0;
+                algos::parallel_for(0, 64, [&](int64_t) {
+                    running.fetch_add(1);
+                    count.fetch_add(1, std::memory_order_relaxed);
+                    running.fetch_sub(1);
+                });
+                ASSERT_EQ(0, running.load()) << round << " " << cap;
+                ASSERT_EQ(64, count.load()) << round << " " << cap;
+            }
+        }
+        algos::limit_scheduler_threads(0);
+    }
+
+    TEST_F(SchedulerTest, CountsLoopsAndTasks) {
+        algos::reset_scheduler_stats();
+        std::atomic<int64_t> count = 0;
+        algos::parallel_for(0, 1 << 20, [&](int64_t) { count.fetch_add(1, std::memory_order_relaxed); });
+        const algos::SchedulerStats stats = algos::scheduler_stats();
+        if (algos::scheduler_threads() < 2) {
+            GTEST_SKIP() << "built without OpenMP, loops run sequentially";
+        }
+        ASSERT_EQ(1u, stats.loops);
+        ASSERT_GT(stats.tasks, 1u);
+        ASSERT_GE(stats.idle_seconds, 0);
+    }
+}// namespace tests
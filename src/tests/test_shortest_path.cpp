@@ -0,0 +1,107 @@
+#include "common/shortest_path_algorithm.hpp"
+#include "lagraph/shortest_path_lagraph.hpp"
+#include "native/delta_stepping_native.hpp"
+#include "test_commons.hpp"
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <queue>
+
+namespace tests {
+    inline std::vector<double> dijkstra(const algos::WeightedCsrGraph<double> &g, uint32_t source) {
+        std::vector<double> dist(g.n, algos::UNREACHABLE);
+        using Item = std::pair<double, uint32_t>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<>> queue;
+        dist[source] = 0;
+        queue.emplace(0, source);
+        while (!queue.empty()) {
+            const auto [d, u] = queue.top();
+            queue.pop();
+            if (d > dist[u]) continue;
+            for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                const double nd = d + g.weights[e];
+                if (nd < dist[g.cols[e]]) {
+                    dist[g.cols[e]] = nd;
+                    queue.emplace(nd, g.cols[e]);
+                }
+            }
+        }
+        return dist;
+    }
+
+    template<class T>
+    algos::ShortestPathAlgorithm *create_sssp_algo() {
+        return new T();
+    }
+
+    struct DeltaSteppingUnitDelta {};
+
+    template<>
+    algos::ShortestPathAlgorithm *create_sssp_algo<DeltaSteppingUnitDelta>() {
+        return new algos::DeltaSteppingNative(1);
+    }
+
+    template<typename T>
+    class ShortestPathTest : public ::testing::Test {
+    protected:
+        ShortestPathTest() : algo(create_sssp_algo<T>()) {}
+
+        ~ShortestPathTest() override { delete algo; }
+
+        algos::ShortestPathAlgorithm *const algo;
+    };
+
+    using AlgosTypes = ::testing::Types<algos::DeltaSteppingNative, DeltaSteppingUnitDelta, algos::ShortestPathLagraph>;
+    TYPED_TEST_SUITE(ShortestPathTest, AlgosTypes);
+
+    TYPED_TEST(ShortestPathTest, MatchesDijkstra) {
+        for (const char *filename: {"point.mtx", "one_edge.mtx", "test1.mtx", "test1_real.mtx", "small.mtx",
+                                    "Trefethen_2000.mtx", "two_components_int.mtx"}) {
+            auto file = std::filesystem::path(DATA_DIR) / filename;
+            const auto g = algos::load_sssp_graph(file);
+            this->algo->load_graph(file);
+            for (const uint32_t source: {0u, g.n / 2, g.n - 1}) {
+                this->algo->set_source(source);
+                this->algo->compute();
+                const algos::ShortestPaths res = this->algo->get_result();
+                ASSERT_EQ(dijkstra(g, source), res.distance) << filename << " " << source;
+                ASSERT_TRUE(is_tree_or_forest(res.tree.parent));
+                // tree edges are tight and every reachable vertex but the source has a parent
+                for (uint32_t v = 0; v < g.n; ++v) {
+                    const int64_t p = res.tree.parent[v];
+                    if (v == source || res.distance[v] == algos::UNREACHABLE) {
+                        ASSERT_EQ(-1, p);
+                        continue;
+                    }
+                    ASSERT_NE(-1, p) << filename << " " << v;
+                    ASSERT_LE(res.distance[p], res.distance[v]);
+                }
+            }
+        }
+    }
+
+    // 0.5 + 0.1 = 0.6 and 0.6 / 0.1 = 5.999..., so the heavy edge from vertex 1 stays in its bucket
+    TEST(ShortestPathTest, HeavyEdgeRoundingIntoTheSameBucket) {
+        const auto file = std::filesystem::path(DATA_DIR) / "fractional_delta.mtx";
+        algos::DeltaSteppingNative algo(0.1);
+        algo.load_graph(file);
+        algo.set_source(0);
+        algo.compute();
+        ASSERT_EQ(dijkstra(algos::load_sssp_graph(file), 0), algo.get_result().distance);
+    }
+
+    TEST(ShortestPathTest, NegativeWeightsThrow) {
+        algos::DeltaSteppingNative algo;
+        ASSERT_THROW(algo.load_graph(std::filesystem::path(DATA_DIR) / "test1_negative.mtx"), std::runtime_error);
+    }
+
+    TEST(ShortestPathTest, DeltaFollowsWeights) {
+        const auto g = algos::load_sssp_graph(std::filesystem::path(DATA_DIR) / "Trefethen_2000.mtx");
+        const double delta = algos::choose_delta(g);
+        double min_weight = algos::UNREACHABLE;
+        for (const double w: g.weights) {
+            min_weight = std::min(min_weight, w);
+        }
+        ASSERT_GE(delta, min_weight);
+        ASSERT_EQ(1, algos::choose_delta(algos::load_sssp_graph(std::filesystem::path(DATA_DIR) / "point.mtx")));
+    }
+}// namespace tests
@@ -0,0 +1,52 @@
+#include "common/trace.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+
+namespace tests {
+    std::string write_trace() {
+        const auto path = std::filesystem::temp_directory_path() / "algos_trace_test.json";
+        algos::trace::write_chrome_trace(path);
+        std::ifstream input(path);
+        std::stringstream text;
+        text << input.rdbuf();
+        std::filesystem::remove(path);
+        return text.str();
+    }
+
+    TEST(TraceTest, WritesScopesAndCounters) {
+        algos::trace::clear();
+        {
+            algos::trace::Scope round("test_round");
+            round.arg("components", 7);
+            round.arg("edges_remaining", 40);
+            round.arg("components", 5);
+            round.arg("dropped", 1);
+            algos::trace::counter("test_queue", 3);
+        }
+        std::thread([] { algos::trace::Scope level("test_level"); }).join();
+
+        const std::string json = write_trace();
+        ASSERT_EQ(0u, json.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+        ASSERT_NE(std::string::npos, json.find("\"name\":\"test_round\",\"ph\":\"X\""));
+        ASSERT_NE(std::string::npos, json.find("\"args\":{\"components\":5,\"edges_remaining\":40}"));
+        ASSERT_NE(std::string::npos, json.find("\"name\":\"test_queue\",\"ph\":\"C\""));
+        ASSERT_NE(std::string::npos, json.find("\"args\":{\"test_queue\":3}"));
+        // the other thread gets its own track
+        const size_t level = json.find("\"name\":\"test_level\"");
+        ASSERT_NE(std::string::npos, level);
+        ASSERT_EQ(std::string::npos, json.find("\"dropped\""));
+    }
+
+    TEST(TraceTest, KeepsLatestEventsWhenFull) {
+        algos::trace::clear();
+        for (int i = 0; i < 100000; ++i) {
+            algos::trace::counter("test_overflow", i);
+        }
+        const std::string json = write_trace();
+        ASSERT_NE(std::string::npos, json.find("\"test_overflow\":99999}"));
+        ASSERT_EQ(std::string::npos, json.find("\"test_overflow\":0}"));
+    }
+}// namespace tests